@@ -1,393 +1,868 @@
-/***************************************************************************
-
-    file                 : Axel.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-#include "Axel.hpp"
-
-#if defined (AXEL_DRIVER)
-
-#include <iostream>
-#include <cassert>
-
-//#define DEBUG_INPUTS
-//#define DEBUG_OUTPUTS
-
-/***************************************************************************
- *                                                                         *
- *   Axel interface.                                                       *
- *                                                                         *
- ***************************************************************************/
-/// <summary>
-/// Initialises robot local constants and reference values.
-/// </summary>
-Axel::Axel()
-    : axel_ai( generateAI( IS_TRAINING ) ), inputs( {} ), outputs( {} ), car_control( CarControl() ), lap_counter( 0 ),
-    last_lap_time( 0.0f ), total_lap_times( 0.0f ), distance_raced( 0 )
-{}
-
-/// <summary>
-/// Deletes all instances created with new on the constructor.
-/// </summary> 
-Axel::~Axel()
-{
-    delete this->axel_ai;
-}
-
-/// <summary>
-/// Called before the beginning of the race and can be used to define a custom configuration of the track sensors.
-/// </summary>
-void Axel::init( float * angles )
-{
-    // sets sensor angles to be every 10� from -90� to 90�, array is clock-wise
-    for ( int sensor_index = 0; sensor_index <= 18; sensor_index++ ) angles[ sensor_index ] = 10.0f * static_cast<float>( sensor_index ) - 90.0f;
-}
-
-/// <summary>
-/// Called at the end of the race, before the driver module is unloaded.
-/// </summary>
-void Axel::onShutdown()
-{
-    // show information
-    showInformation();
-    // quit
-    std::cout << "The name's Axel, got it memorised? Bye!" << std::endl;
-}
-
-/// <summary>
-/// Called when the race is restarted upon the driver request.
-/// </summary>
-void Axel::onRestart()
-{
-    // show information
-    showInformation();
-    // reset counters
-    this->lap_counter = 0;
-    this->last_lap_time = 0.0f;
-    // advance gym situation
-    this->axel_ai->advanceInTrain();
-    // restart
-    std::cout << ">>> Restarting the race!" << std::endl;
-}
-
-/// <summary>
-/// Drive control, calls the wrapper drive function that translates the state string to the CarState and the returned CarControl to string.
-/// </summary>
-CarControl Axel::wDrive( CarState car_state )
-{
-    // saves total distance raced
-    this->distance_raced = car_state.getDistRaced();
-    // appraises progress and checks if race requires a restart and, if so, proceeds to return car control without any evaluation.
-    appraise( car_state );
-    restartCheck( car_state );
-    if ( this->car_control.getMeta() == CarControl::META_RESTART ) return car_control;
-    // converts inputs, evaluates outputs, converts to car control and sends to TORCS.
-    convertInputs( car_state );
-    evaluate();
-    convertOutputs();
-    return car_control;
-}
-
-/***************************************************************************
- *                                                                         *
- *   Axel Utilities.                                                       *
- *                                                                         *
- ***************************************************************************/
-/// <summary>
-/// Creates a new AI and returns it's pointer.
-/// </summary>
-RobotAxel::AI * const Axel::generateAI( bool const & training ) const
-{
-    return new RobotAxel::AI( training );
-}
-
-/// <summary>
-/// Converts the necessary CarState inputs to an array of floats for AI use.
-/// </summary>
-/// <param name="car_state">Current sensors state.</param>
-void Axel::convertInputs( CarState & car_state )
-{
-    // temporary input
-    float temporary_input = 0.0f;
-    // current input index
-    size_t index = 0;
-
-    // [0] gear { -1, ..., 6 } --> { GEAR_OFFSET, ..., GEAR_MAX + GEAR_OFFSET } / (GEAR_MAX + GEAR_OFFSET)
-    temporary_input = static_cast<float> ( car_state.getGear() ) + GEAR_OFFSET;
-    this->inputs[ index ] = temporary_input / ( GEAR_MAX + GEAR_OFFSET );
-    index++;
-    // [1] rpm [0, +infinity[ --> [0, RPM_MAX] / RPM_MAX
-    temporary_input = static_cast<float> ( car_state.getRpm() );
-    temporary_input = temporary_input < RPM_MAX ? temporary_input : RPM_MAX;
-    this->inputs[ index ] = temporary_input / RPM_MAX;
-    index++;
-    // [2] angle [-pi, +pi] --> [ANGLE_OFFSET, ANGLE_MAX + ANGLE_OFFSET] / (ANGLE_MAX + ANGLE_OFFSET)
-    temporary_input = car_state.getAngle() + ANGLE_OFFSET;
-    this->inputs[ index ] = temporary_input / ( ANGLE_MAX + ANGLE_OFFSET );
-    index++;
-    // [3] fuel [0, +infinity[ --> [0, FUEL_MAX] / FUEL_MAX
-    temporary_input = car_state.getFuel();
-    temporary_input = temporary_input < FUEL_MAX ? temporary_input : FUEL_MAX;
-    this->inputs[ index ] = temporary_input / FUEL_MAX;
-    index++;
-    // [4,5,6] speed(x, y, z) ]-infinity, +infinity[ --> [SPEED_OFFSET, SPEED_MAX + SPEED_OFFSET] / (SPEED_MAX + SPEED_OFFSET)
-    temporary_input = car_state.getSpeedX();
-    temporary_input = temporary_input < SPEED_MAX ? temporary_input : SPEED_MAX;
-    temporary_input = -SPEED_OFFSET < temporary_input ? temporary_input : -SPEED_OFFSET;
-    temporary_input = temporary_input + SPEED_OFFSET;
-    this->inputs[ index ] = temporary_input / ( SPEED_MAX + SPEED_OFFSET );
-    index++;
-    temporary_input = car_state.getSpeedY();
-    temporary_input = temporary_input < SPEED_MAX ? temporary_input : SPEED_MAX;
-    temporary_input = -SPEED_OFFSET < temporary_input ? temporary_input : -SPEED_OFFSET;
-    temporary_input = temporary_input + SPEED_OFFSET;
-    this->inputs[ index ] = temporary_input / ( SPEED_MAX + SPEED_OFFSET );
-    index++;
-    temporary_input = car_state.getSpeedZ();
-    temporary_input = temporary_input < SPEED_MAX ? temporary_input : SPEED_MAX;
-    temporary_input = -SPEED_OFFSET < temporary_input ? temporary_input : -SPEED_OFFSET;
-    temporary_input = temporary_input + SPEED_OFFSET;
-    this->inputs[ index ] = temporary_input / ( SPEED_MAX + SPEED_OFFSET );
-    index++;
-    // [7] z ]-infinity, + infinity[ --> [Z_OFFSET, Z_MAX + Z_OFFSET] / (Z_MAX + Z_OFFSET)
-    temporary_input = car_state.getZ();
-    temporary_input = temporary_input < Z_MAX ? temporary_input : Z_MAX;
-    temporary_input = -Z_OFFSET < temporary_input ? temporary_input : -Z_OFFSET;
-    temporary_input = temporary_input + Z_OFFSET;
-    this->inputs[ index ] = temporary_input / ( Z_MAX + Z_OFFSET );
-    index++;
-    // [8]  damage [0, + infinity] --> [0, DAMAGE_MAX] / DAMAGE_MAX
-    temporary_input = car_state.getDamage();
-    temporary_input = temporary_input < DAMAGE_MAX ? temporary_input : DAMAGE_MAX;
-    this->inputs[ index ] = temporary_input / DAMAGE_MAX;
-    index++;
-    // [9] track position ]-infinity, + infinity[ --> [TRACK_POSITION_OFFSET, TRACK_POSITION_MAX + TRACK_POSITION_OFFSET] / (TRACK_POSITION_MAX + TRACK_POSITION_OFFSET)
-    temporary_input = car_state.getTrackPos();
-    temporary_input = temporary_input < TRACK_POSITION_MAX ? temporary_input : TRACK_POSITION_MAX;
-    temporary_input = -TRACK_POSITION_OFFSET < temporary_input ? temporary_input : -TRACK_POSITION_OFFSET;
-    temporary_input = temporary_input + TRACK_POSITION_OFFSET;
-    this->inputs[ index ] = temporary_input / ( TRACK_POSITION_MAX + TRACK_POSITION_OFFSET );
-    index++;
-    // [10 ... 13] wheel spin angular velocity [0, +infinity] --> [SPIN_OFFSET, SPIN_MAX + SPIN_OFFSET] / (SPIN_MAX + SPIN_OFFSET)
-    for ( int i = 0; i < 4; i++ )
-    {
-        temporary_input = car_state.getWheelSpinVel( i );
-        temporary_input = temporary_input < SPIN_MAX ? temporary_input : SPIN_MAX;
-        temporary_input = -SPIN_OFFSET < temporary_input ? temporary_input : -SPIN_OFFSET;
-        temporary_input = temporary_input + SPIN_OFFSET;
-        this->inputs[ index + i ] = temporary_input / ( SPIN_MAX + SPIN_OFFSET );
-    }
-    index += 4;
-    // focus [0, 200] --> [0, FOCUS_DISTANCE_MAX] / FOCUS_DISTANCE_MAX
-    bool focus_reliability = true;
-    for ( int i = 0; i < FOCUS_SENSORS_NUM; i++ )
-    {
-        temporary_input = car_state.getFocus( i );
-        focus_reliability = focus_reliability && temporary_input >= 0.0f;
-        if ( !focus_reliability )
-        {
-            this->inputs[ index + i ] = 0.0f;
-        }
-        else
-        {
-            temporary_input = temporary_input < FOCUS_DISTANCE_MAX ? temporary_input : FOCUS_DISTANCE_MAX;
-            this->inputs[ index + i ] = temporary_input / FOCUS_DISTANCE_MAX;
-        }
-    }
-    index += FOCUS_SENSORS_NUM;
-    this->inputs[ index ] = focus_reliability ? 1.0f : 0.0f;
-    index++;
-    // track [0, 200] --> [0, FOCUS_DISTANCE_MAX] / FOCUS_DISTANCE_MAX
-    bool track_reliability = true;
-    for ( int i = 0; i < TRACK_SENSORS_NUM; i++ )
-    {
-        temporary_input = car_state.getTrack( i );
-        track_reliability = track_reliability && temporary_input >= 0.0f;
-        if ( !track_reliability )
-        {
-            this->inputs[ index + i ] = 0.0f;
-        }
-        else
-        {
-            temporary_input = temporary_input < TRACK_DISTANCE_MAX ? temporary_input : TRACK_DISTANCE_MAX;
-            this->inputs[ index + i ] = temporary_input / TRACK_DISTANCE_MAX;
-        }
-    }
-    index += TRACK_SENSORS_NUM;
-    this->inputs[ index ] = track_reliability ? 1.0f : 0.0f;
-    index++;
-    // opponents [0, 200] --> [0, FOCUS_DISTANCE_MAX] / FOCUS_DISTANCE_MAX
-    for ( int i = 0; i < OPPONENTS_SENSORS_NUM; i++ )
-    {
-        temporary_input = car_state.getOpponents( i );
-        temporary_input = temporary_input < OPPONENTS_DISTANCE_MAX ? temporary_input : OPPONENTS_DISTANCE_MAX;
-        this->inputs[ index + i ] = temporary_input / OPPONENTS_DISTANCE_MAX;
-    }
-    index += OPPONENTS_SENSORS_NUM;
-#if defined (DEBUG_INPUTS)
-    // show inputs and outputs
-    for ( int i = 0; i < RobotAxel::Settings::INPUTS; i++ )
-    { std::cout << "inputs [" << i << "] : " << this->inputs[ i ] << std::endl; }
-#endif
-    assert( index == RobotAxel::Settings::INPUTS );
-}
-
-/// <summary>
-/// Converts AI outputs to CarControl sent into TORCS.
-/// </summary>
-/// <param name="car_control">CarControl with to be filled with AI outputs.</param>
-void Axel::convertOutputs()
-{
-    // temporary output
-    float temporary_output = 0.0f;
-    // current output index
-    size_t index = 0;
-
-    // gear ( ( [-1, 1] + GEAR_OFFSET ) * ( GEAR_MAX + GEAR_OFFSET ) / ( GEAR_OFFSET + GEAR_OFFSET ) ) - GEAR_OFFSET --> { -1, ..., 6 }
-    temporary_output = ( this->outputs[ index ] + 1.0f ) / 2.0f * ( GEAR_MAX + GEAR_OFFSET );
-    temporary_output = temporary_output - GEAR_OFFSET;
-    temporary_output = std::trunc( temporary_output );
-    temporary_output = temporary_output == GEAR_MAX ? 6.0f : temporary_output;
-    if ( TRAINING_NO_REVERSE_OR_NEUTRAL )
-    {
-        temporary_output = temporary_output < 1.0f ? 1.0f : temporary_output;
-    }
-    this->car_control.setGear( static_cast<int>( temporary_output ) );
-    index++;
-    // focus [-1, 1] * FOCUS_MAX --> [-90, 90]
-    temporary_output = this->outputs[ index ] * FOCUS_MAX;
-    this->car_control.setFocus( static_cast<int>( std::trunc( temporary_output ) ) );
-    index++;
-    // steer [-1, 1] --> [-1, 1]
-    this->car_control.setSteer( this->outputs[ index ] );
-    index++;
-    // acceleration [-1, 1] --> [0, 1]
-    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
-    this->car_control.setAccel( temporary_output );
-    index++;
-    // brake [-1, 1] --> [0, 1]
-    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
-    this->car_control.setBrake( temporary_output );
-    index++;
-    // clutch [-1, 1] --> [0, 1]
-    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
-    this->car_control.setClutch( temporary_output );
-    index++;
-#if defined (DEBUG_OUTPUTS)
-    std::cout << "output[0] (gear) = " << car_control.getGear() << std::endl;
-    std::cout << "output[1] (focus) = " << car_control.getFocus() << std::endl;
-    std::cout << "output[2] (steer) = " << car_control.getSteer() << std::endl;
-    std::cout << "output[3] (acceleration) = " << car_control.getAccel() << std::endl;
-    std::cout << "output[4] (brake) = " << car_control.getBrake() << std::endl;
-    std::cout << "output[5] (clutch) = " << car_control.getClutch() << std::endl;
-#endif
-    assert( index == RobotAxel::Settings::OUTPUTS );
-}
-
-/// <summary>
-/// Sends input information to AI.
-/// </summary>
-void Axel::evaluate()
-{
-    this->axel_ai->evaluate( outputs, inputs );
-}
-
-/// <summary>
-/// Evaluates current progress and updates AI.
-/// </summary>
-/// <param name="car_state">Current sensors state.</param>
-void Axel::appraise( CarState & car_state )
-{
-    // progress appraisal
-    float progress = 0.0f;
-
-    // current time average speed
-    float time_counter = this->total_lap_times + car_state.getCurLapTime();
-    float average_speed = std::sqrt( car_state.getSpeedX() * car_state.getSpeedX() ) / ( time_counter < 1.0f ? 1.0f : time_counter );
-    // best average speed, rewards better average speeds [km/h], uses (average_speed)^2
-    progress += average_speed * average_speed;
-    // distance run, rewards higher distances [m]
-    progress += PROGRESS_DISTANCE_MULTIPLIER * ( std::log( car_state.getDistRaced() + std::exp( 1.0f ) ) );
-    // current position, rewards higher positions [1 ... N]
-    if ( TRAINING && TRAINING_BASE_POSITION )
-    {
-        progress += PROGRESS_POSITION_REWARD / TRAINING_FORCED_POSITION;
-    }
-    else
-    {
-        progress += PROGRESS_POSITION_REWARD / static_cast<float>( car_state.getRacePos() );
-    }
-
-    // update with calculated appraisal
-    this->axel_ai->appraise( progress );
-}
-
-/// <summary>
-/// Determines if race should be restarted.
-/// </summary>
-/// <param name="car_state">Current sensors state.</param>
-void Axel::restartCheck( CarState & car_state )
-{
-    // defaults as no restart
-    this->car_control.setMeta( !CarControl::META_RESTART );
-
-    // lap time is different, update lap time and increment lap counter
-    if ( this->last_lap_time != car_state.getLastLapTime() )
-    {
-        this->last_lap_time = car_state.getLastLapTime();
-        this->total_lap_times += this->last_lap_time;
-        this->lap_counter++;
-    }
-
-    // check restart flags
-    if ( this->lap_counter >= TRAINING_MAX_LAPS )
-    { this->car_control.setMeta( CarControl::META_RESTART ); }
-    if ( car_state.getDamage() >= TRAINING_MAX_DAMAGE )
-    { this->car_control.setMeta( CarControl::META_RESTART ); }
-    if ( TRAINING_TIMEOUT - car_state.getCurLapTime() - car_state.getCurLapTime() + car_state.getDistRaced() < 0.0f )
-    { this->car_control.setMeta( CarControl::META_RESTART ); }
-}
-
-/// <summary>
-/// Show information such as AI generation, progress results and such.
-/// </summary>
-void Axel::showInformation()
-{
-    size_t generation = 0;
-    size_t species = 0;
-    float progress = 0.0f;
-    float top_progress = 0.0f;
-    size_t top_genes = 0;
-    size_t top_neurons = 0;
-
-    // obtain run information
-    this->axel_ai->getInformation( generation, species, progress, top_progress, top_genes, top_neurons );
-
-    // show information if training
-    if ( Axel::TRAINING )
-    {
-        std::cout
-            << "Raced=" << distance_raced
-            << " Generation=" << generation
-            << " Species=" << species
-            << " Progress=" << progress
-            << " Top Progress=" << top_progress
-            << " Top Genes=" << top_genes
-            << " Top Neurons=" << top_neurons
-            << std::endl;
-    }
-    else
-    {
-        std::cout
-            << "Raced=" << distance_raced
-            << " Generation=" << generation
-            << " Top Progress=" << top_progress
-            << " Top Genes=" << top_genes
-            << " Top Neurons=" << top_neurons
-            << std::endl;
-    }
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Axel.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Axel.hpp"
+
+#if defined (AXEL_DRIVER)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <cassert>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined (__SSE2__) || defined (_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined (_MSC_VER) && defined (_M_X64)
+#include <intrin.h>
+#endif
+
+//#define DEBUG_INPUTS
+//#define DEBUG_OUTPUTS
+
+/// <summary>
+/// Normalisation tables, generated from the settings.
+/// </summary>
+Axel::Normalization const Axel::NORMALIZATION = Axel::normalization();
+
+/// <summary>
+/// Counts the zero bits below the lowest set bit of a value.
+/// </summary>
+/// <param name="value">Value, not 0.</param>
+/// <returns>Lowest set bit index.</returns>
+static size_t countTrailingZeros( unsigned long long const value )
+{
+#if defined (_MSC_VER) && defined (_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64( &index, value );
+    return static_cast<size_t>( index );
+#elif defined (__GNUC__)
+    return static_cast<size_t>( __builtin_ctzll( value ) );
+#else
+    size_t index = 0;
+    while ( ( ( value >> index ) & 1ULL ) == 0 ) index++;
+    return index;
+#endif
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Axel interface.                                                       *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Initialises robot local constants and reference values.
+/// </summary>
+/// <param name="training">Whenever should the AI train.</param>
+/// <param name="recording">Whenever should driving be recorded to a trace.</param>
+Axel::Axel( bool const & training, bool const & recording )
+    : axel_ai( generateAI( training ) ), trace_recorder( generateTraceRecorder( recording ) ), inputs( {} ), outputs( {} ), car_control( CarControl() ), lap_counter( 0 ),
+    last_lap_time( 0.0f ), total_lap_times( 0.0f ), distance_raced( 0 ), race_state( Sensor_Parser::Race_State() ), fleet_car( false ), lease( 0 ),
+    leased( false ), finished( false ), progress( 0.0f ), latency_profiler( PROFILE_LATENCY, LATENCY_FILE ), phenotype(),
+    deadline_watchdog( REAL_TIME, DEADLINE_BUDGET, DEADLINE_HELD_TICKS ), decision_phase( 0 ), gate_valid( false ), gated_inputs( {} ), ramp_outputs( {} ),
+    decision_outputs( {} ), evaluations( 0 ), gated_evaluations( 0 ), held_evaluations( 0 ), telemetry()
+{
+    if ( REAL_TIME ) enterRealTime();
+    redirectOutput();
+    specializePhenotype();
+    compilePhenotype();
+}
+
+/// <summary>
+/// Initialises a fleet car, driving genomes leased from an AI shared with other cars.
+/// </summary>
+/// <param name="fleet_ai">Shared AI, owned by the fleet.</param>
+Axel::Axel( RobotAxel::AI * const fleet_ai )
+    : axel_ai( fleet_ai ), trace_recorder( nullptr ), inputs( {} ), outputs( {} ), car_control( CarControl() ), lap_counter( 0 ),
+    last_lap_time( 0.0f ), total_lap_times( 0.0f ), distance_raced( 0 ), race_state( Sensor_Parser::Race_State() ), fleet_car( true ), lease( 0 ),
+    leased( false ), finished( false ), progress( 0.0f ), latency_profiler( PROFILE_LATENCY, "" ), phenotype(),
+    deadline_watchdog( REAL_TIME, DEADLINE_BUDGET, DEADLINE_HELD_TICKS ), decision_phase( 0 ), gate_valid( false ), gated_inputs( {} ), ramp_outputs( {} ),
+    decision_outputs( {} ), evaluations( 0 ), gated_evaluations( 0 ), held_evaluations( 0 ), telemetry()
+{
+    // the phenotype is compiled once a genome is leased
+    if ( REAL_TIME ) enterRealTime();
+    redirectOutput();
+    specializePhenotype();
+}
+
+/// <summary>
+/// Initialises a racing driver for a given genome, for offline tools.
+/// </summary>
+/// <param name="genome">Genome to race.</param>
+Axel::Axel( RobotAxel::Genome const & genome )
+    : axel_ai( new RobotAxel::AI( genome ) ), trace_recorder( nullptr ), inputs( {} ), outputs( {} ), car_control( CarControl() ), lap_counter( 0 ),
+    last_lap_time( 0.0f ), total_lap_times( 0.0f ), distance_raced( 0 ), race_state( Sensor_Parser::Race_State() ), fleet_car( false ), lease( 0 ),
+    leased( false ), finished( false ), progress( 0.0f ), latency_profiler( false, "" ), phenotype(),
+    deadline_watchdog( false, DEADLINE_BUDGET, DEADLINE_HELD_TICKS ), decision_phase( 0 ), gate_valid( false ), gated_inputs( {} ), ramp_outputs( {} ),
+    decision_outputs( {} ), evaluations( 0 ), gated_evaluations( 0 ), held_evaluations( 0 ), telemetry()
+{
+    specializePhenotype();
+    compilePhenotype();
+}
+
+/// <summary>
+/// Deletes all instances created with new on the constructor.
+/// </summary> 
+Axel::~Axel()
+{
+    if ( !this->fleet_car ) delete this->axel_ai;
+    if ( this->trace_recorder != nullptr ) delete this->trace_recorder;
+}
+
+/// <summary>
+/// Called before the beginning of the race and can be used to define a custom configuration of the track sensors.
+/// </summary>
+void Axel::init( float * angles )
+{
+    // sets the layout sensor angles evenly from -90 to 90 [deg], every 10 [deg] for the 19 range finders, array is clock-wise
+    constexpr int const rays = static_cast<int>( Sensor_Parser::TRACK_SLOTS );
+    for ( int sensor_index = 0; sensor_index < TRACK_SENSORS_NUM; sensor_index++ )
+    {
+        if ( sensor_index >= rays ) angles[ sensor_index ] = 0.0f;
+        else angles[ sensor_index ] = rays == 1 ? 0.0f : 180.0f / static_cast<float>( rays - 1 ) * static_cast<float>( sensor_index ) - 90.0f;
+    }
+}
+
+/// <summary>
+/// Called at the end of the race, before the driver module is unloaded.
+/// </summary>
+void Axel::onShutdown()
+{
+    // show information
+    showInformation();
+    recordTelemetry();
+    this->latency_profiler.finishGenome( currentGeneration() );
+    showDecisions();
+    this->latency_profiler.finishGeneration();
+    this->deadline_watchdog.finishGenome();
+    this->deadline_watchdog.finishRace();
+    // return the genome in evaluation, the other fleet cars keep training
+    if ( this->fleet_car && this->leased ) this->axel_ai->returnGenome( this->lease, this->progress );
+    this->leased = false;
+    // quit
+    Telemetry_Sink::getInstance().print( "The name's Axel, got it memorised? Bye!" );
+}
+
+/// <summary>
+/// Called when the race is restarted upon the driver request.
+/// </summary>
+void Axel::onRestart()
+{
+    // evaluations cut short are neither cached nor kept as progress curves, the telemetry reason is reset once recorded
+    bool const complete = this->telemetry.termination != Telemetry_Sink::ABORTED && this->telemetry.termination != Telemetry_Sink::HORIZON;
+    // show information
+    showInformation();
+    recordTelemetry();
+    this->latency_profiler.finishGenome( currentGeneration() );
+    showDecisions();
+    this->deadline_watchdog.finishGenome();
+    // reset counters
+    resetDecisions();
+    this->lap_counter = 0;
+    this->last_lap_time = 0.0f;
+    this->total_lap_times = 0.0f;
+    // return the evaluated genome, the next one is leased on the first tick
+    if ( this->fleet_car )
+    {
+        if ( this->leased ) this->axel_ai->returnGenome( this->lease, this->progress );
+        this->leased = false;
+        this->finished = false;
+    }
+    // advance gym situation
+    else
+    {
+        this->axel_ai->advanceInTrain( complete );
+        compilePhenotype();
+    }
+    // restart
+    Telemetry_Sink::getInstance().print( ">>> Restarting the race!" );
+}
+
+/// <summary>
+/// Drive control, parses the sensors message straight into the AI inputs and returns the control message.
+/// </summary>
+/// <remarks>
+/// Skips the CarState round trip of the wrapper drive, which is still taken when recording a trace.
+/// </remarks>
+/// <param name="sensors">Sensors message.</param>
+/// <returns>Control message.</returns>
+std::string Axel::drive( std::string sensors )
+{
+    // traces record the full sensors state
+    if ( this->trace_recorder != nullptr ) return WrapperBaseDriver::drive( sensors );
+    this->deadline_watchdog.startTick();
+    // fleet cars lease a genome per evaluation and wait parked once finished, as a restart restarts every car
+    if ( this->fleet_car && !this->leased && !this->finished ) leaseGenome();
+    if ( this->finished )
+    {
+        park();
+        return controlMessage();
+    }
+    this->latency_profiler.startTick();
+    // raw sensor values into the inputs, race sensors into the race state
+    Sensor_Parser::parse( sensors.data(), sensors.size(), this->inputs, this->race_state );
+    this->latency_profiler.lap( Latency_Profiler::CONVERT_INPUTS );
+    // saves total distance raced
+    this->distance_raced = this->race_state.dist_raced;
+    // appraises progress and checks if race requires a restart and, if so, proceeds to return car control without any evaluation.
+    appraise( this->race_state );
+    this->latency_profiler.lap( Latency_Profiler::APPRAISE );
+    restartCheck( this->race_state );
+    this->latency_profiler.lap( Latency_Profiler::RESTART_CHECK );
+    if ( this->fleet_car && this->car_control.getMeta() == CarControl::META_RESTART )
+    {
+        this->finished = true;
+        park();
+    }
+    // normalises inputs, evaluates outputs, converts to car control and sends to TORCS, unless restarting.
+    else if ( this->car_control.getMeta() != CarControl::META_RESTART )
+    {
+        if ( this->deadline_watchdog.allowDecision() )
+        {
+            this->deadline_watchdog.startDecision();
+            normalizeInputs();
+            this->latency_profiler.lap( Latency_Profiler::CONVERT_INPUTS );
+            evaluate();
+            this->latency_profiler.lap( Latency_Profiler::EVALUATE );
+            convertOutputs();
+            this->deadline_watchdog.finishDecision();
+        }
+        // past the deadline, holds the previous control till a fallback is due, inputs are still raw
+        else if ( this->deadline_watchdog.fallbackDue() ) fallback( this->inputs[ Sensor_Parser::ANGLE ], this->inputs[ Sensor_Parser::TRACK_POSITION ] );
+    }
+    std::string message = controlMessage();
+    this->latency_profiler.lap( Latency_Profiler::CONVERT_OUTPUTS );
+    this->latency_profiler.finishTick();
+    this->deadline_watchdog.finishTick();
+    return message;
+}
+
+/// <summary>
+/// Drive control, calls the wrapper drive function that translates the state string to the CarState and the returned CarControl to string.
+/// </summary>
+CarControl Axel::wDrive( CarState car_state )
+{
+    this->deadline_watchdog.startTick();
+    this->latency_profiler.startTick();
+    // saves race sensors and total distance raced
+    this->race_state = Sensor_Parser::Race_State( car_state );
+    this->distance_raced = this->race_state.dist_raced;
+    // appraises progress and checks if race requires a restart and, if so, proceeds to return car control without any evaluation.
+    appraise( this->race_state );
+    this->latency_profiler.lap( Latency_Profiler::APPRAISE );
+    restartCheck( this->race_state );
+    this->latency_profiler.lap( Latency_Profiler::RESTART_CHECK );
+    // converts inputs, evaluates outputs, converts to car control and sends to TORCS, unless restarting.
+    if ( this->car_control.getMeta() != CarControl::META_RESTART )
+    {
+        if ( this->deadline_watchdog.allowDecision() )
+        {
+            this->deadline_watchdog.startDecision();
+            decide( car_state );
+            this->deadline_watchdog.finishDecision();
+        }
+        // past the deadline, holds the previous control till a fallback is due
+        else if ( this->deadline_watchdog.fallbackDue() ) fallback( car_state.getAngle(), car_state.getTrackPos() );
+    }
+    this->latency_profiler.finishTick();
+    this->deadline_watchdog.finishTick();
+    // records state and sent control
+    if ( this->trace_recorder != nullptr ) this->trace_recorder->record( car_state, this->car_control );
+    return car_control;
+}
+
+/// <summary>
+/// Decides the car control for a sensors state, converting inputs, evaluating and converting outputs, without appraisal or restart checks.
+/// </summary>
+/// <param name="car_state">Sensors state.</param>
+/// <returns>Actions taken.</returns>
+CarControl const & Axel::decide( CarState & car_state )
+{
+    convertInputs( car_state );
+    this->latency_profiler.lap( Latency_Profiler::CONVERT_INPUTS );
+    evaluate();
+    this->latency_profiler.lap( Latency_Profiler::EVALUATE );
+    convertOutputs();
+    this->latency_profiler.lap( Latency_Profiler::CONVERT_OUTPUTS );
+    return this->car_control;
+}
+
+/// <summary>
+/// Checks if the car finished its evaluation and waits parked for the other fleet cars.
+/// </summary>
+/// <returns>Whenever the car is parked.</returns>
+bool const Axel::isFinished() const
+{
+    return this->finished;
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Axel Utilities.                                                       *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Creates a new AI and returns it's pointer.
+/// </summary>
+RobotAxel::AI * const Axel::generateAI( bool const & training ) const
+{
+    return new RobotAxel::AI( training );
+}
+
+/// <summary>
+/// Redirects the AI generation lines and reports to the telemetry sink, off the driving thread.
+/// </summary>
+void Axel::redirectOutput() const
+{
+    this->axel_ai->redirectOutput(
+        []( std::string const & line ) { Telemetry_Sink::getInstance().print( line ); },
+        []( std::string const & file_name, std::string const & contents ) { Telemetry_Sink::getInstance().append( file_name, contents ); }
+    );
+}
+
+/// <summary>
+/// Creates a trace recorder, named after the current time, if recording.
+/// </summary>
+/// <param name="recording">Whenever should driving be recorded.</param>
+/// <returns>A trace recorder pointer or a null pointer.</returns>
+Trace_Recorder * const Axel::generateTraceRecorder( bool const & recording ) const
+{
+    if ( !recording ) return nullptr;
+    mkdir( "traces/", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH );
+    return new Trace_Recorder( "traces/trace_" + std::to_string( std::time( nullptr ) ) + ".bin" );
+}
+
+/// <summary>
+/// Converts the necessary CarState inputs to an array of floats for AI use.
+/// </summary>
+/// <param name="car_state">Current sensors state.</param>
+void Axel::convertInputs( CarState & car_state )
+{
+    // raw values, in the slots the sensors parser writes them to
+    this->inputs[ Sensor_Parser::GEAR ] = static_cast<float> ( car_state.getGear() );
+    this->inputs[ Sensor_Parser::RPM ] = static_cast<float> ( car_state.getRpm() );
+    this->inputs[ Sensor_Parser::ANGLE ] = car_state.getAngle();
+    this->inputs[ Sensor_Parser::FUEL ] = car_state.getFuel();
+    this->inputs[ Sensor_Parser::SPEED ] = car_state.getSpeedX();
+    this->inputs[ Sensor_Parser::SPEED + 1 ] = car_state.getSpeedY();
+    this->inputs[ Sensor_Parser::SPEED + 2 ] = car_state.getSpeedZ();
+    this->inputs[ Sensor_Parser::Z ] = car_state.getZ();
+    this->inputs[ Sensor_Parser::DAMAGE ] = car_state.getDamage();
+    this->inputs[ Sensor_Parser::TRACK_POSITION ] = car_state.getTrackPos();
+    for ( int i = 0; i < 4; i++ ) this->inputs[ Sensor_Parser::WHEEL_SPIN + i ] = car_state.getWheelSpinVel( i );
+    // layout sensor groups, bounds are constant so the loops unroll and vanish for groups the layout doesn't read
+    for ( size_t i = 0; i < Sensor_Parser::FOCUS_SLOTS; i++ ) this->inputs[ Sensor_Parser::FOCUS + i ] = car_state.getFocus( static_cast<int>( i ) );
+    for ( size_t i = 0; i < Sensor_Parser::TRACK_SLOTS; i++ ) this->inputs[ Sensor_Parser::TRACK + i ] = car_state.getTrack( static_cast<int>( i ) );
+    for ( size_t i = 0; i < Sensor_Parser::OPPONENTS_SLOTS; i++ ) this->inputs[ Sensor_Parser::OPPONENTS + i ] = car_state.getOpponents( static_cast<int>( i ) );
+    normalizeInputs();
+}
+
+/// <summary>
+/// Normalises the raw sensor values held by the inputs, in place, and fills the reliability inputs.
+/// </summary>
+/// <remarks>
+/// Every slot is clamped, offset and divided with the normalisation tables, four slots at a time where SSE is available and the layout remainder one at a time.
+/// Dividing, rather than multiplying by the inverse, keeps the inputs equal to the ones trained genomes and recorded traces saw.
+/// </remarks>
+void Axel::normalizeInputs()
+{
+    static_assert( Sensor_Parser::FOCUS + Sensor_Parser::FOCUS_SLOTS <= 64 && Sensor_Parser::TRACK + Sensor_Parser::TRACK_SLOTS <= 64, "Reliability groups must be in the first 64 slots." );
+    // raw values that are not negative, a bit per slot of the first 64
+    unsigned long long non_negative = 0;
+    size_t index = 0;
+
+#if defined (__SSE2__) || defined (_M_X64)
+    __m128 const zero = _mm_setzero_ps();
+    for ( ; index + 4 <= RobotAxel::Settings::INPUTS; index += 4 )
+    {
+        __m128 value = _mm_loadu_ps( &this->inputs[ index ] );
+        if ( index < 64 ) non_negative |= static_cast<unsigned long long>( _mm_movemask_ps( _mm_cmpge_ps( value, zero ) ) ) << index;
+        value = _mm_min_ps( value, _mm_loadu_ps( &NORMALIZATION.maximums[ index ] ) );
+        value = _mm_max_ps( value, _mm_loadu_ps( &NORMALIZATION.minimums[ index ] ) );
+        value = _mm_add_ps( value, _mm_loadu_ps( &NORMALIZATION.offsets[ index ] ) );
+        _mm_storeu_ps( &this->inputs[ index ], _mm_div_ps( value, _mm_loadu_ps( &NORMALIZATION.divisors[ index ] ) ) );
+    }
+#endif
+    for ( ; index < RobotAxel::Settings::INPUTS; index++ )
+    {
+        float value = this->inputs[ index ];
+        if ( index < 64 && value >= 0.0f ) non_negative |= 1ULL << index;
+        value = value < NORMALIZATION.maximums[ index ] ? value : NORMALIZATION.maximums[ index ];
+        value = NORMALIZATION.minimums[ index ] < value ? value : NORMALIZATION.minimums[ index ];
+        this->inputs[ index ] = ( value + NORMALIZATION.offsets[ index ] ) / NORMALIZATION.divisors[ index ];
+    }
+    // focus and track reliability
+    if ( Sensor_Parser::FOCUS_SLOTS > 0 ) setReliability( non_negative, Sensor_Parser::FOCUS, Sensor_Parser::FOCUS_SLOTS, Sensor_Parser::FOCUS_RELIABILITY );
+    setReliability( non_negative, Sensor_Parser::TRACK, Sensor_Parser::TRACK_SLOTS, Sensor_Parser::TRACK_RELIABILITY );
+#if defined (DEBUG_INPUTS)
+    // show inputs and outputs
+    for ( int i = 0; i < RobotAxel::Settings::INPUTS; i++ )
+    { std::cout << "inputs [" << i << "] : " << this->inputs[ i ] << std::endl; }
+#endif
+}
+
+/// <summary>
+/// Sets a reliability input, a sensor group is unreliable from its first negative value onwards, which are zeroed.
+/// </summary>
+/// <param name="non_negative">Raw values that were not negative, a bit per slot.</param>
+/// <param name="first">First slot of the group.</param>
+/// <param name="count">Number of slots of the group.</param>
+/// <param name="reliability">Reliability slot.</param>
+void Axel::setReliability( unsigned long long const & non_negative, size_t const & first, size_t const & count, size_t const & reliability )
+{
+    unsigned long long const group_mask = ( 1ULL << count ) - 1;
+    unsigned long long const group = ( non_negative >> first ) & group_mask;
+    this->inputs[ reliability ] = group == group_mask ? 1.0f : 0.0f;
+    if ( group == group_mask ) return;
+    for ( size_t index = countTrailingZeros( ~group ); index < count; index++ ) this->inputs[ first + index ] = 0.0f;
+}
+
+/// <summary>
+/// Converts AI outputs to CarControl sent into TORCS.
+/// </summary>
+/// <param name="car_control">CarControl with to be filled with AI outputs.</param>
+void Axel::convertOutputs()
+{
+    // temporary output
+    float temporary_output = 0.0f;
+    // current output index
+    size_t index = 0;
+
+    // gear ( ( [-1, 1] + GEAR_OFFSET ) * ( GEAR_MAX + GEAR_OFFSET ) / ( GEAR_OFFSET + GEAR_OFFSET ) ) - GEAR_OFFSET --> { -1, ..., 6 }
+    temporary_output = ( this->outputs[ index ] + 1.0f ) / 2.0f * ( GEAR_MAX + GEAR_OFFSET );
+    temporary_output = temporary_output - GEAR_OFFSET;
+    temporary_output = std::trunc( temporary_output );
+    temporary_output = temporary_output == GEAR_MAX ? 6.0f : temporary_output;
+    if ( TRAINING_NO_REVERSE_OR_NEUTRAL )
+    {
+        temporary_output = temporary_output < 1.0f ? 1.0f : temporary_output;
+    }
+    this->car_control.setGear( static_cast<int>( temporary_output ) );
+    index++;
+    // focus [-1, 1] * FOCUS_MAX --> [-90, 90]
+    temporary_output = this->outputs[ index ] * FOCUS_MAX;
+    this->car_control.setFocus( static_cast<int>( std::trunc( temporary_output ) ) );
+    index++;
+    // steer [-1, 1] --> [-1, 1]
+    this->car_control.setSteer( this->outputs[ index ] );
+    index++;
+    // acceleration [-1, 1] --> [0, 1]
+    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
+    this->car_control.setAccel( temporary_output );
+    index++;
+    // brake [-1, 1] --> [0, 1]
+    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
+    this->car_control.setBrake( temporary_output );
+    index++;
+    // clutch [-1, 1] --> [0, 1]
+    temporary_output = ( this->outputs[ index ] + PEDAL_OFFSET ) / ( PEDAL_MAX + PEDAL_OFFSET );
+    this->car_control.setClutch( temporary_output );
+    index++;
+#if defined (DEBUG_OUTPUTS)
+    std::cout << "output[0] (gear) = " << car_control.getGear() << std::endl;
+    std::cout << "output[1] (focus) = " << car_control.getFocus() << std::endl;
+    std::cout << "output[2] (steer) = " << car_control.getSteer() << std::endl;
+    std::cout << "output[3] (acceleration) = " << car_control.getAccel() << std::endl;
+    std::cout << "output[4] (brake) = " << car_control.getBrake() << std::endl;
+    std::cout << "output[5] (clutch) = " << car_control.getClutch() << std::endl;
+#endif
+    assert( index == RobotAxel::Settings::OUTPUTS );
+}
+
+/// <summary>
+/// Locks memory, touches the stack and applies the CPU pinning and scheduling priority, warning on failures ( Real-time only ).
+/// </summary>
+/// <remarks>
+/// Applies to the whole process, only the first call does anything, so fleet cars share it.
+/// </remarks>
+void Axel::enterRealTime() const
+{
+    static bool entered = false;
+    if ( entered ) return;
+    entered = true;
+    // current and future pages stay resident, a page fault mid tick costs more than a decision
+    if ( mlockall( MCL_CURRENT | MCL_FUTURE ) != 0 )
+    { std::cout << "Real-time: can't lock memory, " << std::strerror( errno ) << std::endl; }
+    // stack pages are faulted in, and so locked, before racing
+    volatile unsigned char stack[ REAL_TIME_STACK ];
+    for ( size_t index = 0; index < REAL_TIME_STACK; index += 4096 ) stack[ index ] = 0;
+    static_cast<void>( stack[ 0 ] );
+    // single CPU, keeps caches warm and avoids migrations
+    if ( REAL_TIME_CPU >= 0 )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        CPU_SET( REAL_TIME_CPU, &cpus );
+        if ( sched_setaffinity( 0, sizeof( cpus ), &cpus ) != 0 )
+        { std::cout << "Real-time: can't pin to CPU " << REAL_TIME_CPU << ", " << std::strerror( errno ) << std::endl; }
+    }
+    // first in first out scheduling, not preempted by normal processes
+    if ( REAL_TIME_PRIORITY > 0 )
+    {
+        sched_param parameters = {};
+        parameters.sched_priority = REAL_TIME_PRIORITY;
+        if ( sched_setscheduler( 0, SCHED_FIFO, &parameters ) != 0 )
+        { std::cout << "Real-time: can't set priority " << REAL_TIME_PRIORITY << ", " << std::strerror( errno ) << std::endl; }
+    }
+}
+
+/// <summary>
+/// Declares the scenario constant inputs to the compiled network, before its first build ( Specialized only ).
+/// </summary>
+void Axel::specializePhenotype()
+{
+    if ( !SPECIALIZE_OPPONENTS ) return;
+    std::array<bool, RobotAxel::Settings::INPUTS> constant = {};
+    std::array<float, RobotAxel::Settings::INPUTS> values = {};
+    // without opponents, every opponent sensor reads its maximum distance
+    for ( size_t index = Sensor_Parser::OPPONENTS; index < Sensor_Parser::OPPONENTS + Sensor_Parser::OPPONENTS_SLOTS; index++ )
+    {
+        constant[ index ] = true;
+        values[ index ] = ( NORMALIZATION.maximums[ index ] + NORMALIZATION.offsets[ index ] ) / NORMALIZATION.divisors[ index ];
+    }
+    this->phenotype.specialize( constant, values );
+}
+
+/// <summary>
+/// Compiles the network of the genome in evaluation ( Compiled network only ).
+/// </summary>
+void Axel::compilePhenotype()
+{
+    if ( !COMPILED_NETWORK ) return;
+    if ( this->fleet_car ) this->axel_ai->compileLeased( this->lease, this->phenotype );
+    else this->axel_ai->compile( this->phenotype );
+}
+
+/// <summary>
+/// Steers towards the track axis at a cautious pace, for decisions skipped too long ( Real-time only ).
+/// </summary>
+/// <param name="angle">Angle to the track axis, in [rad].</param>
+/// <param name="track_position">Position in relation to the track axis.</param>
+void Axel::fallback( float const & angle, float const & track_position )
+{
+    float steer = ( angle - track_position * 0.5f ) / STEER_LOCK;
+    steer = steer < 1.0f ? steer : 1.0f;
+    steer = steer > -1.0f ? steer : -1.0f;
+    this->car_control.setSteer( steer );
+    this->car_control.setAccel( FALLBACK_ACCEL );
+    this->car_control.setBrake( 0.0f );
+    this->car_control.setClutch( 0.0f );
+}
+
+/// <summary>
+/// Leases the next genome to evaluate, the car is parked for the evaluation if none is left ( Fleet only ).
+/// </summary>
+void Axel::leaseGenome()
+{
+    this->leased = this->axel_ai->leaseGenome( this->lease );
+    this->finished = !this->leased;
+    this->progress = 0.0f;
+    resetDecisions();
+    if ( this->leased ) compilePhenotype();
+}
+
+/// <summary>
+/// Brakes to a stop, without restarting.
+/// </summary>
+void Axel::park()
+{
+    this->car_control.setAccel( 0.0f );
+    this->car_control.setBrake( 1.0f );
+    this->car_control.setClutch( 0.0f );
+    this->car_control.setSteer( 0.0f );
+    this->car_control.setMeta( !CarControl::META_RESTART );
+}
+
+/// <summary>
+/// Writes the car control as a SCR control message.
+/// </summary>
+/// <remarks>
+/// Same message as CarControl::toString, formatted in a stack buffer instead of a string stream per value.
+/// </remarks>
+/// <returns>Control message.</returns>
+std::string Axel::controlMessage()
+{
+    char message[ 256 ];
+    int const length = std::snprintf( message, sizeof( message ), "(accel %g)(brake %g)(gear %d)(steer %g)(clutch %g)(focus %d)(meta %d)",
+        this->car_control.getAccel(), this->car_control.getBrake(), this->car_control.getGear(), this->car_control.getSteer(),
+        this->car_control.getClutch(), this->car_control.getFocus(), this->car_control.getMeta() );
+    return std::string( message, length < static_cast<int>( sizeof( message ) ) ? static_cast<size_t>( length ) : sizeof( message ) - 1 );
+}
+
+/// <summary>
+/// Sends input information to AI, unless between decisions or gated by an unchanged input.
+/// </summary>
+void Axel::evaluate()
+{
+    // between decisions, holds or ramps the outputs towards the last decision
+    if ( this->decision_phase != 0 )
+    {
+        if ( DECISION_INTERPOLATE )
+        {
+            float const ramp = static_cast<float>( this->decision_phase + 1 ) / static_cast<float>( DECISION_INTERVAL );
+            for ( size_t index = 0; index < RobotAxel::Settings::OUTPUTS; index++ )
+            { this->outputs[ index ] = this->ramp_outputs[ index ] + ( this->decision_outputs[ index ] - this->ramp_outputs[ index ] ) * ramp; }
+        }
+        this->decision_phase = ( this->decision_phase + 1 ) % DECISION_INTERVAL;
+        this->held_evaluations++;
+        return;
+    }
+    this->decision_phase = ( this->decision_phase + 1 ) % DECISION_INTERVAL;
+    this->ramp_outputs = this->outputs;
+    // unchanged inputs, the previous decision stands
+    if ( inputsUnchanged() ) this->gated_evaluations++;
+    else
+    {
+        std::chrono::steady_clock::time_point const start = TELEMETRY ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        // compiled network, evaluates the same outputs without allocating
+        if ( COMPILED_NETWORK ) this->phenotype.evaluate( this->decision_outputs, this->inputs );
+        else if ( this->fleet_car ) this->axel_ai->evaluateLeased( this->lease, this->decision_outputs, this->inputs );
+        else this->axel_ai->evaluate( this->decision_outputs, this->inputs );
+        if ( TELEMETRY )
+        {
+            unsigned long long const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+            this->telemetry.evaluate_total += elapsed;
+            if ( elapsed > this->telemetry.evaluate_max ) this->telemetry.evaluate_max = elapsed;
+        }
+        this->evaluations++;
+        this->gated_inputs = this->inputs;
+        this->gate_valid = GATE_EPSILON > 0.0f;
+    }
+    // first step of the ramp, or the decision itself
+    if ( !DECISION_INTERPOLATE ) this->outputs = this->decision_outputs;
+    else
+    {
+        float const ramp = 1.0f / static_cast<float>( DECISION_INTERVAL );
+        for ( size_t index = 0; index < RobotAxel::Settings::OUTPUTS; index++ )
+        { this->outputs[ index ] = this->ramp_outputs[ index ] + ( this->decision_outputs[ index ] - this->ramp_outputs[ index ] ) * ramp; }
+    }
+}
+
+/// <summary>
+/// Checks if no normalised input moved more than GATE_EPSILON since the last network evaluation.
+/// </summary>
+/// <returns>Whenever the previous outputs can be reused.</returns>
+bool const Axel::inputsUnchanged() const
+{
+    if ( !this->gate_valid ) return false;
+    for ( size_t index = 0; index < RobotAxel::Settings::INPUTS; index++ )
+    {
+        if ( std::fabs( this->inputs[ index ] - this->gated_inputs[ index ] ) > GATE_EPSILON ) return false;
+    }
+    return true;
+}
+
+/// <summary>
+/// Makes the next tick decide with a full evaluation, for a new genome.
+/// </summary>
+void Axel::resetDecisions()
+{
+    this->decision_phase = 0;
+    this->gate_valid = false;
+}
+
+/// <summary>
+/// Shows the evaluations skipped by the change gate and decision interval, and resets their counters.
+/// </summary>
+void Axel::showDecisions()
+{
+    if ( GATE_EPSILON > 0.0f || DECISION_INTERVAL > 1 )
+    {
+        std::ostringstream line = std::ostringstream();
+        line
+            << "Evaluations=" << this->evaluations
+            << " Gated=" << this->gated_evaluations
+            << " Held=" << this->held_evaluations;
+        Telemetry_Sink::getInstance().print( line.str() );
+    }
+    this->evaluations = 0;
+    this->gated_evaluations = 0;
+    this->held_evaluations = 0;
+}
+
+/// <summary>
+/// Queues the telemetry of the finished genome evaluation and resets it, fleet cars without a leased genome queue nothing.
+/// </summary>
+void Axel::recordTelemetry()
+{
+    if ( TELEMETRY && ( !this->fleet_car || this->leased ) )
+    {
+        Telemetry_Sink::Record & record = this->telemetry;
+        if ( this->fleet_car ) this->axel_ai->describeLeased( this->lease, record.generation, record.species, record.hash, record.genes, record.neurons );
+        else this->axel_ai->describeCurrent( record.generation, record.species, record.hash, record.genes, record.neurons );
+        // no restart reason, the race ended first
+        if ( record.termination == Telemetry_Sink::RUNNING ) record.termination = Telemetry_Sink::SHUTDOWN;
+        record.evaluations = this->evaluations;
+        record.gated = this->gated_evaluations;
+        record.held = this->held_evaluations;
+        Telemetry_Sink::getInstance().push( record );
+    }
+    this->telemetry = Telemetry_Sink::Record();
+}
+
+/// <summary>
+/// Evaluates current progress and updates AI.
+/// </summary>
+/// <param name="race_state">Current race sensors.</param>
+void Axel::appraise( Sensor_Parser::Race_State const & race_state )
+{
+    // progress appraisal
+    float progress = 0.0f;
+
+    // current time average speed
+    float time_counter = this->total_lap_times + race_state.cur_lap_time;
+    float average_speed = std::sqrt( race_state.speed_x * race_state.speed_x ) / ( time_counter < 1.0f ? 1.0f : time_counter );
+    // best average speed, rewards better average speeds [km/h], uses (average_speed)^2
+    float const speed_term = average_speed * average_speed;
+    progress += speed_term;
+    // distance run, rewards higher distances [m]
+    float const distance_term = PROGRESS_DISTANCE_MULTIPLIER * ( std::log( race_state.dist_raced + std::exp( 1.0f ) ) );
+    progress += distance_term;
+    // current position, rewards higher positions [1 ... N]
+    float position_term = 0.0f;
+    if ( TRAINING && TRAINING_BASE_POSITION )
+    {
+        position_term = PROGRESS_POSITION_REWARD / TRAINING_FORCED_POSITION;
+    }
+    else
+    {
+        position_term = PROGRESS_POSITION_REWARD / static_cast<float>( race_state.race_pos );
+    }
+    progress += position_term;
+    // upper bound of the final progress, only known with a time limit, as the evaluation time only grows and the car can't exceed its top speed
+    float progress_bound = std::numeric_limits<float>::infinity();
+    if ( TRAINING && TRAINING_MAX_TIME > 0.0f )
+    {
+        // the evaluation ends on the first tick past the limit, a second covers it
+        float const remaining_time = std::max( TRAINING_MAX_TIME + 1.0f - time_counter, 0.0f );
+        float const top_average_speed = TRAINING_TOP_SPEED / ( time_counter < 1.0f ? 1.0f : time_counter );
+        // distance term is monotone in distance, raced at top speed till the limit
+        float const top_distance = race_state.dist_raced + TRAINING_TOP_SPEED / 3.6f * remaining_time;
+        float const top_position_term = TRAINING_BASE_POSITION ? position_term : PROGRESS_POSITION_REWARD;
+        progress_bound = top_average_speed * top_average_speed + PROGRESS_DISTANCE_MULTIPLIER * std::log( top_distance + std::exp( 1.0f ) ) + top_position_term;
+    }
+    // fitness terms of the telemetry
+    if ( TELEMETRY )
+    {
+        this->telemetry.speed_term = speed_term;
+        this->telemetry.distance_term = distance_term;
+        this->telemetry.position_term = position_term;
+        this->telemetry.ticks++;
+        this->telemetry.time = time_counter;
+        this->telemetry.distance = race_state.dist_raced;
+    }
+
+    // update with calculated appraisal, fleet cars keep it till the genome is returned
+    if ( this->fleet_car ) this->progress = progress;
+    else this->axel_ai->appraise( progress, time_counter, progress_bound );
+}
+
+/// <summary>
+/// Determines if race should be restarted.
+/// </summary>
+/// <param name="race_state">Current race sensors.</param>
+void Axel::restartCheck( Sensor_Parser::Race_State const & race_state )
+{
+    // defaults as no restart
+    this->car_control.setMeta( !CarControl::META_RESTART );
+
+    // lap time is different, update lap time and increment lap counter
+    if ( this->last_lap_time != race_state.last_lap_time )
+    {
+        this->last_lap_time = race_state.last_lap_time;
+        this->total_lap_times += this->last_lap_time;
+        this->lap_counter++;
+    }
+
+    // check restart flags, the telemetry keeps the first reason
+    size_t termination = Telemetry_Sink::RUNNING;
+    if ( this->lap_counter >= TRAINING_MAX_LAPS )
+    { termination = Telemetry_Sink::LAPS; }
+    else if ( race_state.damage >= TRAINING_MAX_DAMAGE )
+    { termination = Telemetry_Sink::DAMAGE; }
+    else if ( TRAINING_TIMEOUT - race_state.cur_lap_time - race_state.cur_lap_time + race_state.dist_raced < 0.0f )
+    { termination = Telemetry_Sink::TIMEOUT; }
+    else if ( TRAINING && TRAINING_MAX_TIME > 0.0f && this->total_lap_times + race_state.cur_lap_time >= TRAINING_MAX_TIME )
+    { termination = Telemetry_Sink::TIMEOUT; }
+    else if ( TRAINING && !this->fleet_car && this->axel_ai->abortEvaluation() )
+    { termination = Telemetry_Sink::ABORTED; }
+    else
+    {
+        float horizon = TRAINING && !this->fleet_car ? this->axel_ai->evaluationHorizon() : 0.0f;
+        if ( horizon > 0.0f && this->total_lap_times + race_state.cur_lap_time >= horizon )
+        { termination = Telemetry_Sink::HORIZON; }
+    }
+    if ( termination == Telemetry_Sink::RUNNING ) return;
+    this->car_control.setMeta( CarControl::META_RESTART );
+    if ( this->telemetry.termination == Telemetry_Sink::RUNNING ) this->telemetry.termination = termination;
+}
+
+/// <summary>
+/// Show information such as AI generation, progress results and such.
+/// </summary>
+void Axel::showInformation()
+{
+    size_t generation = 0;
+    size_t species = 0;
+    float progress = 0.0f;
+    float top_progress = 0.0f;
+    size_t top_genes = 0;
+    size_t top_neurons = 0;
+
+    // obtain run information
+    this->axel_ai->getInformation( generation, species, progress, top_progress, top_genes, top_neurons );
+    if ( this->fleet_car ) progress = this->progress;
+
+    // show information if training
+    std::ostringstream line = std::ostringstream();
+    if ( Axel::TRAINING )
+    {
+        line
+            << "Raced=" << distance_raced
+            << " Generation=" << generation
+            << " Species=" << species
+            << " Progress=" << progress
+            << " Top Progress=" << top_progress
+            << " Top Genes=" << top_genes
+            << " Top Neurons=" << top_neurons;
+    }
+    else
+    {
+        line
+            << "Raced=" << distance_raced
+            << " Generation=" << generation
+            << " Top Progress=" << top_progress
+            << " Top Genes=" << top_genes
+            << " Top Neurons=" << top_neurons;
+    }
+    Telemetry_Sink::getInstance().print( line.str() );
+}
+
+/// <summary>
+/// Retrieves the generation of the genome in evaluation.
+/// </summary>
+/// <returns>Current AI generation.</returns>
+size_t const Axel::currentGeneration() const
+{
+    size_t generation = 0;
+    size_t species = 0;
+    float progress = 0.0f;
+    float top_progress = 0.0f;
+    size_t top_genes = 0;
+    size_t top_neurons = 0;
+    this->axel_ai->getInformation( generation, species, progress, top_progress, top_genes, top_neurons );
+    return generation;
+}
+
+#endif
@@ -1,280 +1,648 @@
-/***************************************************************************
-
-    file                 : Axel.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-#pragma once
-
-#ifndef AXEL_DRIVER
-#define AXEL_DRIVER
-
-#include <array>
-#include <cmath>
-#include "BaseDriver.h"
-#include "CarState.h"
-#include "CarControl.h"
-#include "SimpleParser.h"
-#include "WrapperBaseDriver.h"
-#include "robot_axel/AI.hpp"
-#include "robot_axel/Settings.hpp"
-
-constexpr bool const IS_TRAINING = true;
-
-/// <summary>
-/// Axel, an autonomous racing driver for TORCS.
-/// </summary>
-class Axel : public WrapperBaseDriver
-{
-    /***************************************************************************
-     *                                                                         *
-     *   Axel settings.                                                        *
-     *                                                                         *
-     ***************************************************************************/
-    private:
-    /// <summary>
-    /// Training flag.
-    /// </summary>
-    constexpr static bool const TRAINING = IS_TRAINING;
-    /// <summary>
-    /// Training maximum allowed damage.
-    /// </summary>
-    constexpr static float const TRAINING_MAX_DAMAGE = 1000.0f;
-    /// <summary>
-    /// Training timeout.
-    /// </summary>
-    constexpr static float const TRAINING_TIMEOUT = 10.0f;
-    /// <summary>
-    /// Training maximum allowed laps.
-    /// </summary>
-    constexpr static size_t const TRAINING_MAX_LAPS = 3;
-    /// <summary>
-    /// Training min gear is 1.
-    /// </summary>
-    constexpr static bool const TRAINING_NO_REVERSE_OR_NEUTRAL = false;
-    /// <summary>
-    /// Training uses a fixed base position.
-    /// </summary>
-    constexpr static bool const TRAINING_BASE_POSITION = true;
-    /// <summary>
-    /// Sets training position to be as if in forced position.
-    /// </summary>
-    constexpr static float const TRAINING_FORCED_POSITION = 5.0f;
-    /// <summary>
-    /// Multiplier for progress distance, as in multiplier * log ( distance ).
-    /// </summary>
-    constexpr static float const PROGRESS_DISTANCE_MULTIPLIER = 5000.0f;
-    /// <summary>
-    /// Training maximum allowed laps.
-    /// </summary>
-    constexpr static float const PROGRESS_POSITION_REWARD = 50000.0f;
-    /// <summary>
-    /// Gear maximum value.
-    /// </summary>
-    constexpr static float const GEAR_MAX = 7.0f;
-    /// <summary>
-    /// Gear offset, used to compromise gears in a interval of { OFFSET, ..., MAX + OFFSET }.
-    /// </summary>
-    constexpr static float const GEAR_OFFSET = 1.0f;
-    /// <summary>
-    /// RPM maximum value, this is the tachometer maximum value from XML, any value over will be set to this.
-    /// </summary>
-    constexpr static float const RPM_MAX = 10000.0f;
-    /// <summary>
-    /// Angle maximum value, this is equal to pi.
-    /// </summary>
-    constexpr static float const ANGLE_MAX = std::atan( 1.0f ) * 4.0f;
-    /// <summary>
-    /// Angle offset, used to compromise angles in a interval of [ OFFSET, ..., MAX + OFFSET ], this is equal to pi.
-    /// </summary>
-    constexpr static float const ANGLE_OFFSET = std::atan( 1.0f ) * 4.0f;
-    /// <summary>
-    /// Fuel maximum value, this is the fuel tank from XML, any value over will be set to this.
-    /// </summary>
-    constexpr static float const FUEL_MAX = 94.0f;
-    /// <summary>
-    /// Speed maximum value, this is the speedometer maximum value from XML, any value over will be set to this, in [Km/h].
-    /// </summary>
-    constexpr static float const SPEED_MAX = 360.0f;
-    /// <summary>
-    /// Speed offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ], in [Km/h].
-    /// </summary>
-    constexpr static float const SPEED_OFFSET = 360.0f;
-    /// <summary>
-    /// Z maximum value, this is capped at 2Km, any value over will be set to this, in [m].
-    /// </summary>
-    constexpr static float const Z_MAX = 1000.0f;
-    /// <summary>
-    /// Z offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ], in [m].
-    /// </summary>
-    constexpr static float const Z_OFFSET = 1000.0f;
-    /// <summary>
-    /// Spin maximum value, this is capped at 48 rad/s (255/40 R18 [Wheel/Tire specifications from XML] at 360 km/h), any value over will be set to this, in [rad/s].
-    /// </summary>
-    constexpr static float const SPIN_MAX = 48.0f;
-    /// <summary>
-    /// Spin offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ].
-    /// </summary>
-    constexpr static float const SPIN_OFFSET = 48.0f;
-    /// <summary>
-    /// Damage maximum value, any value over will be set to this.
-    /// </summary>
-    constexpr static float const DAMAGE_MAX = 10000.0f;
-    /// <summary>
-    /// Track position maximum value in relation to centre, any value over will be set to this, if [-1, 1] car is in track.
-    /// </summary>
-    constexpr static float const TRACK_POSITION_MAX = 1.5f;
-    /// <summary>
-    /// Track position offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ].
-    /// </summary>
-    constexpr static float const TRACK_POSITION_OFFSET = 1.5f;
-    /// <summary>
-    /// Focus maximum distance, in [m].
-    /// </summary>
-    constexpr static float const FOCUS_DISTANCE_MAX = 200.0f;
-    /// <summary>
-    /// Track maximum distance, in [m].
-    /// </summary>
-    constexpr static float const TRACK_DISTANCE_MAX = 200.0f;
-    /// <summary>
-    /// Opponents maximum distance, in [m].
-    /// </summary>
-    constexpr static float const OPPONENTS_DISTANCE_MAX = 200.0f;
-    /// <summary>
-    /// Focus angle maximum value, in [degrees].
-    /// </summary>
-    constexpr static float const FOCUS_MAX = 90.0f;
-    /// <summary>
-    /// Pedal maximum value.
-    /// </summary>
-    constexpr static float const PEDAL_MAX = 1.0f;
-    /// <summary>
-    /// Pedal offset, used to compromise pedal force in a interval of [ OFFSET, ..., MAX + OFFSET ].
-    /// </summary>
-    constexpr static float const PEDAL_OFFSET = 1.0f;
-
-    /***************************************************************************
-     *                                                                         *
-     *   Axel local constants and variables.                                   *
-     *                                                                         *
-     ***************************************************************************/
-    private:
-    /// <summary>
-    /// Robot Axel AI controller.
-    /// </summary>
-    RobotAxel::AI * const axel_ai;
-    /// <summary>
-    /// AI inputs, must be compromised by values between [0, 1].
-    /// </summary>
-    std::array<float, RobotAxel::Settings::INPUTS> inputs;
-    /// <summary>
-    /// AI outputs, will be compromised by values between [-1, 1].
-    /// </summary>
-    std::array<float, RobotAxel::Settings::OUTPUTS> outputs;
-    /// <summary>
-    /// Robot Axel AI controller.
-    /// </summary>
-    CarControl car_control;
-    /// <summary>
-    /// Number of laps made.
-    /// </summary>
-    size_t lap_counter;
-    /// <summary>
-    /// Time of last lap, for lap counting.
-    /// </summary>
-    float last_lap_time;
-    /// <summary>
-    /// Total previous laps times.
-    /// </summary>
-    float total_lap_times;
-    /// <summary>
-    /// Distance raced.
-    /// </summary>
-    float distance_raced;
-
-    /***************************************************************************
-     *                                                                         *
-     *   Axel interface.                                                       *
-     *                                                                         *
-     ***************************************************************************/
-    public:
-    /// <summary>
-    /// Initialises local constants and variables.
-    /// </summary>
-    Axel();
-
-    /// <summary>
-    /// Deletes all local constants and variables created with new on the constructor.
-    /// </summary> 
-    ~Axel();
-
-    /// <summary>
-    /// Called before the beginning of the race and can be used to define a custom configuration of the track sensors.
-    /// </summary>
-    /// <param name="angles">Angles of the 19 range finder sensors, displayed clockwise.< / param>
-    virtual void init( float * angles );
-
-    /// <summary>
-    /// Called at the end of the race, before the driver module is unloaded.
-    /// </summary>
-    virtual void onShutdown();
-
-    /// <summary>
-    /// Called when the race is restarted upon the driver request.
-    /// </summaryA>
-    virtual void onRestart();
-
-    /// <summary>
-    /// Drive control, calls the wrapper drive function that translates the state string to the CarState and the returned CarControl to string.
-    /// </summary>
-    /// <param name="car_state">Sensors state.</param>
-    /// <returns>Actions taken.</returns>
-    virtual CarControl wDrive( CarState car_state );
-
-    /***************************************************************************
-     *                                                                         *
-     *   Axel Utilities.                                                       *
-     *                                                                         *
-     ***************************************************************************/
-    private:
-    /// <summary>
-    /// Creates a new AI and returns it's pointer.
-    /// </summary>
-    RobotAxel::AI * const generateAI( bool const & training ) const;
-
-    /// <summary>
-    /// Converts the necessary CarState inputs to an array of floats for AI use.
-    /// </summary>
-    /// <param name="car_state">Current sensors state.</param>
-    void convertInputs( CarState & car_state );
-
-    /// <summary>
-    /// Converts AI outputs to CarControl sent into TORCS.
-    /// </summary>
-    void convertOutputs();
-
-    /// <summary>
-    /// Sends input information to AI.
-    /// </summary>
-    void evaluate();
-
-    /// <summary>
-    /// Evaluates current progress.
-    /// </summary>
-    /// <param name="car_state">Current sensors state.</param>
-    void appraise( CarState & car_state );
-
-    /// <summary>
-    /// Determines if race should be restarted.
-    /// </summary>
-    /// <param name="car_state">Current sensors state.</param>
-    void restartCheck( CarState & car_state );
-
-    /// <summary>
-    /// Show information such as AI generation, progress results and such.
-    /// </summary>
-    void showInformation();
-};
-
-#endif
+/***************************************************************************
+
+    file                 : Axel.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_DRIVER
+#define AXEL_DRIVER
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "BaseDriver.h"
+#include "CarState.h"
+#include "CarControl.h"
+#include "Deadline_Watchdog.hpp"
+#include "Latency_Profiler.hpp"
+#include "Sensor_Parser.hpp"
+#include "SimpleParser.h"
+#include "Telemetry_Sink.hpp"
+#include "Trace_Recorder.hpp"
+#include "WrapperBaseDriver.h"
+#include "robot_axel/AI.hpp"
+#include "robot_axel/Phenotype.hpp"
+#include "robot_axel/Settings.hpp"
+
+constexpr bool const IS_TRAINING = true;
+
+/// <summary>
+/// Axel, an autonomous racing driver for TORCS.
+/// </summary>
+class Axel : public WrapperBaseDriver
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Axel settings.                                                        *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Training flag.
+    /// </summary>
+    constexpr static bool const TRAINING = IS_TRAINING;
+    /// <summary>
+    /// Training maximum allowed damage.
+    /// </summary>
+    constexpr static float const TRAINING_MAX_DAMAGE = 1000.0f;
+    /// <summary>
+    /// Training timeout.
+    /// </summary>
+    constexpr static float const TRAINING_TIMEOUT = 10.0f;
+    /// <summary>
+    /// Training evaluation time limit, in [s], 0 for none, the horizon of the progress bound that early termination compares.
+    /// </summary>
+    constexpr static float const TRAINING_MAX_TIME = 0.0f;
+    /// <summary>
+    /// Highest speed a car can reach, in [km/h], bounds the progress an evaluation can still make.
+    /// </summary>
+    constexpr static float const TRAINING_TOP_SPEED = 360.0f;
+    /// <summary>
+    /// Training maximum allowed laps.
+    /// </summary>
+    constexpr static size_t const TRAINING_MAX_LAPS = 3;
+    /// <summary>
+    /// Training min gear is 1.
+    /// </summary>
+    constexpr static bool const TRAINING_NO_REVERSE_OR_NEUTRAL = false;
+    /// <summary>
+    /// Training uses a fixed base position.
+    /// </summary>
+    constexpr static bool const TRAINING_BASE_POSITION = true;
+    /// <summary>
+    /// Sets training position to be as if in forced position.
+    /// </summary>
+    constexpr static float const TRAINING_FORCED_POSITION = 5.0f;
+    /// <summary>
+    /// Records every sensors state and produced control to a trace in traces/, for offline replay.
+    /// </summary>
+    constexpr static bool const RECORD_TRACE = false;
+    /// <summary>
+    /// Times every tick stage, printing per genome and per generation percentiles and writing them to LATENCY_FILE.
+    /// </summary>
+    constexpr static bool const PROFILE_LATENCY = true;
+    /// <summary>
+    /// Prometheus text file with the latest latency percentiles, fleet cars only print them.
+    /// </summary>
+    constexpr static char const * const LATENCY_FILE = "latency.prom";
+    /// <summary>
+    /// Queues a record per evaluated genome, with its fitness terms, termination reason and evaluation times, written to telemetry/ in the background.
+    /// </summary>
+    constexpr static bool const TELEMETRY = true;
+    /// <summary>
+    /// Real-time mode, locks memory, evaluates a preallocated compiled network and skips decisions past the tick deadline.
+    /// </summary>
+    constexpr static bool const REAL_TIME = false;
+    /// <summary>
+    /// Single car scenario, the opponent inputs are folded into the compiled network at their no opponent reading, as constants ( Single car only ).
+    /// </summary>
+    constexpr static bool const SPECIALIZE_OPPONENTS = false;
+    /// <summary>
+    /// Evaluates through a compiled network, for real-time mode, incremental evaluation or a specialized scenario.
+    /// </summary>
+    constexpr static bool const COMPILED_NETWORK = REAL_TIME || RobotAxel::Settings::INCREMENTAL_EVALUATION || SPECIALIZE_OPPONENTS;
+    /// <summary>
+    /// Real-time SCHED_FIFO priority, 0 keeps the default scheduling ( Real-time only ).
+    /// </summary>
+    constexpr static int const REAL_TIME_PRIORITY = 0;
+    /// <summary>
+    /// Real-time pinned CPU, -1 keeps every CPU ( Real-time only ).
+    /// </summary>
+    constexpr static int const REAL_TIME_CPU = -1;
+    /// <summary>
+    /// Stack touched on real-time start, so the first ticks do not fault it in, in [bytes] ( Real-time only ).
+    /// </summary>
+    constexpr static size_t const REAL_TIME_STACK = 64 * 1024;
+    /// <summary>
+    /// Tick deadline, under the 10 ms the SCR server waits for a control before reusing the previous one, in [s] ( Real-time only ).
+    /// </summary>
+    constexpr static float const DEADLINE_BUDGET = 0.008f;
+    /// <summary>
+    /// Consecutive skipped decisions holding the previous control, later ones use the fallback control ( Real-time only ).
+    /// </summary>
+    constexpr static size_t const DEADLINE_HELD_TICKS = 5;
+    /// <summary>
+    /// Fallback acceleration, a cautious pace while following the track axis ( Real-time only ).
+    /// </summary>
+    constexpr static float const FALLBACK_ACCEL = 0.3f;
+    /// <summary>
+    /// Steering lock, in [rad], the steer value that turns the wheels fully ( Real-time only ).
+    /// </summary>
+    constexpr static float const STEER_LOCK = 0.366519f;
+    /// <summary>
+    /// Change gate, the previous outputs are reused while no normalised input moved more than this since the last evaluation, 0 evaluates every decision.
+    /// </summary>
+    constexpr static float const GATE_EPSILON = 0.0f;
+    /// <summary>
+    /// Decision interval, the network runs every DECISION_INTERVAL ticks and the outputs are held or interpolated in between.
+    /// </summary>
+    constexpr static size_t const DECISION_INTERVAL = 1;
+    /// <summary>
+    /// Interpolates the outputs between decisions, ramping from the outputs sent at a decision to the new ones over the interval, instead of holding them.
+    /// </summary>
+    constexpr static bool const DECISION_INTERPOLATE = false;
+    /// <summary>
+    /// Multiplier for progress distance, as in multiplier * log ( distance ).
+    /// </summary>
+    constexpr static float const PROGRESS_DISTANCE_MULTIPLIER = 5000.0f;
+    /// <summary>
+    /// Training maximum allowed laps.
+    /// </summary>
+    constexpr static float const PROGRESS_POSITION_REWARD = 50000.0f;
+    /// <summary>
+    /// Gear maximum value.
+    /// </summary>
+    constexpr static float const GEAR_MAX = 7.0f;
+    /// <summary>
+    /// Gear offset, used to compromise gears in a interval of { OFFSET, ..., MAX + OFFSET }.
+    /// </summary>
+    constexpr static float const GEAR_OFFSET = 1.0f;
+    /// <summary>
+    /// RPM maximum value, this is the tachometer maximum value from XML, any value over will be set to this.
+    /// </summary>
+    constexpr static float const RPM_MAX = 10000.0f;
+    /// <summary>
+    /// Angle maximum value, this is equal to pi.
+    /// </summary>
+    constexpr static float const ANGLE_MAX = std::atan( 1.0f ) * 4.0f;
+    /// <summary>
+    /// Angle offset, used to compromise angles in a interval of [ OFFSET, ..., MAX + OFFSET ], this is equal to pi.
+    /// </summary>
+    constexpr static float const ANGLE_OFFSET = std::atan( 1.0f ) * 4.0f;
+    /// <summary>
+    /// Fuel maximum value, this is the fuel tank from XML, any value over will be set to this.
+    /// </summary>
+    constexpr static float const FUEL_MAX = 94.0f;
+    /// <summary>
+    /// Speed maximum value, this is the speedometer maximum value from XML, any value over will be set to this, in [Km/h].
+    /// </summary>
+    constexpr static float const SPEED_MAX = 360.0f;
+    /// <summary>
+    /// Speed offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ], in [Km/h].
+    /// </summary>
+    constexpr static float const SPEED_OFFSET = 360.0f;
+    /// <summary>
+    /// Z maximum value, this is capped at 2Km, any value over will be set to this, in [m].
+    /// </summary>
+    constexpr static float const Z_MAX = 1000.0f;
+    /// <summary>
+    /// Z offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ], in [m].
+    /// </summary>
+    constexpr static float const Z_OFFSET = 1000.0f;
+    /// <summary>
+    /// Spin maximum value, this is capped at 48 rad/s (255/40 R18 [Wheel/Tire specifications from XML] at 360 km/h), any value over will be set to this, in [rad/s].
+    /// </summary>
+    constexpr static float const SPIN_MAX = 48.0f;
+    /// <summary>
+    /// Spin offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ].
+    /// </summary>
+    constexpr static float const SPIN_OFFSET = 48.0f;
+    /// <summary>
+    /// Damage maximum value, any value over will be set to this.
+    /// </summary>
+    constexpr static float const DAMAGE_MAX = 10000.0f;
+    /// <summary>
+    /// Track position maximum value in relation to centre, any value over will be set to this, if [-1, 1] car is in track.
+    /// </summary>
+    constexpr static float const TRACK_POSITION_MAX = 1.5f;
+    /// <summary>
+    /// Track position offset, used to compromise speed in a interval of [ OFFSET, ..., MAX + OFFSET ].
+    /// </summary>
+    constexpr static float const TRACK_POSITION_OFFSET = 1.5f;
+    /// <summary>
+    /// Focus maximum distance, in [m].
+    /// </summary>
+    constexpr static float const FOCUS_DISTANCE_MAX = 200.0f;
+    /// <summary>
+    /// Track maximum distance, in [m].
+    /// </summary>
+    constexpr static float const TRACK_DISTANCE_MAX = 200.0f;
+    /// <summary>
+    /// Opponents maximum distance, in [m].
+    /// </summary>
+    constexpr static float const OPPONENTS_DISTANCE_MAX = 200.0f;
+    /// <summary>
+    /// Focus angle maximum value, in [degrees].
+    /// </summary>
+    constexpr static float const FOCUS_MAX = 90.0f;
+    /// <summary>
+    /// Pedal maximum value.
+    /// </summary>
+    constexpr static float const PEDAL_MAX = 1.0f;
+    /// <summary>
+    /// Pedal offset, used to compromise pedal force in a interval of [ OFFSET, ..., MAX + OFFSET ].
+    /// </summary>
+    constexpr static float const PEDAL_OFFSET = 1.0f;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Input normalisation tables.                                           *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Normalisation of every input slot, as ( max( min( raw, MAXIMUM ), MINIMUM ) + OFFSET ) / DIVISOR.
+    /// </summary>
+    struct Normalization
+    {
+        /// <summary>
+        /// Lower clamp, applied after the upper one.
+        /// </summary>
+        std::array<float, RobotAxel::Settings::INPUTS> minimums;
+        /// <summary>
+        /// Upper clamp.
+        /// </summary>
+        std::array<float, RobotAxel::Settings::INPUTS> maximums;
+        /// <summary>
+        /// Offset added to the clamped value.
+        /// </summary>
+        std::array<float, RobotAxel::Settings::INPUTS> offsets;
+        /// <summary>
+        /// Divisor of the offset value.
+        /// </summary>
+        std::array<float, RobotAxel::Settings::INPUTS> divisors;
+    };
+    /// <summary>
+    /// Normalisation tables, generated from the settings by normalization().
+    /// </summary>
+    static Normalization const NORMALIZATION;
+
+    /// <summary>
+    /// Generates the normalisation tables from the settings, reliability slots are copied and set afterwards.
+    /// </summary>
+    /// <returns>Normalisation tables.</returns>
+    constexpr static Normalization const normalization()
+    {
+        constexpr float const UNBOUNDED = std::numeric_limits<float>::infinity();
+        Normalization table = {};
+        auto set = [ & ]( size_t const first, size_t const count, float const minimum, float const maximum, float const offset, float const divisor )
+        {
+            for ( size_t index = first; index < first + count; index++ )
+            {
+                table.minimums[ index ] = minimum;
+                table.maximums[ index ] = maximum;
+                table.offsets[ index ] = offset;
+                table.divisors[ index ] = divisor;
+            }
+        };
+        set( 0, RobotAxel::Settings::INPUTS, -UNBOUNDED, UNBOUNDED, 0.0f, 1.0f );
+        // gear { -1, ..., 6 } --> { GEAR_OFFSET, ..., GEAR_MAX + GEAR_OFFSET } / (GEAR_MAX + GEAR_OFFSET)
+        set( Sensor_Parser::GEAR, 1, -UNBOUNDED, UNBOUNDED, GEAR_OFFSET, GEAR_MAX + GEAR_OFFSET );
+        // rpm [0, +infinity[ --> [0, RPM_MAX] / RPM_MAX
+        set( Sensor_Parser::RPM, 1, -UNBOUNDED, RPM_MAX, 0.0f, RPM_MAX );
+        // angle [-pi, +pi] --> [ANGLE_OFFSET, ANGLE_MAX + ANGLE_OFFSET] / (ANGLE_MAX + ANGLE_OFFSET)
+        set( Sensor_Parser::ANGLE, 1, -UNBOUNDED, UNBOUNDED, ANGLE_OFFSET, ANGLE_MAX + ANGLE_OFFSET );
+        // fuel [0, +infinity[ --> [0, FUEL_MAX] / FUEL_MAX
+        set( Sensor_Parser::FUEL, 1, -UNBOUNDED, FUEL_MAX, 0.0f, FUEL_MAX );
+        // speed(x, y, z) ]-infinity, +infinity[ --> [SPEED_OFFSET, SPEED_MAX + SPEED_OFFSET] / (SPEED_MAX + SPEED_OFFSET)
+        set( Sensor_Parser::SPEED, 3, -SPEED_OFFSET, SPEED_MAX, SPEED_OFFSET, SPEED_MAX + SPEED_OFFSET );
+        // z ]-infinity, + infinity[ --> [Z_OFFSET, Z_MAX + Z_OFFSET] / (Z_MAX + Z_OFFSET)
+        set( Sensor_Parser::Z, 1, -Z_OFFSET, Z_MAX, Z_OFFSET, Z_MAX + Z_OFFSET );
+        // damage [0, + infinity] --> [0, DAMAGE_MAX] / DAMAGE_MAX
+        set( Sensor_Parser::DAMAGE, 1, -UNBOUNDED, DAMAGE_MAX, 0.0f, DAMAGE_MAX );
+        // track position ]-infinity, + infinity[ --> [TRACK_POSITION_OFFSET, TRACK_POSITION_MAX + TRACK_POSITION_OFFSET] / (TRACK_POSITION_MAX + TRACK_POSITION_OFFSET)
+        set( Sensor_Parser::TRACK_POSITION, 1, -TRACK_POSITION_OFFSET, TRACK_POSITION_MAX, TRACK_POSITION_OFFSET, TRACK_POSITION_MAX + TRACK_POSITION_OFFSET );
+        // wheel spin angular velocity [0, +infinity] --> [SPIN_OFFSET, SPIN_MAX + SPIN_OFFSET] / (SPIN_MAX + SPIN_OFFSET)
+        set( Sensor_Parser::WHEEL_SPIN, 4, -SPIN_OFFSET, SPIN_MAX, SPIN_OFFSET, SPIN_MAX + SPIN_OFFSET );
+        // focus [0, 200] --> [0, FOCUS_DISTANCE_MAX] / FOCUS_DISTANCE_MAX
+        set( Sensor_Parser::FOCUS, Sensor_Parser::FOCUS_SLOTS, -UNBOUNDED, FOCUS_DISTANCE_MAX, 0.0f, FOCUS_DISTANCE_MAX );
+        // track [0, 200] --> [0, TRACK_DISTANCE_MAX] / TRACK_DISTANCE_MAX
+        set( Sensor_Parser::TRACK, Sensor_Parser::TRACK_SLOTS, -UNBOUNDED, TRACK_DISTANCE_MAX, 0.0f, TRACK_DISTANCE_MAX );
+        // opponents [0, 200] --> [0, OPPONENTS_DISTANCE_MAX] / OPPONENTS_DISTANCE_MAX
+        set( Sensor_Parser::OPPONENTS, Sensor_Parser::OPPONENTS_SLOTS, -UNBOUNDED, OPPONENTS_DISTANCE_MAX, 0.0f, OPPONENTS_DISTANCE_MAX );
+        return table;
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Axel local constants and variables.                                   *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Robot Axel AI controller.
+    /// </summary>
+    RobotAxel::AI * const axel_ai;
+    /// <summary>
+    /// Sensors and control trace recorder, null if not recording.
+    /// </summary>
+    Trace_Recorder * const trace_recorder;
+    /// <summary>
+    /// AI inputs, must be compromised by values between [0, 1], hold raw sensor values until normalised.
+    /// </summary>
+    Sensor_Parser::Slots inputs;
+    /// <summary>
+    /// AI outputs, will be compromised by values between [-1, 1].
+    /// </summary>
+    std::array<float, RobotAxel::Settings::OUTPUTS> outputs;
+    /// <summary>
+    /// Robot Axel AI controller.
+    /// </summary>
+    CarControl car_control;
+    /// <summary>
+    /// Number of laps made.
+    /// </summary>
+    size_t lap_counter;
+    /// <summary>
+    /// Time of last lap, for lap counting.
+    /// </summary>
+    float last_lap_time;
+    /// <summary>
+    /// Total previous laps times.
+    /// </summary>
+    float total_lap_times;
+    /// <summary>
+    /// Distance raced.
+    /// </summary>
+    float distance_raced;
+    /// <summary>
+    /// Race sensors of the current tick.
+    /// </summary>
+    Sensor_Parser::Race_State race_state;
+    /// <summary>
+    /// Fleet car flag, drives genomes leased from an AI shared with other cars.
+    /// </summary>
+    bool const fleet_car;
+    /// <summary>
+    /// Leased genome identifier ( Fleet only ).
+    /// </summary>
+    size_t lease;
+    /// <summary>
+    /// Whenever a genome is leased ( Fleet only ).
+    /// </summary>
+    bool leased;
+    /// <summary>
+    /// Whenever the evaluation ended and the car waits parked for the other cars ( Fleet only ).
+    /// </summary>
+    bool finished;
+    /// <summary>
+    /// Progress of the leased genome ( Fleet only ).
+    /// </summary>
+    float progress;
+    /// <summary>
+    /// Tick stages latency profiler.
+    /// </summary>
+    Latency_Profiler latency_profiler;
+    /// <summary>
+    /// Compiled network of the genome in evaluation ( Compiled network only ).
+    /// </summary>
+    RobotAxel::Phenotype phenotype;
+    /// <summary>
+    /// Tick deadline watchdog ( Real-time only ).
+    /// </summary>
+    Deadline_Watchdog deadline_watchdog;
+    /// <summary>
+    /// Ticks since the last decision, 0 when a decision is due.
+    /// </summary>
+    size_t decision_phase;
+    /// <summary>
+    /// Whenever the gated inputs hold the inputs of an evaluation of the current genome.
+    /// </summary>
+    bool gate_valid;
+    /// <summary>
+    /// Inputs of the last network evaluation, for the change gate.
+    /// </summary>
+    Sensor_Parser::Slots gated_inputs;
+    /// <summary>
+    /// Outputs sent when the last decision was taken, the interpolation start.
+    /// </summary>
+    std::array<float, RobotAxel::Settings::OUTPUTS> ramp_outputs;
+    /// <summary>
+    /// Outputs of the last decision, the interpolation end.
+    /// </summary>
+    std::array<float, RobotAxel::Settings::OUTPUTS> decision_outputs;
+    /// <summary>
+    /// Network evaluations of the current genome.
+    /// </summary>
+    size_t evaluations;
+    /// <summary>
+    /// Decisions of the current genome reusing the previous outputs as the inputs barely changed.
+    /// </summary>
+    size_t gated_evaluations;
+    /// <summary>
+    /// Ticks of the current genome between decisions, holding or interpolating the outputs.
+    /// </summary>
+    size_t held_evaluations;
+    /// <summary>
+    /// Telemetry of the current genome evaluation.
+    /// </summary>
+    Telemetry_Sink::Record telemetry;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Axel interface.                                                       *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Initialises local constants and variables.
+    /// </summary>
+    /// <param name="training">Whenever should the AI train.</param>
+    /// <param name="recording">Whenever should driving be recorded to a trace.</param>
+    Axel( bool const & training = IS_TRAINING, bool const & recording = RECORD_TRACE );
+
+    /// <summary>
+    /// Initialises a fleet car, driving genomes leased from an AI shared with other cars.
+    /// </summary>
+    /// <param name="fleet_ai">Shared AI, owned by the fleet.</param>
+    Axel( RobotAxel::AI * const fleet_ai );
+
+    /// <summary>
+    /// Initialises a racing driver for a given genome, for offline tools.
+    /// </summary>
+    /// <param name="genome">Genome to race.</param>
+    Axel( RobotAxel::Genome const & genome );
+
+    /// <summary>
+    /// Deletes all local constants and variables created with new on the constructor.
+    /// </summary> 
+    ~Axel();
+
+    /// <summary>
+    /// Called before the beginning of the race and can be used to define a custom configuration of the track sensors.
+    /// </summary>
+    /// <param name="angles">Angles of the 19 range finder sensors, displayed clockwise.< / param>
+    virtual void init( float * angles );
+
+    /// <summary>
+    /// Called at the end of the race, before the driver module is unloaded.
+    /// </summary>
+    virtual void onShutdown();
+
+    /// <summary>
+    /// Called when the race is restarted upon the driver request.
+    /// </summaryA>
+    virtual void onRestart();
+
+    /// <summary>
+    /// Drive control, parses the sensors message straight into the AI inputs and returns the control message.
+    /// </summary>
+    /// <remarks>
+    /// Skips the CarState round trip of the wrapper drive, which is still taken when recording a trace.
+    /// </remarks>
+    /// <param name="sensors">Sensors message.</param>
+    /// <returns>Control message.</returns>
+    virtual std::string drive( std::string sensors );
+
+    /// <summary>
+    /// Drive control, calls the wrapper drive function that translates the state string to the CarState and the returned CarControl to string.
+    /// </summary>
+    /// <param name="car_state">Sensors state.</param>
+    /// <returns>Actions taken.</returns>
+    virtual CarControl wDrive( CarState car_state );
+
+    /// <summary>
+    /// Decides the car control for a sensors state, converting inputs, evaluating and converting outputs, without appraisal or restart checks.
+    /// </summary>
+    /// <param name="car_state">Sensors state.</param>
+    /// <returns>Actions taken.</returns>
+    CarControl const & decide( CarState & car_state );
+
+    /// <summary>
+    /// Checks if the car finished its evaluation and waits parked for the other fleet cars.
+    /// </summary>
+    /// <returns>Whenever the car is parked.</returns>
+    bool const isFinished() const;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Axel Utilities.                                                       *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Creates a new AI and returns it's pointer.
+    /// </summary>
+    RobotAxel::AI * const generateAI( bool const & training ) const;
+
+    /// <summary>
+    /// Redirects the AI generation lines and reports to the telemetry sink, off the driving thread.
+    /// </summary>
+    void redirectOutput() const;
+
+    /// <summary>
+    /// Creates a trace recorder, named after the current time, if recording.
+    /// </summary>
+    /// <param name="recording">Whenever should driving be recorded.</param>
+    /// <returns>A trace recorder pointer or a null pointer.</returns>
+    Trace_Recorder * const generateTraceRecorder( bool const & recording ) const;
+
+    /// <summary>
+    /// Converts the necessary CarState inputs to an array of floats for AI use.
+    /// </summary>
+    /// <param name="car_state">Current sensors state.</param>
+    void convertInputs( CarState & car_state );
+
+    /// <summary>
+    /// Normalises the raw sensor values held by the inputs, in place, and fills the reliability inputs.
+    /// </summary>
+    void normalizeInputs();
+
+    /// <summary>
+    /// Sets a reliability input, a sensor group is unreliable from its first negative value onwards, which are zeroed.
+    /// </summary>
+    /// <param name="non_negative">Raw values that were not negative, a bit per slot.</param>
+    /// <param name="first">First slot of the group.</param>
+    /// <param name="count">Number of slots of the group.</param>
+    /// <param name="reliability">Reliability slot.</param>
+    void setReliability( unsigned long long const & non_negative, size_t const & first, size_t const & count, size_t const & reliability );
+
+    /// <summary>
+    /// Converts AI outputs to CarControl sent into TORCS.
+    /// </summary>
+    void convertOutputs();
+
+    /// <summary>
+    /// Locks memory, touches the stack and applies the CPU pinning and scheduling priority, warning on failures ( Real-time only ).
+    /// </summary>
+    void enterRealTime() const;
+
+    /// <summary>
+    /// Declares the scenario constant inputs to the compiled network, before its first build ( Specialized only ).
+    /// </summary>
+    void specializePhenotype();
+
+    /// <summary>
+    /// Compiles the network of the genome in evaluation ( Compiled network only ).
+    /// </summary>
+    void compilePhenotype();
+
+    /// <summary>
+    /// Steers towards the track axis at a cautious pace, for decisions skipped too long ( Real-time only ).
+    /// </summary>
+    /// <param name="angle">Angle to the track axis, in [rad].</param>
+    /// <param name="track_position">Position in relation to the track axis.</param>
+    void fallback( float const & angle, float const & track_position );
+
+    /// <summary>
+    /// Leases the next genome to evaluate, the car is parked for the evaluation if none is left ( Fleet only ).
+    /// </summary>
+    void leaseGenome();
+
+    /// <summary>
+    /// Brakes to a stop, without restarting.
+    /// </summary>
+    void park();
+
+    /// <summary>
+    /// Writes the car control as a SCR control message.
+    /// </summary>
+    /// <returns>Control message.</returns>
+    std::string controlMessage();
+
+    /// <summary>
+    /// Sends input information to AI, unless between decisions or gated by an unchanged input.
+    /// </summary>
+    void evaluate();
+
+    /// <summary>
+    /// Checks if no normalised input moved more than GATE_EPSILON since the last network evaluation.
+    /// </summary>
+    /// <returns>Whenever the previous outputs can be reused.</returns>
+    bool const inputsUnchanged() const;
+
+    /// <summary>
+    /// Makes the next tick decide with a full evaluation, for a new genome.
+    /// </summary>
+    void resetDecisions();
+
+    /// <summary>
+    /// Shows the evaluations skipped by the change gate and decision interval, and resets their counters.
+    /// </summary>
+    void showDecisions();
+
+    /// <summary>
+    /// Queues the telemetry of the finished genome evaluation and resets it, fleet cars without a leased genome queue nothing.
+    /// </summary>
+    void recordTelemetry();
+
+    /// <summary>
+    /// Evaluates current progress.
+    /// </summary>
+    /// <param name="race_state">Current race sensors.</param>
+    void appraise( Sensor_Parser::Race_State const & race_state );
+
+    /// <summary>
+    /// Determines if race should be restarted.
+    /// </summary>
+    /// <param name="race_state">Current race sensors.</param>
+    void restartCheck( Sensor_Parser::Race_State const & race_state );
+
+    /// <summary>
+    /// Show information such as AI generation, progress results and such.
+    /// </summary>
+    void showInformation();
+
+    /// <summary>
+    /// Retrieves the generation of the genome in evaluation.
+    /// </summary>
+    /// <returns>Current AI generation.</returns>
+    size_t const currentGeneration() const;
+};
+
+#endif
@@ -0,0 +1,158 @@
+/***************************************************************************
+
+    file                 : Deadline_Watchdog.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Deadline_Watchdog.hpp"
+
+#if defined (AXEL_DEADLINE_WATCHDOG)
+
+#include <sstream>
+#include "Telemetry_Sink.hpp"
+
+/***************************************************************************
+ *                                                                         *
+ *   Deadline_Watchdog interface.                                          *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Generates a watchdog without predictions.
+/// </summary>
+/// <param name="enabled">Whenever should ticks be watched.</param>
+/// <param name="budget">Tick budget, in [s].</param>
+/// <param name="held_ticks">Consecutive skipped decisions holding the previous control.</param>
+Deadline_Watchdog::Deadline_Watchdog( bool const & enabled, float const & budget, size_t const & held_ticks )
+    : enabled( enabled ), budget( static_cast<unsigned long long>( budget * 1e9f ) ), held_ticks( held_ticks ), decision_cost( 0 ), skipped( 0 ),
+    tick_start(), decision_start(), ticks( 0 ), total_ticks( 0 ), missed( 0 ), total_missed( 0 ), held( 0 ), total_held( 0 ), fallbacks( 0 ),
+    total_fallbacks( 0 ) {}
+
+/// <summary>
+/// Starts watching a tick.
+/// </summary>
+void Deadline_Watchdog::startTick()
+{
+    if ( !this->enabled ) return;
+    this->tick_start = std::chrono::steady_clock::now();
+}
+
+/// <summary>
+/// Checks if a decision still fits the tick budget, counting it as held or fallback if not.
+/// </summary>
+/// <returns>Whenever the decision should be taken.</returns>
+bool const Deadline_Watchdog::allowDecision()
+{
+    if ( !this->enabled ) return true;
+    unsigned long long const elapsed = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - this->tick_start ).count() );
+    if ( elapsed + this->decision_cost <= this->budget )
+    {
+        this->skipped = 0;
+        return true;
+    }
+    // skipped, the prediction decays so a single outlier does not skip every decision
+    this->decision_cost -= this->decision_cost / COST_DECAY;
+    this->skipped++;
+    if ( fallbackDue() ) this->fallbacks++;
+    else this->held++;
+    return false;
+}
+
+/// <summary>
+/// Checks if the skipped decision needs a fallback control, rather than holding the previous one.
+/// </summary>
+/// <returns>Whenever a fallback control is due.</returns>
+bool const Deadline_Watchdog::fallbackDue() const
+{
+    return this->skipped > this->held_ticks;
+}
+
+/// <summary>
+/// Starts timing a decision.
+/// </summary>
+void Deadline_Watchdog::startDecision()
+{
+    if ( !this->enabled ) return;
+    this->decision_start = std::chrono::steady_clock::now();
+}
+
+/// <summary>
+/// Finishes timing a decision, updating the prediction.
+/// </summary>
+void Deadline_Watchdog::finishDecision()
+{
+    if ( !this->enabled ) return;
+    unsigned long long const cost = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - this->decision_start ).count() );
+    // decaying maximum, follows cost spikes at once and recovers slowly
+    this->decision_cost -= this->decision_cost / COST_DECAY;
+    this->decision_cost = cost > this->decision_cost ? cost : this->decision_cost;
+}
+
+/// <summary>
+/// Finishes watching a tick, counting it as missed if over budget.
+/// </summary>
+void Deadline_Watchdog::finishTick()
+{
+    if ( !this->enabled ) return;
+    unsigned long long const elapsed = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - this->tick_start ).count() );
+    this->ticks++;
+    if ( elapsed > this->budget ) this->missed++;
+}
+
+/// <summary>
+/// Prints the genome deadline counters and adds them to the race ones.
+/// </summary>
+void Deadline_Watchdog::finishGenome()
+{
+    if ( !this->enabled || this->ticks == 0 ) return;
+    print( "Genome deadlines", this->ticks, this->missed, this->held, this->fallbacks );
+    this->total_ticks += this->ticks;
+    this->total_missed += this->missed;
+    this->total_held += this->held;
+    this->total_fallbacks += this->fallbacks;
+    this->ticks = 0;
+    this->missed = 0;
+    this->held = 0;
+    this->fallbacks = 0;
+    this->skipped = 0;
+}
+
+/// <summary>
+/// Prints the race deadline counters.
+/// </summary>
+void Deadline_Watchdog::finishRace() const
+{
+    if ( !this->enabled || this->total_ticks == 0 ) return;
+    print( "Race deadlines", this->total_ticks, this->total_missed, this->total_held, this->total_fallbacks );
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Deadline_Watchdog utilities.                                          *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Prints deadline counters in a line.
+/// </summary>
+/// <param name="title">Line title.</param>
+/// <param name="ticks">Watched ticks.</param>
+/// <param name="missed">Ticks over budget.</param>
+/// <param name="held">Ticks holding the previous control.</param>
+/// <param name="fallbacks">Ticks with a fallback control.</param>
+void Deadline_Watchdog::print( std::string const & title, size_t const & ticks, size_t const & missed, size_t const & held, size_t const & fallbacks ) const
+{
+    std::ostringstream line = std::ostringstream();
+    line
+        << title << " [" << this->budget / 1000 << " us]"
+        << " Ticks=" << ticks
+        << " Missed=" << missed
+        << " Held=" << held
+        << " Fallback=" << fallbacks
+        << " Predicted=" << static_cast<double>( this->decision_cost ) / 1000.0 << " us";
+    Telemetry_Sink::getInstance().print( line.str() );
+}
+
+#endif
@@ -0,0 +1,154 @@
+/***************************************************************************
+
+    file                 : Deadline_Watchdog.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_DEADLINE_WATCHDOG
+#define AXEL_DEADLINE_WATCHDOG
+
+#include <chrono>
+#include <string>
+
+/// <summary>
+/// Tick deadline watchdog, skips decisions that would not be answered before the SCR server stops waiting.
+/// </summary>
+/// <remarks>
+/// A decision is allowed when the time spent in the tick plus the predicted decision cost fits the budget.
+/// The prediction is a decaying maximum of the measured decisions, it also decays on every skip so an outlier does not skip forever.
+/// Skipped decisions first hold the previous control, then ask for a fallback control once held for too long.
+/// </remarks>
+class Deadline_Watchdog
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Deadline_Watchdog local constants and variables.                      *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Prediction decay, every sample or skip removes 1 / COST_DECAY of the predicted cost.
+    /// </summary>
+    constexpr static unsigned long long const COST_DECAY = 32;
+    /// <summary>
+    /// Watchdog flag, when not set every decision is allowed and nothing is counted.
+    /// </summary>
+    bool const enabled;
+    /// <summary>
+    /// Tick budget, in [ns].
+    /// </summary>
+    unsigned long long const budget;
+    /// <summary>
+    /// Consecutive skipped decisions holding the previous control before a fallback is due.
+    /// </summary>
+    size_t const held_ticks;
+    /// <summary>
+    /// Predicted decision cost, in [ns].
+    /// </summary>
+    unsigned long long decision_cost;
+    /// <summary>
+    /// Consecutive skipped decisions.
+    /// </summary>
+    size_t skipped;
+    /// <summary>
+    /// Tick start.
+    /// </summary>
+    std::chrono::steady_clock::time_point tick_start;
+    /// <summary>
+    /// Decision start.
+    /// </summary>
+    std::chrono::steady_clock::time_point decision_start;
+    /// <summary>
+    /// Ticks of the current genome and of the race.
+    /// </summary>
+    size_t ticks, total_ticks;
+    /// <summary>
+    /// Ticks over budget of the current genome and of the race.
+    /// </summary>
+    size_t missed, total_missed;
+    /// <summary>
+    /// Ticks holding the previous control of the current genome and of the race.
+    /// </summary>
+    size_t held, total_held;
+    /// <summary>
+    /// Ticks with a fallback control of the current genome and of the race.
+    /// </summary>
+    size_t fallbacks, total_fallbacks;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Deadline_Watchdog interface.                                          *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Generates a watchdog without predictions.
+    /// </summary>
+    /// <param name="enabled">Whenever should ticks be watched.</param>
+    /// <param name="budget">Tick budget, in [s].</param>
+    /// <param name="held_ticks">Consecutive skipped decisions holding the previous control.</param>
+    Deadline_Watchdog( bool const & enabled, float const & budget, size_t const & held_ticks );
+
+    /// <summary>
+    /// Starts watching a tick.
+    /// </summary>
+    void startTick();
+
+    /// <summary>
+    /// Checks if a decision still fits the tick budget, counting it as held or fallback if not.
+    /// </summary>
+    /// <returns>Whenever the decision should be taken.</returns>
+    bool const allowDecision();
+
+    /// <summary>
+    /// Checks if the skipped decision needs a fallback control, rather than holding the previous one.
+    /// </summary>
+    /// <returns>Whenever a fallback control is due.</returns>
+    bool const fallbackDue() const;
+
+    /// <summary>
+    /// Starts timing a decision.
+    /// </summary>
+    void startDecision();
+
+    /// <summary>
+    /// Finishes timing a decision, updating the prediction.
+    /// </summary>
+    void finishDecision();
+
+    /// <summary>
+    /// Finishes watching a tick, counting it as missed if over budget.
+    /// </summary>
+    void finishTick();
+
+    /// <summary>
+    /// Prints the genome deadline counters and adds them to the race ones.
+    /// </summary>
+    void finishGenome();
+
+    /// <summary>
+    /// Prints the race deadline counters.
+    /// </summary>
+    void finishRace() const;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Deadline_Watchdog utilities.                                          *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Prints deadline counters in a line.
+    /// </summary>
+    /// <param name="title">Line title.</param>
+    /// <param name="ticks">Watched ticks.</param>
+    /// <param name="missed">Ticks over budget.</param>
+    /// <param name="held">Ticks holding the previous control.</param>
+    /// <param name="fallbacks">Ticks with a fallback control.</param>
+    void print( std::string const & title, size_t const & ticks, size_t const & missed, size_t const & held, size_t const & fallbacks ) const;
+};
+
+#endif
@@ -0,0 +1,297 @@
+/***************************************************************************
+
+    file                 : Latency_Profiler.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Latency_Profiler.hpp"
+
+#if defined (AXEL_LATENCY_PROFILER)
+
+#include <cmath>
+#include <sstream>
+#include "Telemetry_Sink.hpp"
+#if defined (_MSC_VER) && defined (_M_X64)
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Stage names, in stage order.
+/// </summary>
+static char const * const STAGE_NAMES[ Latency_Profiler::STAGES ] = { "appraise", "restart_check", "convert_inputs", "evaluate", "convert_outputs", "tick" };
+
+/// <summary>
+/// Retrieves the highest set bit index of a value, 63 minus its leading zero bits.
+/// </summary>
+/// <param name="value">Value, not 0.</param>
+/// <returns>Highest set bit index.</returns>
+static int highestBit( unsigned long long const value )
+{
+#if defined (_MSC_VER) && defined (_M_X64)
+    unsigned long index = 0;
+    _BitScanReverse64( &index, value );
+    return static_cast<int>( index );
+#elif defined (__GNUC__)
+    return 63 - __builtin_clzll( value );
+#else
+    int index = 63;
+    while ( ( ( value >> index ) & 1ULL ) == 0 ) index--;
+    return index;
+#endif
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Latency_Profiler interface.                                           *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Generates an empty profiler.
+/// </summary>
+/// <param name="enabled">Whenever should ticks be profiled.</param>
+/// <param name="file_name">Prometheus text file, empty for none.</param>
+Latency_Profiler::Latency_Profiler( bool const & enabled, std::string const & file_name )
+    : enabled( enabled ), file_name( file_name ), genome_latencies(), generation_latencies(), generation( 0 ), tick_latencies( {} ), lapped( {} ),
+    tick_start(), last_lap() {}
+
+/// <summary>
+/// Starts timing a tick.
+/// </summary>
+void Latency_Profiler::startTick()
+{
+    if ( !this->enabled ) return;
+    this->tick_latencies.fill( 0 );
+    this->lapped.fill( false );
+    this->tick_start = std::chrono::steady_clock::now();
+    this->last_lap = this->tick_start;
+}
+
+/// <summary>
+/// Adds the time since the previous lap to a stage.
+/// </summary>
+/// <param name="stage">Stage index.</param>
+void Latency_Profiler::lap( size_t const & stage )
+{
+    if ( !this->enabled ) return;
+    std::chrono::steady_clock::time_point const now = std::chrono::steady_clock::now();
+    this->tick_latencies[ stage ] += static_cast<unsigned long long>( std::chrono::duration_cast<std::chrono::nanoseconds>( now - this->last_lap ).count() );
+    this->lapped[ stage ] = true;
+    this->last_lap = now;
+}
+
+/// <summary>
+/// Records the lapped stages and the whole tick in the genome histograms.
+/// </summary>
+void Latency_Profiler::finishTick()
+{
+    if ( !this->enabled ) return;
+    this->tick_latencies[ TICK ] = static_cast<unsigned long long>( std::chrono::duration_cast<std::chrono::nanoseconds>( this->last_lap - this->tick_start ).count() );
+    this->lapped[ TICK ] = true;
+    for ( size_t stage = 0; stage < STAGES; stage++ )
+    {
+        if ( this->lapped[ stage ] ) this->genome_latencies[ stage ].record( this->tick_latencies[ stage ] );
+    }
+}
+
+/// <summary>
+/// Prints and writes the genome latencies, adding them to its generation, a new generation finishes the previous one first.
+/// </summary>
+/// <param name="generation">Genome generation.</param>
+void Latency_Profiler::finishGenome( size_t const & generation )
+{
+    if ( !this->enabled ) return;
+    if ( generation != this->generation )
+    {
+        finishGeneration();
+        this->generation = generation;
+    }
+    print( "Genome latency", this->genome_latencies );
+    for ( size_t stage = 0; stage < STAGES; stage++ ) this->generation_latencies[ stage ].merge( this->genome_latencies[ stage ] );
+    write();
+    for ( Histogram & histogram : this->genome_latencies ) histogram.reset();
+}
+
+/// <summary>
+/// Prints and writes the generation latencies and clears them.
+/// </summary>
+void Latency_Profiler::finishGeneration()
+{
+    if ( !this->enabled || this->generation_latencies[ TICK ].count() == 0 ) return;
+    print( "Generation " + std::to_string( this->generation ) + " latency", this->generation_latencies );
+    write();
+    for ( Histogram & histogram : this->generation_latencies ) histogram.reset();
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Latency_Profiler utilities.                                           *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Prints the p50, p99, p99.9 and maximum of every stage in a line, in [us].
+/// </summary>
+/// <param name="title">Line title.</param>
+/// <param name="latencies">Stage histograms.</param>
+void Latency_Profiler::print( std::string const & title, std::array<Histogram, STAGES> const & latencies ) const
+{
+    if ( latencies[ TICK ].count() == 0 ) return;
+    std::ostringstream line = std::ostringstream();
+    line.setf( std::ios::fixed );
+    line.precision( 1 );
+    line << title << " [us] p50/p99/p99.9/max";
+    for ( size_t stage = 0; stage < STAGES; stage++ )
+    {
+        Histogram const & histogram = latencies[ stage ];
+        line
+            << " " << STAGE_NAMES[ stage ] << "="
+            << static_cast<double>( histogram.percentile( 0.5 ) ) / 1000.0 << "/"
+            << static_cast<double>( histogram.percentile( 0.99 ) ) / 1000.0 << "/"
+            << static_cast<double>( histogram.percentile( 0.999 ) ) / 1000.0 << "/"
+            << static_cast<double>( histogram.max() ) / 1000.0;
+    }
+    Telemetry_Sink::getInstance().print( line.str() );
+}
+
+/// <summary>
+/// Replaces the Prometheus text file with the genome and generation latencies.
+/// </summary>
+/// <remarks>
+/// Replaced by the sink thread through a temporary file, a scraper never reads a partial file.
+/// </remarks>
+void Latency_Profiler::write() const
+{
+    if ( this->file_name.empty() ) return;
+    std::ostringstream file = std::ostringstream();
+    double const quantiles[] = { 0.5, 0.99, 0.999 };
+    file << "# HELP axel_tick_latency_seconds Driving pipeline stage latency per tick.\n";
+    file << "# TYPE axel_tick_latency_seconds summary\n";
+    auto write_scope = [ & ]( std::string const & scope, std::array<Histogram, STAGES> const & latencies )
+    {
+        for ( size_t stage = 0; stage < STAGES; stage++ )
+        {
+            Histogram const & histogram = latencies[ stage ];
+            std::string const labels = "scope=\"" + scope + "\",generation=\"" + std::to_string( this->generation ) + "\",stage=\"" + STAGE_NAMES[ stage ] + "\"";
+            for ( double const & quantile : quantiles )
+            {
+                file << "axel_tick_latency_seconds{" << labels << ",quantile=\"" << quantile << "\"} " << static_cast<double>( histogram.percentile( quantile ) ) * 1e-9 << "\n";
+            }
+            file << "axel_tick_latency_seconds{" << labels << ",quantile=\"1\"} " << static_cast<double>( histogram.max() ) * 1e-9 << "\n";
+            file << "axel_tick_latency_seconds_count{" << labels << "} " << histogram.count() << "\n";
+        }
+    };
+    write_scope( "genome", this->genome_latencies );
+    write_scope( "generation", this->generation_latencies );
+    Telemetry_Sink::getInstance().replace( this->file_name, file.str() );
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Histogram class.                                                      *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Generates an empty histogram.
+/// </summary>
+Latency_Profiler::Histogram::Histogram() : counts( {} ), total( 0 ), maximum( 0 ) {}
+
+/// <summary>
+/// Records a value.
+/// </summary>
+/// <param name="value">Value, in [ns].</param>
+void Latency_Profiler::Histogram::record( unsigned long long const & value )
+{
+    this->counts[ bucket( value ) ]++;
+    this->total++;
+    if ( value > this->maximum ) this->maximum = value;
+}
+
+/// <summary>
+/// Adds every value of another histogram.
+/// </summary>
+/// <param name="histogram">Histogram to add.</param>
+void Latency_Profiler::Histogram::merge( Histogram const & histogram )
+{
+    if ( histogram.total == 0 ) return;
+    for ( size_t index = 0; index < BUCKETS; index++ ) this->counts[ index ] += histogram.counts[ index ];
+    this->total += histogram.total;
+    if ( histogram.maximum > this->maximum ) this->maximum = histogram.maximum;
+}
+
+/// <summary>
+/// Removes every value.
+/// </summary>
+void Latency_Profiler::Histogram::reset()
+{
+    if ( this->total == 0 ) return;
+    this->counts.fill( 0 );
+    this->total = 0;
+    this->maximum = 0;
+}
+
+/// <summary>
+/// Retrieves the number of recorded values.
+/// </summary>
+/// <returns>Recorded values.</returns>
+unsigned long long const Latency_Profiler::Histogram::count() const { return this->total; }
+
+/// <summary>
+/// Retrieves the highest recorded value.
+/// </summary>
+/// <returns>Highest value, in [ns].</returns>
+unsigned long long const Latency_Profiler::Histogram::max() const { return this->maximum; }
+
+/// <summary>
+/// Retrieves the value at or below which a fraction of the recorded values lie, as the highest value of its bucket.
+/// </summary>
+/// <param name="fraction">Fraction, in [0, 1].</param>
+/// <returns>Percentile value, in [ns], 0 if empty.</returns>
+unsigned long long const Latency_Profiler::Histogram::percentile( double const & fraction ) const
+{
+    if ( this->total == 0 ) return 0;
+    // rank of the value, at least the first
+    unsigned long long rank = static_cast<unsigned long long>( std::ceil( fraction * static_cast<double>( this->total ) ) );
+    rank = rank < 1 ? 1 : rank;
+    unsigned long long seen = 0;
+    for ( size_t index = 0; index < BUCKETS; index++ )
+    {
+        seen += this->counts[ index ];
+        if ( seen >= rank )
+        {
+            unsigned long long const value = highestValue( index );
+            return value < this->maximum ? value : this->maximum;
+        }
+    }
+    return this->maximum;
+}
+
+/// <summary>
+/// Retrieves the bucket of a value.
+/// </summary>
+/// <remarks>
+/// Values under SUB_BUCKETS use their own bucket, larger ones are shifted till under SUB_BUCKETS, the shift picks the bucket range.
+/// </remarks>
+/// <param name="value">Value, in [ns].</param>
+/// <returns>Bucket index.</returns>
+size_t const Latency_Profiler::Histogram::bucket( unsigned long long const & value )
+{
+    if ( value < SUB_BUCKETS ) return static_cast<size_t>( value );
+    int const exponent = highestBit( value ) - ( SUB_BUCKET_BITS - 1 );
+    if ( exponent > MAX_EXPONENT ) return BUCKETS - 1;
+    return static_cast<size_t>( exponent ) * ( SUB_BUCKETS / 2 ) + static_cast<size_t>( value >> exponent );
+}
+
+/// <summary>
+/// Retrieves the highest value of a bucket.
+/// </summary>
+/// <param name="index">Bucket index.</param>
+/// <returns>Highest value, in [ns].</returns>
+unsigned long long const Latency_Profiler::Histogram::highestValue( size_t const & index )
+{
+    if ( index < SUB_BUCKETS ) return static_cast<unsigned long long>( index );
+    size_t const exponent = index / ( SUB_BUCKETS / 2 ) - 1;
+    unsigned long long const sub_bucket = static_cast<unsigned long long>( index - exponent * ( SUB_BUCKETS / 2 ) );
+    return ( ( sub_bucket + 1 ) << exponent ) - 1;
+}
+
+#endif
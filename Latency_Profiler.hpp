@@ -0,0 +1,268 @@
+/***************************************************************************
+
+    file                 : Latency_Profiler.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_LATENCY_PROFILER
+#define AXEL_LATENCY_PROFILER
+
+#include <array>
+#include <chrono>
+#include <string>
+
+/// <summary>
+/// Driving pipeline latency profiler, times every tick stage into histograms per genome and per generation.
+/// </summary>
+/// <remarks>
+/// A tick is timed by laps, every lap adds the time since the previous one to a stage, stages lapped more than once in a tick are summed.
+/// Summaries are printed when a genome or a generation finishes and written to a Prometheus text file, replaced atomically.
+/// Both go through the Telemetry_Sink thread, so a driving thread only formats them.
+/// </remarks>
+class Latency_Profiler
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Stages.                                                               *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Progress appraisal stage.
+    /// </summary>
+    constexpr static size_t const APPRAISE = 0;
+    /// <summary>
+    /// Restart check stage.
+    /// </summary>
+    constexpr static size_t const RESTART_CHECK = 1;
+    /// <summary>
+    /// Sensors parsing and input conversion stage.
+    /// </summary>
+    constexpr static size_t const CONVERT_INPUTS = 2;
+    /// <summary>
+    /// Network evaluation stage.
+    /// </summary>
+    constexpr static size_t const EVALUATE = 3;
+    /// <summary>
+    /// Output conversion and control message stage.
+    /// </summary>
+    constexpr static size_t const CONVERT_OUTPUTS = 4;
+    /// <summary>
+    /// Whole tick, from start to finish.
+    /// </summary>
+    constexpr static size_t const TICK = 5;
+    /// <summary>
+    /// Number of stages.
+    /// </summary>
+    constexpr static size_t const STAGES = 6;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Histogram class.                                                      *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// HDR style latency histogram, log-linear buckets with SUB_BUCKETS / 2 linear buckets per power of two.
+    /// </summary>
+    /// <remarks>
+    /// Values up to SUB_BUCKETS are exact, larger ones keep a relative error under 2 / SUB_BUCKETS.
+    /// </remarks>
+    class Histogram
+    {
+        public:
+        /// <summary>
+        /// Linear sub buckets of the first power of two range, a power of two.
+        /// </summary>
+        constexpr static unsigned long long const SUB_BUCKETS = 128;
+        /// <summary>
+        /// Bits of SUB_BUCKETS.
+        /// </summary>
+        constexpr static int const SUB_BUCKET_BITS = 7;
+        /// <summary>
+        /// Highest exponent, values over SUB_BUCKETS shifted by it are clamped, 2^40 [ns] is over 18 minutes.
+        /// </summary>
+        constexpr static int const MAX_EXPONENT = 40 - SUB_BUCKET_BITS;
+        /// <summary>
+        /// Number of buckets.
+        /// </summary>
+        constexpr static size_t const BUCKETS = ( MAX_EXPONENT + 2 ) * ( SUB_BUCKETS / 2 );
+
+        private:
+        /// <summary>
+        /// Recorded values per bucket.
+        /// </summary>
+        std::array<unsigned long long, BUCKETS> counts;
+        /// <summary>
+        /// Number of recorded values.
+        /// </summary>
+        unsigned long long total;
+        /// <summary>
+        /// Highest recorded value, exact.
+        /// </summary>
+        unsigned long long maximum;
+
+        public:
+        /// <summary>
+        /// Generates an empty histogram.
+        /// </summary>
+        Histogram();
+
+        /// <summary>
+        /// Records a value.
+        /// </summary>
+        /// <param name="value">Value, in [ns].</param>
+        void record( unsigned long long const & value );
+
+        /// <summary>
+        /// Adds every value of another histogram.
+        /// </summary>
+        /// <param name="histogram">Histogram to add.</param>
+        void merge( Histogram const & histogram );
+
+        /// <summary>
+        /// Removes every value.
+        /// </summary>
+        void reset();
+
+        /// <summary>
+        /// Retrieves the number of recorded values.
+        /// </summary>
+        /// <returns>Recorded values.</returns>
+        unsigned long long const count() const;
+
+        /// <summary>
+        /// Retrieves the highest recorded value.
+        /// </summary>
+        /// <returns>Highest value, in [ns].</returns>
+        unsigned long long const max() const;
+
+        /// <summary>
+        /// Retrieves the value at or below which a fraction of the recorded values lie, as the highest value of its bucket.
+        /// </summary>
+        /// <param name="fraction">Fraction, in [0, 1].</param>
+        /// <returns>Percentile value, in [ns], 0 if empty.</returns>
+        unsigned long long const percentile( double const & fraction ) const;
+
+        private:
+        /// <summary>
+        /// Retrieves the bucket of a value.
+        /// </summary>
+        /// <param name="value">Value, in [ns].</param>
+        /// <returns>Bucket index.</returns>
+        static size_t const bucket( unsigned long long const & value );
+
+        /// <summary>
+        /// Retrieves the highest value of a bucket.
+        /// </summary>
+        /// <param name="index">Bucket index.</param>
+        /// <returns>Highest value, in [ns].</returns>
+        static unsigned long long const highestValue( size_t const & index );
+    };
+
+    /***************************************************************************
+     *                                                                         *
+     *   Latency_Profiler local constants and variables.                       *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Profiling flag, when not set every call returns at once.
+    /// </summary>
+    bool const enabled;
+    /// <summary>
+    /// Prometheus text file, empty for none.
+    /// </summary>
+    std::string const file_name;
+    /// <summary>
+    /// Stage histograms of the current genome.
+    /// </summary>
+    std::array<Histogram, STAGES> genome_latencies;
+    /// <summary>
+    /// Stage histograms of the current generation.
+    /// </summary>
+    std::array<Histogram, STAGES> generation_latencies;
+    /// <summary>
+    /// Generation of the aggregated genomes.
+    /// </summary>
+    size_t generation;
+    /// <summary>
+    /// Stage times of the current tick, in [ns].
+    /// </summary>
+    std::array<unsigned long long, STAGES> tick_latencies;
+    /// <summary>
+    /// Stages lapped in the current tick.
+    /// </summary>
+    std::array<bool, STAGES> lapped;
+    /// <summary>
+    /// Tick start.
+    /// </summary>
+    std::chrono::steady_clock::time_point tick_start;
+    /// <summary>
+    /// Last lap.
+    /// </summary>
+    std::chrono::steady_clock::time_point last_lap;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Latency_Profiler interface.                                           *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Generates an empty profiler.
+    /// </summary>
+    /// <param name="enabled">Whenever should ticks be profiled.</param>
+    /// <param name="file_name">Prometheus text file, empty for none.</param>
+    Latency_Profiler( bool const & enabled, std::string const & file_name );
+
+    /// <summary>
+    /// Starts timing a tick.
+    /// </summary>
+    void startTick();
+
+    /// <summary>
+    /// Adds the time since the previous lap to a stage.
+    /// </summary>
+    /// <param name="stage">Stage index.</param>
+    void lap( size_t const & stage );
+
+    /// <summary>
+    /// Records the lapped stages and the whole tick in the genome histograms.
+    /// </summary>
+    void finishTick();
+
+    /// <summary>
+    /// Prints and writes the genome latencies, adding them to its generation, a new generation finishes the previous one first.
+    /// </summary>
+    /// <param name="generation">Genome generation.</param>
+    void finishGenome( size_t const & generation );
+
+    /// <summary>
+    /// Prints and writes the generation latencies and clears them.
+    /// </summary>
+    void finishGeneration();
+
+    /***************************************************************************
+     *                                                                         *
+     *   Latency_Profiler utilities.                                           *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Prints the p50, p99, p99.9 and maximum of every stage in a line, in [us].
+    /// </summary>
+    /// <param name="title">Line title.</param>
+    /// <param name="latencies">Stage histograms.</param>
+    void print( std::string const & title, std::array<Histogram, STAGES> const & latencies ) const;
+
+    /// <summary>
+    /// Replaces the Prometheus text file with the genome and generation latencies.
+    /// </summary>
+    void write() const;
+};
+
+#endif
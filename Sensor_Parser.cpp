@@ -0,0 +1,207 @@
+/***************************************************************************
+
+    file                 : Sensor_Parser.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Sensor_Parser.hpp"
+
+#if defined (AXEL_SENSOR_PARSER)
+
+#include <cmath>
+#include <cstring>
+
+/***************************************************************************
+ *                                                                         *
+ *   Race state.                                                           *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Generates a race state at the start line.
+/// </summary>
+Sensor_Parser::Race_State::Race_State()
+    : cur_lap_time( 0.0f ), last_lap_time( 0.0f ), damage( 0.0f ), dist_raced( 0.0f ), speed_x( 0.0f ), race_pos( 1 ) {}
+
+/// <summary>
+/// Generates a race state from a sensors state.
+/// </summary>
+/// <param name="car_state">Sensors state.</param>
+Sensor_Parser::Race_State::Race_State( CarState & car_state )
+    : cur_lap_time( car_state.getCurLapTime() ), last_lap_time( car_state.getLastLapTime() ), damage( car_state.getDamage() ),
+    dist_raced( car_state.getDistRaced() ), speed_x( car_state.getSpeedX() ), race_pos( car_state.getRacePos() ) {}
+
+/***************************************************************************
+ *                                                                         *
+ *   Sensor_Parser interface.                                              *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Parses a SCR sensors message, writing raw sensor values to their slots and the race sensors to the race state.
+/// </summary>
+/// <remarks>
+/// Unknown groups and the sensors the layout doesn't read are skipped, slots and race values missing from the message keep their previous values.
+/// </remarks>
+/// <param name="message">Sensors message, such as "(angle 0.01)(curLapTime 2.5)...".</param>
+/// <param name="length">Message length.</param>
+/// <param name="slots">Raw input slots.</param>
+/// <param name="race_state">Race state.</param>
+/// <returns>Number of parsed groups.</returns>
+size_t const Sensor_Parser::parse( char const * message, size_t const & length, Slots & slots, Race_State & race_state )
+{
+    char const * cursor = message;
+    char const * const end = message + length;
+    size_t groups = 0;
+    // single value scratch, for values converted or copied out of the slots
+    float value = 0.0f;
+
+    while ( cursor < end )
+    {
+        // group start
+        while ( cursor < end && *cursor != '(' ) cursor++;
+        if ( cursor == end ) break;
+        cursor++;
+        // tag
+        char const * const tag = cursor;
+        while ( cursor < end && *cursor != ' ' && *cursor != ')' ) cursor++;
+        size_t const tag_length = static_cast<size_t>( cursor - tag );
+        auto is = [ & ]( char const * const name, size_t const name_length ) { return tag_length == name_length && std::memcmp( tag, name, name_length ) == 0; };
+
+        // values, dispatched on tag length first so most tags are told apart by a single compare
+        switch ( tag_length )
+        {
+            case 1:
+                if ( is( "z", 1 ) ) { parseNumbers( cursor, end, &slots[ Z ], 1 ); groups++; }
+                break;
+            case 3:
+                if ( is( "rpm", 3 ) ) { parseNumbers( cursor, end, &value, 1 ); slots[ RPM ] = std::trunc( value ); groups++; }
+                break;
+            case 4:
+                if ( is( "fuel", 4 ) ) { parseNumbers( cursor, end, &slots[ FUEL ], 1 ); groups++; }
+                else if ( is( "gear", 4 ) ) { parseNumbers( cursor, end, &value, 1 ); slots[ GEAR ] = std::trunc( value ); groups++; }
+                break;
+            case 5:
+                if ( is( "angle", 5 ) ) { parseNumbers( cursor, end, &slots[ ANGLE ], 1 ); groups++; }
+                else if ( is( "track", 5 ) ) { parseNumbers( cursor, end, &slots[ TRACK ], TRACK_SLOTS ); groups++; }
+                else if ( FOCUS_SLOTS > 0 && is( "focus", 5 ) ) { parseNumbers( cursor, end, &slots[ FOCUS ], FOCUS_SLOTS ); groups++; }
+                break;
+            case 6:
+                if ( is( "damage", 6 ) )
+                {
+                    parseNumbers( cursor, end, &slots[ DAMAGE ], 1 );
+                    race_state.damage = slots[ DAMAGE ];
+                    groups++;
+                }
+                else if ( is( "speedX", 6 ) )
+                {
+                    parseNumbers( cursor, end, &slots[ SPEED ], 1 );
+                    race_state.speed_x = slots[ SPEED ];
+                    groups++;
+                }
+                else if ( is( "speedY", 6 ) ) { parseNumbers( cursor, end, &slots[ SPEED + 1 ], 1 ); groups++; }
+                else if ( is( "speedZ", 6 ) ) { parseNumbers( cursor, end, &slots[ SPEED + 2 ], 1 ); groups++; }
+                break;
+            case 7:
+                if ( is( "racePos", 7 ) ) { parseNumbers( cursor, end, &value, 1 ); race_state.race_pos = static_cast<int>( value ); groups++; }
+                break;
+            case 8:
+                if ( is( "trackPos", 8 ) ) { parseNumbers( cursor, end, &slots[ TRACK_POSITION ], 1 ); groups++; }
+                break;
+            case 9:
+                if ( is( "distRaced", 9 ) ) { parseNumbers( cursor, end, &race_state.dist_raced, 1 ); groups++; }
+                else if ( OPPONENTS_SLOTS > 0 && is( "opponents", 9 ) ) { parseNumbers( cursor, end, &slots[ OPPONENTS ], OPPONENTS_SLOTS ); groups++; }
+                break;
+            case 10:
+                if ( is( "curLapTime", 10 ) ) { parseNumbers( cursor, end, &race_state.cur_lap_time, 1 ); groups++; }
+                break;
+            case 11:
+                if ( is( "lastLapTime", 11 ) ) { parseNumbers( cursor, end, &race_state.last_lap_time, 1 ); groups++; }
+                break;
+            case 12:
+                if ( is( "wheelSpinVel", 12 ) ) { parseNumbers( cursor, end, &slots[ WHEEL_SPIN ], 4 ); groups++; }
+                break;
+            default:
+                break;
+        }
+        // group end, also skips unknown groups such as distFromStart
+        while ( cursor < end && *cursor != ')' ) cursor++;
+    }
+    return groups;
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Sensor_Parser utilities.                                              *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Parses up to count numbers, written from values onwards, stopping at the group end.
+/// </summary>
+/// <param name="cursor">Message position, left at the group end.</param>
+/// <param name="end">Message end.</param>
+/// <param name="values">Parsed values.</param>
+/// <param name="count">Maximum numbers to parse.</param>
+void Sensor_Parser::parseNumbers( char const * & cursor, char const * const end, float * const values, size_t const & count )
+{
+    for ( size_t index = 0; index < count; index++ )
+    {
+        while ( cursor < end && *cursor == ' ' ) cursor++;
+        if ( cursor == end || *cursor == ')' ) return;
+        values[ index ] = parseNumber( cursor, end );
+    }
+}
+
+/// <summary>
+/// Parses a decimal number, such as "-12.5" or "1.2e-05".
+/// </summary>
+/// <remarks>
+/// Digits are gathered in an integer and scaled once by an exact power of ten, matching strtof for the short numbers SCR sends.
+/// </remarks>
+/// <param name="cursor">Number start, left after the number.</param>
+/// <param name="end">Message end.</param>
+/// <returns>Parsed number.</returns>
+float const Sensor_Parser::parseNumber( char const * & cursor, char const * const end )
+{
+    // powers of ten exactly representable as double
+    constexpr static double const POWERS[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    constexpr static int const MAX_POWER = 22;
+
+    bool negative = false;
+    if ( cursor < end && ( *cursor == '-' || *cursor == '+' ) ) { negative = *cursor == '-'; cursor++; }
+    // mantissa, digits past 19 only shift the exponent
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    for ( ; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++ )
+    {
+        if ( digits < 19 ) { mantissa = mantissa * 10 + static_cast<unsigned long long>( *cursor - '0' ); if ( mantissa != 0 ) digits++; }
+        else exponent++;
+    }
+    if ( cursor < end && *cursor == '.' )
+    {
+        for ( cursor++; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++ )
+        {
+            if ( digits < 19 ) { mantissa = mantissa * 10 + static_cast<unsigned long long>( *cursor - '0' ); exponent--; if ( mantissa != 0 ) digits++; }
+        }
+    }
+    if ( cursor < end && ( *cursor == 'e' || *cursor == 'E' ) )
+    {
+        cursor++;
+        bool negative_exponent = false;
+        if ( cursor < end && ( *cursor == '-' || *cursor == '+' ) ) { negative_exponent = *cursor == '-'; cursor++; }
+        int written_exponent = 0;
+        for ( ; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++ )
+        { if ( written_exponent < 1000 ) written_exponent = written_exponent * 10 + ( *cursor - '0' ); }
+        exponent += negative_exponent ? -written_exponent : written_exponent;
+    }
+    // scale, out of table exponents are rare and take the slow path
+    double value = static_cast<double>( mantissa );
+    if ( exponent < 0 && exponent >= -MAX_POWER ) value /= POWERS[ -exponent ];
+    else if ( exponent > 0 && exponent <= MAX_POWER ) value *= POWERS[ exponent ];
+    else if ( exponent != 0 ) value *= std::pow( 10.0, exponent );
+    return static_cast<float>( negative ? -value : value );
+}
+
+#endif
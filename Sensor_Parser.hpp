@@ -0,0 +1,203 @@
+/***************************************************************************
+
+    file                 : Sensor_Parser.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_SENSOR_PARSER
+#define AXEL_SENSOR_PARSER
+
+#include <array>
+#include <cstddef>
+#include "CarState.h"
+#include "robot_axel/Settings.hpp"
+
+/// <summary>
+/// Fused SCR sensors message parser, scans the message once and writes raw sensor values straight into their AI input slots.
+/// </summary>
+/// <remarks>
+/// Replaces SimpleParser, CarState and the CarState getters in the racing loop, no strings are built and nothing is allocated.
+/// Slots hold raw values in the Axel input order, Axel normalises them in place, the reliability slots are left for it to fill.
+/// </remarks>
+class Sensor_Parser
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Input slots.                                                          *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Gear slot.
+    /// </summary>
+    constexpr static size_t const GEAR = 0;
+    /// <summary>
+    /// RPM slot.
+    /// </summary>
+    constexpr static size_t const RPM = 1;
+    /// <summary>
+    /// Angle slot.
+    /// </summary>
+    constexpr static size_t const ANGLE = 2;
+    /// <summary>
+    /// Fuel slot.
+    /// </summary>
+    constexpr static size_t const FUEL = 3;
+    /// <summary>
+    /// Speed slots, x, y and z.
+    /// </summary>
+    constexpr static size_t const SPEED = 4;
+    /// <summary>
+    /// Z slot.
+    /// </summary>
+    constexpr static size_t const Z = 7;
+    /// <summary>
+    /// Damage slot.
+    /// </summary>
+    constexpr static size_t const DAMAGE = 8;
+    /// <summary>
+    /// Track position slot.
+    /// </summary>
+    constexpr static size_t const TRACK_POSITION = 9;
+    /// <summary>
+    /// Wheel spin slots.
+    /// </summary>
+    constexpr static size_t const WHEEL_SPIN = 10;
+    /// <summary>
+    /// Focus slots, none if the layout doesn't read focus.
+    /// </summary>
+    constexpr static size_t const FOCUS = 14;
+    /// <summary>
+    /// Focus slots read.
+    /// </summary>
+    constexpr static size_t const FOCUS_SLOTS = RobotAxel::Settings::BUILD_LAYOUT.focus ? FOCUS_SENSORS_NUM : 0;
+    /// <summary>
+    /// Focus reliability slot, if the layout reads focus.
+    /// </summary>
+    constexpr static size_t const FOCUS_RELIABILITY = FOCUS + FOCUS_SLOTS;
+    /// <summary>
+    /// Track slots.
+    /// </summary>
+    constexpr static size_t const TRACK = FOCUS + RobotAxel::Settings::FOCUS_INPUTS;
+    /// <summary>
+    /// Track slots read, the first range finders of the message.
+    /// </summary>
+    constexpr static size_t const TRACK_SLOTS = RobotAxel::Settings::BUILD_LAYOUT.track;
+    /// <summary>
+    /// Track reliability slot.
+    /// </summary>
+    constexpr static size_t const TRACK_RELIABILITY = TRACK + TRACK_SLOTS;
+    /// <summary>
+    /// Opponents slots, none if the layout doesn't read opponents.
+    /// </summary>
+    constexpr static size_t const OPPONENTS = TRACK_RELIABILITY + 1;
+    /// <summary>
+    /// Opponents slots read.
+    /// </summary>
+    constexpr static size_t const OPPONENTS_SLOTS = RobotAxel::Settings::BUILD_LAYOUT.opponents ? OPPONENTS_SENSORS_NUM : 0;
+
+    static_assert( FOCUS == RobotAxel::Settings::BASIC_INPUTS, "Focus slots must follow the basic inputs." );
+    static_assert( TRACK_SLOTS >= 1 && TRACK_SLOTS <= TRACK_SENSORS_NUM, "Layout must read between one and every track range finder." );
+    static_assert( OPPONENTS + OPPONENTS_SLOTS == RobotAxel::Settings::INPUTS, "Sensor slots must cover every AI input." );
+
+    /// <summary>
+    /// AI input slots.
+    /// </summary>
+    typedef std::array<float, RobotAxel::Settings::INPUTS> Slots;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Race state.                                                           *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Sensors used to appraise the race and decide on restarts, which are not AI inputs or are needed raw.
+    /// </summary>
+    class Race_State
+    {
+        public:
+        /// <summary>
+        /// Current lap time, in [s].
+        /// </summary>
+        float cur_lap_time;
+        /// <summary>
+        /// Last lap time, in [s].
+        /// </summary>
+        float last_lap_time;
+        /// <summary>
+        /// Damage.
+        /// </summary>
+        float damage;
+        /// <summary>
+        /// Distance raced, in [m].
+        /// </summary>
+        float dist_raced;
+        /// <summary>
+        /// Longitudinal speed, in [Km/h].
+        /// </summary>
+        float speed_x;
+        /// <summary>
+        /// Race position.
+        /// </summary>
+        int race_pos;
+
+        /// <summary>
+        /// Generates a race state at the start line.
+        /// </summary>
+        Race_State();
+
+        /// <summary>
+        /// Generates a race state from a sensors state.
+        /// </summary>
+        /// <param name="car_state">Sensors state.</param>
+        Race_State( CarState & car_state );
+    };
+
+    /***************************************************************************
+     *                                                                         *
+     *   Sensor_Parser interface.                                              *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Parses a SCR sensors message, writing raw sensor values to their slots and the race sensors to the race state.
+    /// </summary>
+    /// <remarks>
+    /// Unknown groups are skipped, slots and race values missing from the message keep their previous values.
+    /// </remarks>
+    /// <param name="message">Sensors message, such as "(angle 0.01)(curLapTime 2.5)...".</param>
+    /// <param name="length">Message length.</param>
+    /// <param name="slots">Raw input slots.</param>
+    /// <param name="race_state">Race state.</param>
+    /// <returns>Number of parsed groups.</returns>
+    static size_t const parse( char const * message, size_t const & length, Slots & slots, Race_State & race_state );
+
+    /***************************************************************************
+     *                                                                         *
+     *   Sensor_Parser utilities.                                              *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Parses up to count numbers, written from values onwards, stopping at the group end.
+    /// </summary>
+    /// <param name="cursor">Message position, left at the group end.</param>
+    /// <param name="end">Message end.</param>
+    /// <param name="values">Parsed values.</param>
+    /// <param name="count">Maximum numbers to parse.</param>
+    static void parseNumbers( char const * & cursor, char const * const end, float * const values, size_t const & count );
+
+    /// <summary>
+    /// Parses a decimal number, such as "-12.5" or "1.2e-05".
+    /// </summary>
+    /// <param name="cursor">Number start, left after the number.</param>
+    /// <param name="end">Message end.</param>
+    /// <returns>Parsed number.</returns>
+    static float const parseNumber( char const * & cursor, char const * const end );
+};
+
+#endif
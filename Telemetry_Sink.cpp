@@ -0,0 +1,221 @@
+/***************************************************************************
+
+    file                 : Telemetry_Sink.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Telemetry_Sink.hpp"
+
+#if defined (AXEL_TELEMETRY_SINK)
+
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <sys/stat.h>
+
+/// <summary>
+/// Termination reason names, by reason.
+/// </summary>
+std::array<char const *, Telemetry_Sink::TERMINATIONS> const Telemetry_Sink::TERMINATION_NAMES = { "running", "laps", "damage", "timeout", "aborted", "horizon", "shutdown" };
+
+/***************************************************************************
+ *                                                                         *
+ *   Telemetry_Sink interface.                                             *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Retrieves the process sink, opening its file and starting its thread on first use.
+/// </summary>
+/// <returns>Telemetry sink.</returns>
+Telemetry_Sink & Telemetry_Sink::getInstance()
+{
+    // single sink instance, named after its creation time
+    static Telemetry_Sink sink( "telemetry/telemetry_" + std::to_string( std::time( nullptr ) ) + ".jsonl" );
+    return sink;
+}
+
+/// <summary>
+/// Writes the remaining queues and stops the sink thread.
+/// </summary>
+Telemetry_Sink::~Telemetry_Sink()
+{
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        this->stopping = true;
+    }
+    this->wake.notify_one();
+    if ( this->writer.joinable() ) this->writer.join();
+}
+
+/// <summary>
+/// Queues a record to be written, without waiting on the file.
+/// </summary>
+/// <param name="record">Evaluation record.</param>
+void Telemetry_Sink::push( Record const & record )
+{
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        this->pending.push_back( record );
+    }
+    this->wake.notify_one();
+}
+
+/// <summary>
+/// Queues a console line to be printed, without waiting on the console.
+/// </summary>
+/// <param name="line">Line, without its end.</param>
+void Telemetry_Sink::print( std::string const & line )
+{
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        this->lines.push_back( line );
+    }
+    this->wake.notify_one();
+}
+
+/// <summary>
+/// Queues the replacement of a file, written to a temporary file and renamed so a reader never sees a partial file.
+/// </summary>
+/// <param name="file_name">File to replace.</param>
+/// <param name="contents">New file contents.</param>
+void Telemetry_Sink::replace( std::string const & file_name, std::string const & contents )
+{
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        this->files.push_back( { file_name, contents } );
+    }
+    this->wake.notify_one();
+}
+
+/// <summary>
+/// Queues contents to be appended to a file, after the earlier queued appends.
+/// </summary>
+/// <param name="file_name">File to append to.</param>
+/// <param name="contents">Appended contents.</param>
+void Telemetry_Sink::append( std::string const & file_name, std::string const & contents )
+{
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        this->appends.push_back( { file_name, contents } );
+    }
+    this->wake.notify_one();
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Telemetry_Sink utilities.                                             *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Starts the sink thread.
+/// </summary>
+/// <param name="file_name">Telemetry file name.</param>
+Telemetry_Sink::Telemetry_Sink( std::string const & file_name )
+    : file_name( file_name ), file(), mutex(), wake(), pending( {} ), lines( {} ), files( {} ), appends( {} ), stopping( false ), writer()
+{
+    // a generation of records and a few genomes of lines queue without growing
+    this->pending.reserve( 1024 );
+    this->lines.reserve( 64 );
+    this->writer = std::thread( &Telemetry_Sink::run, this );
+}
+
+/// <summary>
+/// Sink thread loop, takes the queued records, lines, files and appends and writes them till stopped.
+/// </summary>
+void Telemetry_Sink::run()
+{
+    std::vector<Record> writing = {};
+    std::vector<std::string> printing = {};
+    std::vector<std::pair<std::string, std::string>> replacing = {};
+    std::vector<std::pair<std::string, std::string>> appending = {};
+    writing.reserve( this->pending.capacity() );
+    printing.reserve( this->lines.capacity() );
+    bool opened = false;
+    std::unique_lock<std::mutex> lock( this->mutex );
+    while ( true )
+    {
+        this->wake.wait( lock, [ this ] { return this->stopping || !this->pending.empty() || !this->lines.empty() || !this->files.empty() || !this->appends.empty(); } );
+        if ( this->pending.empty() && this->lines.empty() && this->files.empty() && this->appends.empty() && this->stopping ) break;
+        // swap queues, drivers keep queuing while the taken ones are written
+        writing.swap( this->pending );
+        printing.swap( this->lines );
+        replacing.swap( this->files );
+        appending.swap( this->appends );
+        lock.unlock();
+        // console flushed once per batch
+        for ( std::string const & line : printing ) std::cout << line << '\n';
+        if ( !printing.empty() ) std::cout.flush();
+        printing.clear();
+        for ( std::pair<std::string, std::string> const & replaced : replacing )
+        {
+            std::string const temporary_name = replaced.first + ".tmp";
+            std::ofstream replacement( temporary_name, std::ios::trunc );
+            if ( !replacement.is_open() ) continue;
+            replacement << replaced.second;
+            replacement.close();
+            std::rename( temporary_name.c_str(), replaced.first.c_str() );
+        }
+        replacing.clear();
+        for ( std::pair<std::string, std::string> const & appended : appending )
+        {
+            std::ofstream addition( appended.first, std::ios::app );
+            if ( addition.is_open() ) addition << appended.second;
+        }
+        appending.clear();
+        // telemetry file created by the first record
+        if ( !writing.empty() && !opened )
+        {
+            opened = true;
+            open();
+        }
+        if ( this->file.is_open() )
+        {
+            for ( Record const & record : writing ) write( record );
+            this->file.flush();
+        }
+        writing.clear();
+        lock.lock();
+    }
+}
+
+/// <summary>
+/// Creates the telemetry directory and opens the telemetry file.
+/// </summary>
+void Telemetry_Sink::open()
+{
+    mkdir( "telemetry/", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH );
+    this->file.open( this->file_name, std::ios::trunc );
+    if ( !this->file.is_open() ) std::cout << "Can't open telemetry " << this->file_name << std::endl;
+}
+
+/// <summary>
+/// Writes a record as a JSON line.
+/// </summary>
+/// <param name="record">Evaluation record.</param>
+void Telemetry_Sink::write( Record const & record )
+{
+    size_t const termination = record.termination < TERMINATIONS ? record.termination : RUNNING;
+    this->file
+        << "{\"generation\":" << record.generation
+        << ",\"species\":" << record.species
+        << ",\"hash\":\"" << std::hex << record.hash << std::dec << "\""
+        << ",\"genes\":" << record.genes
+        << ",\"neurons\":" << record.neurons
+        << ",\"fitness\":" << record.speed_term + record.distance_term + record.position_term
+        << ",\"speed_term\":" << record.speed_term
+        << ",\"distance_term\":" << record.distance_term
+        << ",\"position_term\":" << record.position_term
+        << ",\"ticks\":" << record.ticks
+        << ",\"time\":" << record.time
+        << ",\"distance\":" << record.distance
+        << ",\"termination\":\"" << TERMINATION_NAMES[ termination ] << "\""
+        << ",\"evaluations\":" << record.evaluations
+        << ",\"gated\":" << record.gated
+        << ",\"held\":" << record.held
+        << ",\"evaluate_mean_us\":" << ( record.evaluations == 0 ? 0.0 : static_cast<double>( record.evaluate_total ) / 1000.0 / static_cast<double>( record.evaluations ) )
+        << ",\"evaluate_max_us\":" << static_cast<double>( record.evaluate_max ) / 1000.0
+        << "}\n";
+}
+
+#endif
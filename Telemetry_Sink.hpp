@@ -0,0 +1,257 @@
+/***************************************************************************
+
+    file                 : Telemetry_Sink.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_TELEMETRY_SINK
+#define AXEL_TELEMETRY_SINK
+
+#include <array>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Evaluation telemetry sink, writes one JSON line per evaluated genome, the drivers console lines and their report files from a background thread.
+/// </summary>
+/// <remarks>
+/// Drivers only queue records, lines and file contents, formatting and writes happen in the sink thread, so a driving thread never waits on I/O.
+/// A single sink per process is shared by every car, every queue is written in push order and flushed when the process exits.
+/// The telemetry file is only created by the first record.
+/// </remarks>
+class Telemetry_Sink
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Telemetry record.                                                     *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Evaluation still running, or ended without a restart check.
+    /// </summary>
+    constexpr static size_t const RUNNING = 0;
+    /// <summary>
+    /// Evaluation ended after the maximum laps.
+    /// </summary>
+    constexpr static size_t const LAPS = 1;
+    /// <summary>
+    /// Evaluation ended after the maximum damage.
+    /// </summary>
+    constexpr static size_t const DAMAGE = 2;
+    /// <summary>
+    /// Evaluation ended for covering too little distance in time.
+    /// </summary>
+    constexpr static size_t const TIMEOUT = 3;
+    /// <summary>
+    /// Evaluation ended early, as it could no longer reach its species survival threshold.
+    /// </summary>
+    constexpr static size_t const ABORTED = 4;
+    /// <summary>
+    /// Evaluation ended at its successive halving horizon.
+    /// </summary>
+    constexpr static size_t const HORIZON = 5;
+    /// <summary>
+    /// Evaluation ended by the race shutdown.
+    /// </summary>
+    constexpr static size_t const SHUTDOWN = 6;
+    /// <summary>
+    /// Number of termination reasons.
+    /// </summary>
+    constexpr static size_t const TERMINATIONS = 7;
+
+    /// <summary>
+    /// Evaluation of a genome.
+    /// </summary>
+    struct Record
+    {
+        /// <summary>
+        /// Genome generation.
+        /// </summary>
+        size_t generation;
+        /// <summary>
+        /// Genome species index.
+        /// </summary>
+        size_t species;
+        /// <summary>
+        /// Genome structural hash.
+        /// </summary>
+        unsigned long long hash;
+        /// <summary>
+        /// Genome genes.
+        /// </summary>
+        size_t genes;
+        /// <summary>
+        /// Genome neurons.
+        /// </summary>
+        size_t neurons;
+        /// <summary>
+        /// Average speed fitness term.
+        /// </summary>
+        float speed_term;
+        /// <summary>
+        /// Distance raced fitness term.
+        /// </summary>
+        float distance_term;
+        /// <summary>
+        /// Race position fitness term.
+        /// </summary>
+        float position_term;
+        /// <summary>
+        /// Evaluation ticks.
+        /// </summary>
+        size_t ticks;
+        /// <summary>
+        /// Evaluation time, in [s].
+        /// </summary>
+        float time;
+        /// <summary>
+        /// Distance raced, in [m].
+        /// </summary>
+        float distance;
+        /// <summary>
+        /// Termination reason.
+        /// </summary>
+        size_t termination;
+        /// <summary>
+        /// Network evaluations, ticks reusing the previous outputs for unchanged inputs and ticks between decisions.
+        /// </summary>
+        size_t evaluations, gated, held;
+        /// <summary>
+        /// Total and longest network evaluation time, in [ns].
+        /// </summary>
+        unsigned long long evaluate_total, evaluate_max;
+    };
+
+    /***************************************************************************
+     *                                                                         *
+     *   Telemetry_Sink local constants and variables.                         *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Termination reason names, by reason.
+    /// </summary>
+    static std::array<char const *, TERMINATIONS> const TERMINATION_NAMES;
+    /// <summary>
+    /// Telemetry file name.
+    /// </summary>
+    std::string const file_name;
+    /// <summary>
+    /// Telemetry file, one JSON record per line.
+    /// </summary>
+    std::ofstream file;
+    /// <summary>
+    /// Queue lock.
+    /// </summary>
+    std::mutex mutex;
+    /// <summary>
+    /// Wakes the sink thread on new records, lines, files or appends, or stop.
+    /// </summary>
+    std::condition_variable wake;
+    /// <summary>
+    /// Records queued by the drivers.
+    /// </summary>
+    std::vector<Record> pending;
+    /// <summary>
+    /// Console lines queued by the drivers.
+    /// </summary>
+    std::vector<std::string> lines;
+    /// <summary>
+    /// File replacements queued by the drivers, as file name and contents.
+    /// </summary>
+    std::vector<std::pair<std::string, std::string>> files;
+    /// <summary>
+    /// File appends queued by the drivers, as file name and contents.
+    /// </summary>
+    std::vector<std::pair<std::string, std::string>> appends;
+    /// <summary>
+    /// Whenever the sink thread should write the remaining queues and stop.
+    /// </summary>
+    bool stopping;
+    /// <summary>
+    /// Sink thread.
+    /// </summary>
+    std::thread writer;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Telemetry_Sink interface.                                             *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Retrieves the process sink, opening its file and starting its thread on first use.
+    /// </summary>
+    /// <returns>Telemetry sink.</returns>
+    static Telemetry_Sink & getInstance();
+
+    /// <summary>
+    /// Writes the remaining queues and stops the sink thread.
+    /// </summary>
+    ~Telemetry_Sink();
+
+    /// <summary>
+    /// Queues a record to be written, without waiting on the file.
+    /// </summary>
+    /// <param name="record">Evaluation record.</param>
+    void push( Record const & record );
+
+    /// <summary>
+    /// Queues a console line to be printed, without waiting on the console.
+    /// </summary>
+    /// <param name="line">Line, without its end.</param>
+    void print( std::string const & line );
+
+    /// <summary>
+    /// Queues the replacement of a file, written to a temporary file and renamed so a reader never sees a partial file.
+    /// </summary>
+    /// <param name="file_name">File to replace.</param>
+    /// <param name="contents">New file contents.</param>
+    void replace( std::string const & file_name, std::string const & contents );
+
+    /// <summary>
+    /// Queues contents to be appended to a file, after the earlier queued appends.
+    /// </summary>
+    /// <param name="file_name">File to append to.</param>
+    /// <param name="contents">Appended contents.</param>
+    void append( std::string const & file_name, std::string const & contents );
+
+    /***************************************************************************
+     *                                                                         *
+     *   Telemetry_Sink utilities.                                             *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Starts the sink thread.
+    /// </summary>
+    /// <param name="file_name">Telemetry file name.</param>
+    Telemetry_Sink( std::string const & file_name );
+
+    /// <summary>
+    /// Sink thread loop, takes the queued records, lines, files and appends and writes them till stopped.
+    /// </summary>
+    void run();
+
+    /// <summary>
+    /// Creates the telemetry directory and opens the telemetry file.
+    /// </summary>
+    void open();
+
+    /// <summary>
+    /// Writes a record as a JSON line.
+    /// </summary>
+    /// <param name="record">Evaluation record.</param>
+    void write( Record const & record );
+};
+
+#endif
@@ -0,0 +1,132 @@
+/***************************************************************************
+
+    file                 : Trace_Reader.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Trace_Reader.hpp"
+
+#if defined (AXEL_TRACE_READER)
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/***************************************************************************
+ *                                                                         *
+ *   Trace_Reader interface.                                               *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Maps a trace, checking its header.
+/// </summary>
+/// <param name="file_name">Trace file name.</param>
+Trace_Reader::Trace_Reader( std::string const & file_name ) : mapping( nullptr ), bytes( 0 ), records( 0 ), position( 0 ), current( {} )
+{
+    int descriptor = open( file_name.c_str(), O_RDONLY );
+    if ( descriptor < 0 )
+    {
+        std::cout << "Can't open trace " << file_name << std::endl;
+        return;
+    }
+    struct stat status = {};
+    size_t const header_bytes = Trace_Recorder::HEADER_WORDS * sizeof( unsigned int );
+    if ( fstat( descriptor, &status ) != 0 || static_cast<size_t>( status.st_size ) < header_bytes )
+    {
+        close( descriptor );
+        return;
+    }
+    this->bytes = static_cast<size_t>( status.st_size );
+    void * memory = mmap( nullptr, this->bytes, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+    close( descriptor );
+    if ( memory == MAP_FAILED ) return;
+    this->mapping = static_cast<unsigned char const *>( memory );
+    // header must match this build
+    unsigned int header[ Trace_Recorder::HEADER_WORDS ] = {};
+    std::memcpy( header, this->mapping, header_bytes );
+    if ( header[ 0 ] != Trace_Recorder::MAGIC || header[ 1 ] != Trace_Recorder::VERSION || header[ 2 ] != Trace_Recorder::RECORD_WORDS || header[ 3 ] != Trace_Recorder::KEYFRAME_INTERVAL )
+    {
+        std::cout << "Trace " << file_name << " has an unknown format" << std::endl;
+        munmap( const_cast<unsigned char *>( this->mapping ), this->bytes );
+        this->mapping = nullptr;
+        return;
+    }
+    this->records = ( this->bytes - header_bytes ) / sizeof( Trace_Recorder::Record );
+    // sequential reads
+    madvise( const_cast<unsigned char *>( this->mapping ), this->bytes, MADV_SEQUENTIAL );
+}
+
+/// <summary>
+/// Unmaps the trace.
+/// </summary>
+Trace_Reader::~Trace_Reader()
+{
+    if ( this->mapping != nullptr ) munmap( const_cast<unsigned char *>( this->mapping ), this->bytes );
+}
+
+/// <summary>
+/// Checks if the trace was mapped.
+/// </summary>
+/// <returns>Whenever the trace is readable.</returns>
+bool const Trace_Reader::isOpen() const { return this->mapping != nullptr; }
+
+/// <summary>
+/// Retrieves the number of records, an interrupted recording ends at its last complete record.
+/// </summary>
+/// <returns>Number of records.</returns>
+size_t const Trace_Reader::size() const { return this->records; }
+
+/// <summary>
+/// Decodes the next record.
+/// </summary>
+/// <param name="car_state">Recorded sensors state.</param>
+/// <param name="car_control">Recorded control.</param>
+/// <returns>Whenever a record was left.</returns>
+bool const Trace_Reader::next( CarState & car_state, CarControl & car_control )
+{
+    if ( this->position >= this->records ) return false;
+    apply( this->position );
+    this->position++;
+    Trace_Recorder::decode( this->current, car_state, car_control );
+    return true;
+}
+
+/// <summary>
+/// Moves to a record, decoding from its keyframe, the next read returns it.
+/// </summary>
+/// <param name="index">Record index.</param>
+void Trace_Reader::seek( size_t const & index )
+{
+    this->position = std::min( index, this->records );
+    if ( this->position % Trace_Recorder::KEYFRAME_INTERVAL == 0 ) return;
+    // previous records since keyframe
+    for ( size_t record = this->position - this->position % Trace_Recorder::KEYFRAME_INTERVAL; record < this->position; record++ ) apply( record );
+}
+
+/***************************************************************************
+ *                                                                         *
+ *   Trace_Reader utilities.                                               *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Applies a stored record to the last decoded one, raw if a keyframe.
+/// </summary>
+/// <param name="index">Record index.</param>
+void Trace_Reader::apply( size_t const & index )
+{
+    Trace_Recorder::Record stored = {};
+    std::memcpy( stored.data(), this->mapping + Trace_Recorder::HEADER_WORDS * sizeof( unsigned int ) + index * sizeof( Trace_Recorder::Record ), sizeof( Trace_Recorder::Record ) );
+    if ( index % Trace_Recorder::KEYFRAME_INTERVAL == 0 )
+    {
+        this->current = stored;
+        return;
+    }
+    for ( size_t word = 0; word < Trace_Recorder::RECORD_WORDS; word++ ) this->current[ word ] ^= stored[ word ];
+}
+
+#endif
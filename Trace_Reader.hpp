@@ -0,0 +1,112 @@
+/***************************************************************************
+
+    file                 : Trace_Reader.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_TRACE_READER
+#define AXEL_TRACE_READER
+
+#include <string>
+#include "CarState.h"
+#include "CarControl.h"
+#include "Trace_Recorder.hpp"
+
+/// <summary>
+/// Driver trace reader, memory maps a trace written by Trace_Recorder and decodes its records sequentially or from any position.
+/// </summary>
+class Trace_Reader
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Trace_Reader local constants and variables.                           *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Mapped trace, null if not open.
+    /// </summary>
+    unsigned char const * mapping;
+    /// <summary>
+    /// Mapped bytes.
+    /// </summary>
+    size_t bytes;
+    /// <summary>
+    /// Number of complete records.
+    /// </summary>
+    size_t records;
+    /// <summary>
+    /// Next record to read sequentially.
+    /// </summary>
+    size_t position;
+    /// <summary>
+    /// Last decoded record, raw.
+    /// </summary>
+    Trace_Recorder::Record current;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Trace_Reader interface.                                               *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Maps a trace, checking its header.
+    /// </summary>
+    /// <param name="file_name">Trace file name.</param>
+    Trace_Reader( std::string const & file_name );
+
+    /// <summary>
+    /// Unmaps the trace.
+    /// </summary>
+    ~Trace_Reader();
+
+    /// <summary>
+    /// Readers own their mapping and can't be copied.
+    /// </summary>
+    Trace_Reader( Trace_Reader const & other ) = delete;
+    Trace_Reader & operator= ( Trace_Reader const & other ) = delete;
+
+    /// <summary>
+    /// Checks if the trace was mapped.
+    /// </summary>
+    /// <returns>Whenever the trace is readable.</returns>
+    bool const isOpen() const;
+
+    /// <summary>
+    /// Retrieves the number of records, an interrupted recording ends at its last complete record.
+    /// </summary>
+    /// <returns>Number of records.</returns>
+    size_t const size() const;
+
+    /// <summary>
+    /// Decodes the next record.
+    /// </summary>
+    /// <param name="car_state">Recorded sensors state.</param>
+    /// <param name="car_control">Recorded control.</param>
+    /// <returns>Whenever a record was left.</returns>
+    bool const next( CarState & car_state, CarControl & car_control );
+
+    /// <summary>
+    /// Moves to a record, decoding from its keyframe, the next read returns it.
+    /// </summary>
+    /// <param name="index">Record index.</param>
+    void seek( size_t const & index );
+
+    /***************************************************************************
+     *                                                                         *
+     *   Trace_Reader utilities.                                               *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Applies a stored record to the last decoded one, raw if a keyframe.
+    /// </summary>
+    /// <param name="index">Record index.</param>
+    void apply( size_t const & index );
+};
+
+#endif
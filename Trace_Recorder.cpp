@@ -0,0 +1,151 @@
+/***************************************************************************
+
+    file                 : Trace_Recorder.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Trace_Recorder.hpp"
+
+#if defined (AXEL_TRACE_RECORDER)
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+/***************************************************************************
+ *                                                                         *
+ *   Trace_Recorder interface.                                             *
+ *                                                                         *
+ ***************************************************************************/
+/// <summary>
+/// Creates the trace file and writes its header.
+/// </summary>
+/// <param name="file_name">Trace file name.</param>
+Trace_Recorder::Trace_Recorder( std::string const & file_name )
+    : file( file_name, std::ios::binary | std::ios::trunc ), previous( {} ), records( 0 )
+{
+    if ( !this->file.is_open() )
+    {
+        std::cout << "Can't record trace " << file_name << std::endl;
+        return;
+    }
+    unsigned int const header[ HEADER_WORDS ] = { MAGIC, VERSION, static_cast<unsigned int>( RECORD_WORDS ), static_cast<unsigned int>( KEYFRAME_INTERVAL ) };
+    this->file.write( reinterpret_cast<char const *>( header ), sizeof( header ) );
+    std::cout << "Recording trace " << file_name << std::endl;
+}
+
+/// <summary>
+/// Flushes and closes the trace.
+/// </summary>
+Trace_Recorder::~Trace_Recorder()
+{
+    if ( this->file.is_open() ) this->file.close();
+}
+
+/// <summary>
+/// Appends a sensors state and its control to the trace.
+/// </summary>
+/// <param name="car_state">Sensors state.</param>
+/// <param name="car_control">Produced control.</param>
+void Trace_Recorder::record( CarState & car_state, CarControl & car_control )
+{
+    if ( !this->file.is_open() ) return;
+    Record current = {};
+    encode( car_state, car_control, current );
+    // keyframes are raw, others only keep changed bits
+    Record written = current;
+    if ( this->records % KEYFRAME_INTERVAL != 0 )
+    {
+        for ( size_t word = 0; word < RECORD_WORDS; word++ ) written[ word ] ^= this->previous[ word ];
+    }
+    this->file.write( reinterpret_cast<char const *>( written.data() ), sizeof( Record ) );
+    this->previous = current;
+    this->records++;
+}
+
+/// <summary>
+/// Converts a sensors state and its control to a raw record.
+/// </summary>
+/// <param name="car_state">Sensors state.</param>
+/// <param name="car_control">Produced control.</param>
+/// <param name="record">Raw record.</param>
+void Trace_Recorder::encode( CarState & car_state, CarControl & car_control, Record & record )
+{
+    size_t index = 0;
+    auto put_float = [ & ]( float const value ) { std::memcpy( &record[ index++ ], &value, sizeof( float ) ); };
+    auto put_int = [ & ]( int const value ) { std::memcpy( &record[ index++ ], &value, sizeof( int ) ); };
+    // sensors, in CarState order
+    put_float( car_state.getAngle() );
+    put_float( car_state.getCurLapTime() );
+    put_float( car_state.getDamage() );
+    put_float( car_state.getDistFromStart() );
+    put_float( car_state.getDistRaced() );
+    for ( int i = 0; i < FOCUS_SENSORS_NUM; i++ ) put_float( car_state.getFocus( i ) );
+    put_float( car_state.getFuel() );
+    put_int( car_state.getGear() );
+    put_float( car_state.getLastLapTime() );
+    for ( int i = 0; i < OPPONENTS_SENSORS_NUM; i++ ) put_float( car_state.getOpponents( i ) );
+    put_int( car_state.getRacePos() );
+    put_int( car_state.getRpm() );
+    put_float( car_state.getSpeedX() );
+    put_float( car_state.getSpeedY() );
+    put_float( car_state.getSpeedZ() );
+    for ( int i = 0; i < TRACK_SENSORS_NUM; i++ ) put_float( car_state.getTrack( i ) );
+    put_float( car_state.getTrackPos() );
+    for ( int i = 0; i < 4; i++ ) put_float( car_state.getWheelSpinVel( i ) );
+    put_float( car_state.getZ() );
+    // control
+    put_float( car_control.getAccel() );
+    put_float( car_control.getBrake() );
+    put_float( car_control.getClutch() );
+    put_float( car_control.getSteer() );
+    put_int( car_control.getGear() );
+    put_int( car_control.getFocus() );
+    put_int( car_control.getMeta() );
+    assert( index == RECORD_WORDS );
+}
+
+/// <summary>
+/// Converts a raw record to a sensors state and its control.
+/// </summary>
+/// <param name="record">Raw record.</param>
+/// <param name="car_state">Sensors state.</param>
+/// <param name="car_control">Produced control.</param>
+void Trace_Recorder::decode( Record const & record, CarState & car_state, CarControl & car_control )
+{
+    size_t index = 0;
+    auto get_float = [ & ]() { float value = 0.0f; std::memcpy( &value, &record[ index++ ], sizeof( float ) ); return value; };
+    auto get_int = [ & ]() { int value = 0; std::memcpy( &value, &record[ index++ ], sizeof( int ) ); return value; };
+    // sensors, in CarState order
+    car_state.setAngle( get_float() );
+    car_state.setCurLapTime( get_float() );
+    car_state.setDamage( get_float() );
+    car_state.setDistFromStart( get_float() );
+    car_state.setDistRaced( get_float() );
+    for ( int i = 0; i < FOCUS_SENSORS_NUM; i++ ) car_state.setFocus( i, get_float() );
+    car_state.setFuel( get_float() );
+    car_state.setGear( get_int() );
+    car_state.setLastLapTime( get_float() );
+    for ( int i = 0; i < OPPONENTS_SENSORS_NUM; i++ ) car_state.setOpponents( i, get_float() );
+    car_state.setRacePos( get_int() );
+    car_state.setRpm( get_int() );
+    car_state.setSpeedX( get_float() );
+    car_state.setSpeedY( get_float() );
+    car_state.setSpeedZ( get_float() );
+    for ( int i = 0; i < TRACK_SENSORS_NUM; i++ ) car_state.setTrack( i, get_float() );
+    car_state.setTrackPos( get_float() );
+    for ( int i = 0; i < 4; i++ ) car_state.setWheelSpinVel( i, get_float() );
+    car_state.setZ( get_float() );
+    // control
+    car_control.setAccel( get_float() );
+    car_control.setBrake( get_float() );
+    car_control.setClutch( get_float() );
+    car_control.setSteer( get_float() );
+    car_control.setGear( get_int() );
+    car_control.setFocus( get_int() );
+    car_control.setMeta( get_int() );
+    assert( index == RECORD_WORDS );
+}
+
+#endif
@@ -0,0 +1,130 @@
+/***************************************************************************
+
+    file                 : Trace_Recorder.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef AXEL_TRACE_RECORDER
+#define AXEL_TRACE_RECORDER
+
+#include <array>
+#include <fstream>
+#include <string>
+#include "CarState.h"
+#include "CarControl.h"
+
+/// <summary>
+/// Driver trace recorder, writes every sensors state and produced control to a compact binary trace.
+/// </summary>
+/// <remarks>
+/// A trace is a header followed by fixed width records of 32 bit words, one per sensor or control value.
+/// Every Trace_Recorder::KEYFRAME_INTERVAL records one is written raw, the others as the XOR with the previous record, so unchanged bits are 0.
+/// Records stay fixed width, traces can be memory mapped and read from any keyframe.
+/// </remarks>
+class Trace_Recorder
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Trace format.                                                         *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Trace file identifier, "AXTR".
+    /// </summary>
+    constexpr static unsigned int const MAGIC = 0x52545841u;
+    /// <summary>
+    /// Trace format version.
+    /// </summary>
+    constexpr static unsigned int const VERSION = 1;
+    /// <summary>
+    /// Sensor words, angle, lap time, damage, distance from start, distance raced, focus, fuel, gear, last lap time, opponents,
+    /// position, rpm, speed ( x, y, z ), track, track position, wheel spin and z.
+    /// </summary>
+    constexpr static size_t const SENSOR_WORDS = 5 + FOCUS_SENSORS_NUM + 3 + OPPONENTS_SENSORS_NUM + 5 + TRACK_SENSORS_NUM + 1 + 4 + 1;
+    /// <summary>
+    /// Control words, accel, brake, clutch, steer, gear, focus and meta.
+    /// </summary>
+    constexpr static size_t const CONTROL_WORDS = 7;
+    /// <summary>
+    /// Record words.
+    /// </summary>
+    constexpr static size_t const RECORD_WORDS = SENSOR_WORDS + CONTROL_WORDS;
+    /// <summary>
+    /// Records between raw records.
+    /// </summary>
+    constexpr static size_t const KEYFRAME_INTERVAL = 256;
+    /// <summary>
+    /// Header words, magic, version, record words and keyframe interval.
+    /// </summary>
+    constexpr static size_t const HEADER_WORDS = 4;
+
+    /// <summary>
+    /// Raw sensors and control values.
+    /// </summary>
+    typedef std::array<unsigned int, RECORD_WORDS> Record;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Trace_Recorder local constants and variables.                         *
+     *                                                                         *
+     ***************************************************************************/
+    private:
+    /// <summary>
+    /// Trace file.
+    /// </summary>
+    std::ofstream file;
+    /// <summary>
+    /// Last written record, raw.
+    /// </summary>
+    Record previous;
+    /// <summary>
+    /// Number of written records.
+    /// </summary>
+    size_t records;
+
+    /***************************************************************************
+     *                                                                         *
+     *   Trace_Recorder interface.                                             *
+     *                                                                         *
+     ***************************************************************************/
+    public:
+    /// <summary>
+    /// Creates the trace file and writes its header.
+    /// </summary>
+    /// <param name="file_name">Trace file name.</param>
+    Trace_Recorder( std::string const & file_name );
+
+    /// <summary>
+    /// Flushes and closes the trace.
+    /// </summary>
+    ~Trace_Recorder();
+
+    /// <summary>
+    /// Appends a sensors state and its control to the trace.
+    /// </summary>
+    /// <param name="car_state">Sensors state.</param>
+    /// <param name="car_control">Produced control.</param>
+    void record( CarState & car_state, CarControl & car_control );
+
+    /// <summary>
+    /// Converts a sensors state and its control to a raw record.
+    /// </summary>
+    /// <param name="car_state">Sensors state.</param>
+    /// <param name="car_control">Produced control.</param>
+    /// <param name="record">Raw record.</param>
+    static void encode( CarState & car_state, CarControl & car_control, Record & record );
+
+    /// <summary>
+    /// Converts a raw record to a sensors state and its control.
+    /// </summary>
+    /// <param name="record">Raw record.</param>
+    /// <param name="car_state">Sensors state.</param>
+    /// <param name="car_control">Produced control.</param>
+    static void decode( Record const & record, CarState & car_state, CarControl & car_control );
+};
+
+#endif
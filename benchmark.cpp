@@ -0,0 +1,793 @@
+/***************************************************************************
+
+    file                 : benchmark.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <malloc.h>
+#include <unistd.h>
+#include "robot_axel/Genome.hpp"
+#include "robot_axel/Gym.hpp"
+#include "robot_axel/Phenotype.hpp"
+#include "robot_axel/Random_Generator.hpp"
+#include "robot_axel/Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Evolution engine benchmark, times the Genome hot operations on synthetic genomes of growing size and whole Gym generations on growing populations.
+    /// </summary>
+    /// <remarks>
+    /// Operations run on copies of the measured genome, refreshed untimed after every batch, so mutations always start from the same network.
+    /// Gyms are trained with a synthetic fitness, how close the outputs get to fixed targets for fixed inputs, so no simulator is needed.
+    /// Checks compare the outputs of random mutated genomes with the ones of their faster forms, so they fail instead of timing.
+    /// </remarks>
+    class Benchmark
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Benchmark local constants and variables.                              *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Timing of one operation on one genome size.
+        /// </summary>
+        struct Result
+        {
+            /// <summary>
+            /// Operation name.
+            /// </summary>
+            std::string name;
+            /// <summary>
+            /// Genome neurons.
+            /// </summary>
+            size_t neurons;
+            /// <summary>
+            /// Genome genes.
+            /// </summary>
+            size_t genes;
+            /// <summary>
+            /// Timed operations.
+            /// </summary>
+            size_t iterations;
+            /// <summary>
+            /// Median batch time per operation, in [ns].
+            /// </summary>
+            double median;
+            /// <summary>
+            /// Fastest batch time per operation, in [ns].
+            /// </summary>
+            double minimum;
+        };
+
+        /// <summary>
+        /// Timing of the generations of one population.
+        /// </summary>
+        struct Gym_Result
+        {
+            /// <summary>
+            /// Target population.
+            /// </summary>
+            size_t population;
+            /// <summary>
+            /// Trained generations.
+            /// </summary>
+            size_t generations;
+            /// <summary>
+            /// Training time, in [s].
+            /// </summary>
+            double seconds;
+            /// <summary>
+            /// Time spent in every generation advance phase, in [s].
+            /// </summary>
+            std::array<double, Gym::GENERATION_PHASES> phases;
+            /// <summary>
+            /// Peak resident memory while training, in [kB].
+            /// </summary>
+            size_t peak_memory;
+            /// <summary>
+            /// Species after the last generation.
+            /// </summary>
+            size_t species;
+            /// <summary>
+            /// Most species after any generation.
+            /// </summary>
+            size_t maximum_species;
+        };
+
+        /// <summary>
+        /// Outcome of one check on random genomes.
+        /// </summary>
+        struct Check_Result
+        {
+            /// <summary>
+            /// Check name.
+            /// </summary>
+            std::string name;
+            /// <summary>
+            /// Checked genomes.
+            /// </summary>
+            size_t genomes;
+            /// <summary>
+            /// Genomes whose outputs differ more than the tolerance.
+            /// </summary>
+            size_t mismatches;
+            /// <summary>
+            /// Largest output difference of any genome.
+            /// </summary>
+            double difference;
+        };
+
+        /// <summary>
+        /// Generation advance phase names, by phase.
+        /// </summary>
+        static std::array<char const *, Gym::GENERATION_PHASES> const PHASE_NAMES;
+
+        private:
+        /// <summary>
+        /// Operations per timed batch.
+        /// </summary>
+        constexpr static size_t const BATCH = 64;
+        /// <summary>
+        /// Minimum timed batches per operation.
+        /// </summary>
+        constexpr static size_t const MINIMUM_BATCHES = 5;
+        /// <summary>
+        /// Mutations from a genome to its compared relative, as a close species member.
+        /// </summary>
+        constexpr static size_t const RELATIVE_MUTATIONS = 10;
+        /// <summary>
+        /// Link mutation attempts per added node of synthetic genomes.
+        /// </summary>
+        constexpr static size_t const LINKS_PER_NODE = 2;
+        /// <summary>
+        /// Input samples evaluated by the synthetic fitness.
+        /// </summary>
+        constexpr static size_t const FITNESS_SAMPLES = 4;
+        /// <summary>
+        /// Most mutations from the initial full link to a checked genome.
+        /// </summary>
+        constexpr static size_t const CHECK_MUTATIONS = 60;
+        /// <summary>
+        /// Evaluations of every checked genome, with a few inputs changed every time.
+        /// </summary>
+        constexpr static size_t const CHECK_STEPS = 8;
+        /// <summary>
+        /// Largest output difference of a checked genome, the compiled sums are added in another order.
+        /// </summary>
+        constexpr static double const CHECK_TOLERANCE = 1e-4;
+        /// <summary>
+        /// Timed seconds per operation.
+        /// </summary>
+        double const seconds;
+        /// <summary>
+        /// Random seed, of the synthetic genomes and inputs.
+        /// </summary>
+        unsigned int const seed;
+        /// <summary>
+        /// Timings of every operation run so far.
+        /// </summary>
+        std::vector<Result> results;
+        /// <summary>
+        /// Timings of every population trained so far.
+        /// </summary>
+        std::vector<Gym_Result> gym_results;
+        /// <summary>
+        /// Outcomes of every check run so far.
+        /// </summary>
+        std::vector<Check_Result> check_results;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Benchmark interface.                                                  *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates a benchmark without results.
+        /// </summary>
+        /// <param name="seconds">Timed seconds per operation.</param>
+        /// <param name="seed">Random seed, of the synthetic genomes and inputs.</param>
+        Benchmark( double const & seconds, unsigned int const & seed ) : seconds( seconds ), seed( seed ), results( {} ), gym_results( {} ), check_results( {} ) {}
+
+        /// <summary>
+        /// Retrieves the timings of every operation run so far.
+        /// </summary>
+        /// <returns>Operation timings.</returns>
+        std::vector<Result> const & getResults() const { return this->results; }
+
+        /// <summary>
+        /// Retrieves the timings of every population trained so far.
+        /// </summary>
+        /// <returns>Population timings.</returns>
+        std::vector<Gym_Result> const & getGymResults() const { return this->gym_results; }
+
+        /// <summary>
+        /// Retrieves the outcomes of every check run so far.
+        /// </summary>
+        /// <returns>Check outcomes.</returns>
+        std::vector<Check_Result> const & getCheckResults() const { return this->check_results; }
+
+        /// <summary>
+        /// Times every genome operation on a synthetic genome with the given neurons.
+        /// </summary>
+        /// <param name="neurons">Genome neurons, the initial full link for INPUTS + OUTPUTS.</param>
+        void runGenome( size_t const & neurons )
+        {
+            // batches of previous operations drew a varying amount of numbers, reseed so every run has the same genomes
+            Random_Generator & rng = Random_Generator::getInstance();
+            rng.seed( this->seed + static_cast<unsigned int>( neurons ) );
+            Genome const genome = synthetic( neurons );
+            // close relative, for comparisons and crossovers
+            Genome relative = genome;
+            for ( size_t mutation = 0; mutation < RELATIVE_MUTATIONS; mutation++ ) relative.mutate();
+            // species represented by the genome
+            Gym::Species species = Gym::Species();
+            species.genomes.push_back( genome );
+            // fixed random inputs
+            std::array<float, Settings::INPUTS> inputs = {};
+            for ( float & input : inputs ) input = rng.generateRandom();
+            std::array<float, Settings::OUTPUTS> outputs = {};
+            float disjoint = 0.0f, weights = 0.0f;
+            bool from_species = false;
+
+            measure( "evaluate", genome, [ & ]( Genome & copy ) { copy.evaluate( outputs, inputs ); } );
+            measure( "compare", genome, [ & ]( Genome & copy ) { copy.compare( relative, disjoint, weights ); } );
+            measure( "crossover", genome, [ & ]( Genome & copy ) { copy = copy.crossover( relative ); } );
+            measure( "mutate", genome, []( Genome & copy ) { copy.mutate(); } );
+            measure( "mutateWeight", genome, []( Genome & copy ) { copy.mutateWeight(); } );
+            measure( "mutateState", genome, []( Genome & copy ) { copy.mutateState(); } );
+            measure( "mutateLink", genome, []( Genome & copy ) { copy.mutateLink(); } );
+            measure( "mutateNode", genome, []( Genome & copy ) { copy.mutateNode(); } );
+            measure( "fromSpecies", genome, [ & ]( Genome & ) { from_species = species.fromSpecies( relative ); } );
+            // keep results alive
+            if ( outputs[ 0 ] < 0.0f && disjoint < 0.0f && weights < 0.0f && from_species ) std::cout << std::endl;
+        }
+
+        /// <summary>
+        /// Trains a gym of the given population with the synthetic fitness, evaluating, appraising and advancing genomes as the training driver.
+        /// </summary>
+        /// <remarks>
+        /// Every gym trains in its own temporary directory, so it neither reads nor overwrites saved genomes and fitness caches.
+        /// Training stops after the given generations, or after the generation exceeding the time limit.
+        /// </remarks>
+        /// <param name="population">Target population.</param>
+        /// <param name="generations">Generations to train.</param>
+        /// <param name="limit">Training time limit, in [s].</param>
+        void runGym( size_t const & population, size_t const & generations, double const & limit )
+        {
+            Random_Generator & rng = Random_Generator::getInstance();
+            rng.seed( this->seed + static_cast<unsigned int>( population ) );
+            // fixed inputs and output targets
+            std::array<std::array<float, Settings::INPUTS>, FITNESS_SAMPLES> inputs = {};
+            std::array<std::array<float, Settings::OUTPUTS>, FITNESS_SAMPLES> targets = {};
+            for ( size_t sample = 0; sample < FITNESS_SAMPLES; sample++ )
+            {
+                for ( float & input : inputs[ sample ] ) input = rng.generateRandom();
+                for ( float & target : targets[ sample ] ) target = rng.generateRandom() * Settings::SIGMOID_RANGE + Settings::SIGMOID_OFFSET;
+            }
+            std::filesystem::path const root = std::filesystem::current_path();
+            std::filesystem::path const directory = enterTemporaryDirectory();
+            if ( directory.empty() ) return;
+            resetPeakMemory();
+
+            Gym_Result result = { population, 0, 0.0, {}, 0, 0, 0 };
+            {
+                Gym gym( population );
+                auto const start = std::chrono::steady_clock::now();
+                std::array<float, Settings::OUTPUTS> outputs = {};
+                size_t first_generation = 0, generation = 0, species = 0, top_genes = 0, top_neurons = 0;
+                float fitness = 0.0f, top_fitness = 0.0f;
+                gym.getInformation( first_generation, species, fitness, top_fitness, top_genes, top_neurons );
+                generation = first_generation;
+                while ( result.generations < generations && result.seconds < limit )
+                {
+                    // synthetic fitness, positive as the species breed counts need
+                    fitness = 1.0f;
+                    for ( size_t sample = 0; sample < FITNESS_SAMPLES; sample++ )
+                    {
+                        gym.evaluateCurrent( outputs, inputs[ sample ] );
+                        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
+                        {
+                            fitness += Settings::SIGMOID_RANGE - std::abs( outputs[ index ] - targets[ sample ][ index ] );
+                        }
+                    }
+                    gym.appraiseCurrent( fitness );
+                    gym.advanceInTrain();
+                    gym.getInformation( generation, species, fitness, top_fitness, top_genes, top_neurons );
+                    if ( generation == first_generation + result.generations ) continue;
+                    result.generations = generation - first_generation;
+                    result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+                    result.maximum_species = std::max( result.maximum_species, species );
+                }
+                result.phases = gym.generation_phases;
+                result.species = species;
+            }
+            result.peak_memory = peakMemory();
+            std::filesystem::current_path( root );
+            std::filesystem::remove_all( directory );
+            this->gym_results.push_back( result );
+        }
+
+        /// <summary>
+        /// Checks the compiled networks of random genomes, plain and specialized, against the Genome evaluation, starting with a handcrafted genome.
+        /// </summary>
+        /// <remarks>
+        /// Specialized phenotypes hold a random half of the inputs constant, the Genome is evaluated with the same constant values.
+        /// The handcrafted genome has a neuron linked to itself and from a higher neuron that only depends on a constant input, a link that must still read 0.
+        /// </remarks>
+        /// <param name="genomes">Random genomes, mutated from the initial full link.</param>
+        void checkPhenotypes( size_t const & genomes )
+        {
+            Random_Generator & rng = Random_Generator::getInstance();
+            rng.seed( this->seed );
+            Check_Result plain = { "phenotype", 0, 0, 0.0 };
+            Check_Result specialized = { "specialized", 0, 0, 0.0 };
+            for ( size_t index = 0; index <= genomes; index++ )
+            {
+                Genome const genome = index == 0 ? selfLinked() : mutated();
+                // the handcrafted genome holds its second input constant
+                std::array<bool, Settings::INPUTS> constant = {};
+                std::array<float, Settings::INPUTS> inputs = {};
+                for ( size_t input = 0; input < Settings::INPUTS; input++ )
+                {
+                    constant[ input ] = index == 0 ? input == 1 : rng.generateRandom() < 0.5f;
+                    inputs[ input ] = rng.generateRandom();
+                }
+                Phenotype phenotype = Phenotype();
+                phenotype.build( genome );
+                Phenotype specialized_phenotype = Phenotype();
+                specialized_phenotype.specialize( constant, inputs );
+                specialized_phenotype.build( genome );
+                double plain_difference = 0.0, specialized_difference = 0.0;
+                for ( size_t step = 0; step < CHECK_STEPS; step++ )
+                {
+                    // a few inputs change every step, as sensors do, so incremental passes are checked too
+                    for ( size_t input = 0; input < Settings::INPUTS; input++ )
+                    {
+                        if ( step > 0 && !constant[ input ] && rng.generateRandom() < 0.25f ) inputs[ input ] = rng.generateRandom();
+                    }
+                    std::array<float, Settings::OUTPUTS> expected = {};
+                    std::array<float, Settings::OUTPUTS> outputs = {};
+                    genome.evaluate( expected, inputs );
+                    phenotype.evaluate( outputs, inputs );
+                    plain_difference = std::max( plain_difference, largestDifference( expected, outputs ) );
+                    specialized_phenotype.evaluate( outputs, inputs );
+                    specialized_difference = std::max( specialized_difference, largestDifference( expected, outputs ) );
+                }
+                tally( plain, plain_difference );
+                tally( specialized, specialized_difference );
+            }
+            this->check_results.push_back( plain );
+            this->check_results.push_back( specialized );
+        }
+
+        /// <summary>
+        /// Checks that compacting random genomes, with and without history, keeps the outputs of every evaluation unchanged.
+        /// </summary>
+        /// <param name="genomes">Random genomes, mutated from the initial full link.</param>
+        void checkCompaction( size_t const & genomes )
+        {
+            Random_Generator & rng = Random_Generator::getInstance();
+            rng.seed( this->seed );
+            Check_Result compacted = { "compact", 0, 0, 0.0 };
+            Check_Result history = { "compact_history", 0, 0, 0.0 };
+            for ( size_t index = 0; index < genomes; index++ )
+            {
+                Genome const genome = mutated();
+                Genome compacted_genome = genome;
+                Genome history_genome = genome;
+                size_t removed_genes = 0, removed_neurons = 0;
+                compacted_genome.compact( false, removed_genes, removed_neurons );
+                history_genome.compact( true, removed_genes, removed_neurons );
+                std::array<float, Settings::INPUTS> inputs = {};
+                double compacted_difference = 0.0, history_difference = 0.0;
+                for ( size_t step = 0; step < CHECK_STEPS; step++ )
+                {
+                    for ( float & input : inputs ) input = rng.generateRandom();
+                    std::array<float, Settings::OUTPUTS> expected = {};
+                    std::array<float, Settings::OUTPUTS> outputs = {};
+                    genome.evaluate( expected, inputs );
+                    compacted_genome.evaluate( outputs, inputs );
+                    compacted_difference = std::max( compacted_difference, largestDifference( expected, outputs ) );
+                    history_genome.evaluate( outputs, inputs );
+                    history_difference = std::max( history_difference, largestDifference( expected, outputs ) );
+                }
+                tally( compacted, compacted_difference );
+                tally( history, history_difference );
+            }
+            this->check_results.push_back( compacted );
+            this->check_results.push_back( history );
+        }
+
+        /***************************************************************************
+         *                                                                         *
+         *   Benchmark utilities.                                                  *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Generates a genome with the given neurons, growing the initial full link with node and link mutations.
+        /// </summary>
+        /// <param name="neurons">Genome neurons, at least INPUTS + OUTPUTS.</param>
+        /// <returns>Synthetic genome.</returns>
+        static Genome synthetic( size_t const & neurons )
+        {
+            Genome genome = Genome();
+            genome.total_neurons = Settings::INPUTS + Settings::OUTPUTS;
+            for ( size_t output_index = Settings::INPUTS; output_index < genome.total_neurons; output_index++ )
+            {
+                for ( size_t input_index = 0; input_index < Settings::INPUTS; input_index++ )
+                {
+                    genome.network.push_back( Genome::Gene( input_index, output_index, true ) );
+                }
+            }
+            // node mutations of disabled genes do nothing, retry till grown
+            while ( genome.total_neurons < neurons )
+            {
+                size_t const previous_neurons = genome.total_neurons;
+                genome.mutateNode();
+                if ( genome.total_neurons == previous_neurons ) continue;
+                for ( size_t link = 0; link < LINKS_PER_NODE; link++ ) genome.mutateLink();
+            }
+            return genome;
+        }
+
+        /// <summary>
+        /// Generates a genome mutated a random number of times, up to CHECK_MUTATIONS, from the initial full link.
+        /// </summary>
+        /// <returns>Random genome.</returns>
+        static Genome mutated()
+        {
+            Genome genome = synthetic( Settings::INPUTS + Settings::OUTPUTS );
+            size_t const mutations = static_cast<size_t>( Random_Generator::getInstance().generateRandom() * static_cast<float>( CHECK_MUTATIONS ) );
+            for ( size_t mutation = 0; mutation < mutations; mutation++ ) genome.mutate();
+            return genome;
+        }
+
+        /// <summary>
+        /// Generates a genome with a hidden neuron linked to itself, to a variable input and from a higher hidden neuron only linked from a constant input.
+        /// </summary>
+        /// <remarks>
+        /// The Genome evaluates the higher neuron after the lower one, so its link reads 0 whatever the constant input.
+        /// </remarks>
+        /// <returns>Handcrafted genome, its first hidden neuron drives every output.</returns>
+        static Genome selfLinked()
+        {
+            size_t const lower = Settings::INPUTS;
+            size_t const higher = Settings::INPUTS + 1;
+            Genome genome = Genome();
+            genome.total_neurons = Settings::INPUTS + 2 + Settings::OUTPUTS;
+            // links with fixed weights, in network order
+            auto link = [ & ]( size_t const from, size_t const to, float const weight )
+            {
+                genome.network.push_back( Genome::Gene( from, to, true ) );
+                genome.network.back().weight = weight;
+            };
+            link( 0, lower, 1.0f );
+            link( lower, lower, 0.5f );
+            link( higher, lower, 5.0f );
+            link( 1, higher, 2.0f );
+            for ( size_t output = higher + 1; output < genome.total_neurons; output++ ) link( lower, output, 1.0f );
+            return genome;
+        }
+
+        /// <summary>
+        /// Measures how far apart two evaluations of the same genome are.
+        /// </summary>
+        /// <param name="expected">Outputs of the Genome evaluation.</param>
+        /// <param name="outputs">Outputs to check.</param>
+        /// <returns>Largest output difference.</returns>
+        static double largestDifference( std::array<float, Settings::OUTPUTS> const & expected, std::array<float, Settings::OUTPUTS> const & outputs )
+        {
+            double difference = 0.0;
+            for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
+            {
+                difference = std::max( difference, static_cast<double>( std::abs( expected[ index ] - outputs[ index ] ) ) );
+            }
+            return difference;
+        }
+
+        /// <summary>
+        /// Adds a checked genome to a check outcome.
+        /// </summary>
+        /// <param name="result">Check outcome.</param>
+        /// <param name="difference">Largest output difference of the genome.</param>
+        static void tally( Check_Result & result, double const & difference )
+        {
+            result.genomes++;
+            result.mismatches += difference > CHECK_TOLERANCE ? 1 : 0;
+            result.difference = std::max( result.difference, difference );
+        }
+
+        /// <summary>
+        /// Creates a temporary directory with an empty genomes directory inside and makes it the working directory.
+        /// </summary>
+        /// <returns>Temporary directory, empty if it couldn't be created.</returns>
+        static std::filesystem::path enterTemporaryDirectory()
+        {
+            std::string pattern = ( std::filesystem::temp_directory_path() / "axel_benchmark_XXXXXX" ).string();
+            if ( mkdtemp( &pattern[ 0 ] ) == nullptr )
+            {
+                std::cout << "Can't create a temporary directory" << std::endl;
+                return std::filesystem::path();
+            }
+            std::filesystem::path const directory = pattern;
+            std::filesystem::create_directory( directory / "genomes" );
+            std::filesystem::current_path( directory );
+            return directory;
+        }
+
+        /// <summary>
+        /// Returns freed memory to the system and restarts the peak resident memory from the current one.
+        /// </summary>
+        static void resetPeakMemory()
+        {
+            malloc_trim( 0 );
+            std::ofstream clear_refs( "/proc/self/clear_refs" );
+            if ( clear_refs.is_open() ) clear_refs << "5";
+        }
+
+        /// <summary>
+        /// Reads the peak resident memory since the last reset.
+        /// </summary>
+        /// <returns>Peak resident memory, in [kB], 0 if unknown.</returns>
+        static size_t peakMemory()
+        {
+            std::ifstream status( "/proc/self/status" );
+            std::string line;
+            while ( std::getline( status, line ) )
+            {
+                if ( line.compare( 0, 6, "VmHWM:" ) == 0 ) return static_cast<size_t>( std::stoul( line.substr( 6 ) ) );
+            }
+            return 0;
+        }
+
+        /// <summary>
+        /// Times an operation on copies of a genome, in batches till the timed seconds are reached.
+        /// </summary>
+        /// <param name="name">Operation name.</param>
+        /// <param name="genome">Genome copied before every batch.</param>
+        /// <param name="operation">Operation on a genome copy.</param>
+        template <typename Operation>
+        void measure( std::string const & name, Genome const & genome, Operation operation )
+        {
+            std::vector<Genome> copies( BATCH, genome );
+            std::vector<double> samples = {};
+            double timed = 0.0;
+            // warm up caches and branch predictors
+            for ( Genome & copy : copies ) operation( copy );
+            while ( samples.size() < MINIMUM_BATCHES || timed < this->seconds )
+            {
+                std::fill( copies.begin(), copies.end(), genome );
+                auto const start = std::chrono::steady_clock::now();
+                for ( Genome & copy : copies ) operation( copy );
+                double const batch = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+                timed += batch;
+                samples.push_back( batch * 1e9 / static_cast<double>( BATCH ) );
+            }
+            std::sort( samples.begin(), samples.end() );
+            this->results.push_back( { name, genome.total_neurons, genome.network.size(), samples.size() * BATCH, samples[ samples.size() / 2 ], samples.front() } );
+        }
+    };
+
+    /// <summary>
+    /// Generation advance phase names, by phase.
+    /// </summary>
+    std::array<char const *, Gym::GENERATION_PHASES> const Benchmark::PHASE_NAMES = { "cull", "removal", "breeding", "speciation", "serialization" };
+}
+
+/// <summary>
+/// Reads the times of a previous benchmark output, by result name and genome neurons or gym population.
+/// </summary>
+/// <param name="file_name">Previous benchmark output.</param>
+/// <returns>Median operation and mean generation times, empty if the file can't be read.</returns>
+std::map<std::pair<std::string, size_t>, double> readBaseline( std::string const & file_name )
+{
+    std::map<std::pair<std::string, size_t>, double> baseline = {};
+    std::ifstream file( file_name );
+    if ( !file.is_open() )
+    {
+        std::cout << "Can't open baseline " << file_name << std::endl;
+        return baseline;
+    }
+    // value of a field in a result line, written one result per line
+    auto field = []( std::string const & line, std::string const & key )
+    {
+        size_t start = line.find( "\"" + key + "\":" );
+        if ( start == std::string::npos ) return std::string();
+        start = line.find_first_not_of( " \"", start + key.size() + 3 );
+        size_t const end = line.find_first_of( ",\"}", start );
+        return line.substr( start, end - start );
+    };
+    std::string line;
+    while ( std::getline( file, line ) )
+    {
+        std::string const name = field( line, "name" );
+        std::string const size = field( line, name == "generation" ? "population" : "neurons" );
+        std::string const time = field( line, name == "generation" ? "generation_ns" : "median_ns" );
+        if ( name.empty() || size.empty() || time.empty() ) continue;
+        baseline[ { name, static_cast<size_t>( std::stoul( size ) ) } ] = std::stod( time );
+    }
+    return baseline;
+}
+
+/// <summary>
+/// Times the Genome hot operations on synthetic genomes, from the initial full link up to NEURON_LIMIT neurons, and Gym generations on growing populations,
+/// writing the results as JSON.
+/// </summary>
+/// <remarks>
+/// Arguments follow the SCR client style, suite:genome output:benchmark.json baseline:file tolerance:0.1 seconds:0.2 seed:1.
+/// The gym suite, suite:gym or suite:all, also reads populations:100,1000,10000,100000 generations:10 limit:60.
+/// The check suite, suite:check or suite:all, also reads genomes:200 and fails if any checked genome mismatches.
+/// With a baseline, every median operation and mean generation time is compared to the baseline one and the run fails if any is slower than the tolerance allows.
+/// </remarks>
+int main( int argc, char * argv[] )
+{
+    std::string suite = "genome";
+    std::string output = "benchmark.json";
+    std::string baseline_file = "";
+    double tolerance = 0.1;
+    double seconds = 0.2;
+    unsigned int seed = 1;
+    std::vector<size_t> populations = { 100, 1000, 10000, 100000 };
+    size_t generations = 10;
+    double limit = 60.0;
+    size_t genomes = 200;
+    for ( int argument = 1; argument < argc; argument++ )
+    {
+        std::string const option = argv[ argument ];
+        size_t const colon = option.find( ':' );
+        std::string const name = option.substr( 0, colon );
+        std::string const value = colon == std::string::npos ? "" : option.substr( colon + 1 );
+        if ( name == "suite" ) suite = value;
+        else if ( name == "output" ) output = value;
+        else if ( name == "baseline" ) baseline_file = value;
+        else if ( name == "tolerance" ) tolerance = std::atof( value.c_str() );
+        else if ( name == "seconds" ) seconds = std::atof( value.c_str() );
+        else if ( name == "seed" ) seed = static_cast<unsigned int>( std::atol( value.c_str() ) );
+        else if ( name == "generations" ) generations = static_cast<size_t>( std::atol( value.c_str() ) );
+        else if ( name == "limit" ) limit = std::atof( value.c_str() );
+        else if ( name == "genomes" ) genomes = static_cast<size_t>( std::atol( value.c_str() ) );
+        else if ( name == "populations" )
+        {
+            populations.clear();
+            std::istringstream list( value );
+            std::string population;
+            while ( std::getline( list, population, ',' ) ) populations.push_back( static_cast<size_t>( std::atol( population.c_str() ) ) );
+        }
+        else std::cout << "Unknown argument " << option << std::endl;
+    }
+    // opened before the gyms change the working directory
+    std::ofstream file( output );
+    if ( !file.is_open() )
+    {
+        std::cout << "Can't write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    RobotAxel::Benchmark benchmark( seconds, seed );
+    if ( suite == "genome" || suite == "all" )
+    {
+        std::array<size_t, 5> const sizes = { RobotAxel::Settings::INPUTS + RobotAxel::Settings::OUTPUTS, 100, 250, 500, RobotAxel::Settings::NEURON_LIMIT };
+        for ( size_t const & neurons : sizes ) benchmark.runGenome( neurons );
+    }
+    if ( suite == "gym" || suite == "all" )
+    {
+        for ( size_t const & population : populations ) benchmark.runGym( population, generations, limit );
+    }
+    if ( suite == "check" || suite == "all" )
+    {
+        benchmark.checkPhenotypes( genomes );
+        benchmark.checkCompaction( genomes );
+    }
+
+    // report, one result per line so baselines are read back without a JSON parser
+    std::map<std::pair<std::string, size_t>, double> const baseline = baseline_file.empty() ? std::map<std::pair<std::string, size_t>, double>() : readBaseline( baseline_file );
+    std::vector<std::string> lines = {};
+    size_t regressions = 0;
+    size_t mismatches = 0;
+    // compares a time with the baseline one, if any, adding the comparison to the result line
+    auto compare = [ & ]( std::string const & name, size_t const & size, double const & time, std::ostringstream & json )
+    {
+        auto const previous = baseline.find( { name, size } );
+        if ( previous == baseline.end() || previous->second <= 0.0 ) return;
+        double const change = time / previous->second - 1.0;
+        bool const regression = change > tolerance;
+        regressions += regression ? 1 : 0;
+        std::cout << " Baseline=" << previous->second << "ns Change=" << change * 100.0 << "%" << ( regression ? " REGRESSION" : "" );
+        json << ", \"baseline_ns\": " << previous->second << ", \"change\": " << std::setprecision( 4 ) << change << std::setprecision( 1 );
+    };
+    for ( RobotAxel::Benchmark::Result const & result : benchmark.getResults() )
+    {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision( 1 );
+        std::cout
+            << std::left << std::setw( 14 ) << result.name
+            << " Neurons=" << result.neurons
+            << " Genes=" << result.genes
+            << " Median=" << result.median << "ns"
+            << " Min=" << result.minimum << "ns";
+        json
+            << "{ \"name\": \"" << result.name << "\", \"neurons\": " << result.neurons << ", \"genes\": " << result.genes
+            << ", \"iterations\": " << result.iterations << ", \"median_ns\": " << result.median << ", \"minimum_ns\": " << result.minimum;
+        compare( result.name, result.neurons, result.median, json );
+        std::cout << std::endl;
+        json << " }";
+        lines.push_back( json.str() );
+    }
+    for ( RobotAxel::Benchmark::Gym_Result const & result : benchmark.getGymResults() )
+    {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision( 1 );
+        double const generations_done = static_cast<double>( std::max<size_t>( result.generations, 1 ) );
+        double const generation_time = result.seconds * 1e9 / generations_done;
+        double evaluation_time = generation_time;
+        std::cout
+            << std::left << std::setw( 14 ) << "generation"
+            << " Population=" << result.population
+            << " Generations=" << result.generations
+            << " Generations/s=" << static_cast<double>( result.generations ) / result.seconds;
+        json
+            << "{ \"name\": \"generation\", \"population\": " << result.population << ", \"generations\": " << result.generations
+            << ", \"generations_per_second\": " << std::setprecision( 4 ) << static_cast<double>( result.generations ) / result.seconds << std::setprecision( 1 )
+            << ", \"generation_ns\": " << generation_time;
+        for ( size_t phase = 0; phase < result.phases.size(); phase++ )
+        {
+            double const phase_time = result.phases[ phase ] * 1e9 / generations_done;
+            evaluation_time -= phase_time;
+            std::cout << " " << RobotAxel::Benchmark::PHASE_NAMES[ phase ] << "=" << phase_time / 1e6 << "ms";
+            json << ", \"" << RobotAxel::Benchmark::PHASE_NAMES[ phase ] << "_ns\": " << phase_time;
+        }
+        std::cout
+            << " evaluation=" << evaluation_time / 1e6 << "ms"
+            << " Peak=" << result.peak_memory / 1024 << "MB"
+            << " Species=" << result.species
+            << " Max species=" << result.maximum_species;
+        json
+            << ", \"evaluation_ns\": " << evaluation_time << ", \"peak_memory_kb\": " << result.peak_memory
+            << ", \"species\": " << result.species << ", \"maximum_species\": " << result.maximum_species;
+        compare( "generation", result.population, generation_time, json );
+        std::cout << std::endl;
+        json << " }";
+        lines.push_back( json.str() );
+    }
+
+    for ( RobotAxel::Benchmark::Check_Result const & result : benchmark.getCheckResults() )
+    {
+        std::ostringstream json;
+        mismatches += result.mismatches;
+        std::cout
+            << std::left << std::setw( 14 ) << result.name
+            << " Genomes=" << result.genomes
+            << " Mismatches=" << result.mismatches
+            << " Max difference=" << result.difference
+            << ( result.mismatches > 0 ? " MISMATCH" : "" ) << std::endl;
+        json
+            << "{ \"name\": \"" << result.name << "\", \"genomes\": " << result.genomes << ", \"mismatches\": " << result.mismatches
+            << ", \"max_difference\": " << result.difference << " }";
+        lines.push_back( json.str() );
+    }
+
+    file << "{\n  \"suite\": \"" << suite << "\",\n  \"seed\": " << seed << ",\n  \"seconds\": " << seconds << ",\n  \"results\": [\n";
+    for ( size_t index = 0; index < lines.size(); index++ ) file << "    " << lines[ index ] << ( index + 1 < lines.size() ? "," : "" ) << "\n";
+    file << "  ]\n}\n";
+    if ( regressions > 0 ) std::cout << "Regressions=" << regressions << " over " << tolerance * 100.0 << "%" << std::endl;
+    return regressions > 0 || mismatches > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+/***************************************************************************
+
+    file                 : fleet.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Axel.hpp"
+
+// leases follow whole generations, a steady-state Gym replaces a genome after every evaluation
+static_assert( !RobotAxel::Settings::GYM_STEADY_STATE, "the fleet leases whole generations, disable RobotAxel::Settings::GYM_STEADY_STATE to build it" );
+
+/// <summary>
+/// SCR car driven by the fleet, one UDP socket per server port.
+/// </summary>
+struct Fleet_Car
+{
+    /// <summary>
+    /// Socket connected to the car server port.
+    /// </summary>
+    int socket_descriptor;
+    /// <summary>
+    /// Car driver, leasing genomes from the fleet AI.
+    /// </summary>
+    std::unique_ptr<Axel> axel;
+    /// <summary>
+    /// Whenever the server accepted the car for the current race.
+    /// </summary>
+    bool identified;
+    /// <summary>
+    /// Whenever the car is told to restart, till the server restarts its race.
+    /// </summary>
+    bool restarting;
+    /// <summary>
+    /// Whenever the server did not shut the car down.
+    /// </summary>
+    bool active;
+    /// <summary>
+    /// Last identification request time.
+    /// </summary>
+    std::chrono::steady_clock::time_point identification;
+    /// <summary>
+    /// Control message to send, empty if none.
+    /// </summary>
+    std::string reply;
+};
+
+/// <summary>
+/// Drives many SCR cars from one process, every car evaluates a different genome of a shared AI.
+/// </summary>
+/// <remarks>
+/// Arguments follow the SCR client style, host:localhost port:3001 cars:10 id:SCR, car i races on port + i.
+/// Cars are served by a single epoll loop, every ready car is driven before the replies of the tick are sent.
+/// A TORCS restart restarts every car, so a car that finished its evaluation parks till every car finished and then all restart together.
+/// </remarks>
+int main( int argc, char * argv[] )
+{
+    // SCR client message buffer size
+    constexpr size_t const UDP_MSGLEN = 1000;
+    // identification retry interval, as the SCR client
+    constexpr auto const IDENTIFICATION_INTERVAL = std::chrono::seconds( 1 );
+    std::string host = "localhost";
+    unsigned short port = 3001;
+    size_t car_number = 10;
+    std::string id = "SCR";
+    for ( int argument = 1; argument < argc; argument++ )
+    {
+        std::string const option = argv[ argument ];
+        size_t const colon = option.find( ':' );
+        std::string const name = option.substr( 0, colon );
+        std::string const value = colon == std::string::npos ? "" : option.substr( colon + 1 );
+        if ( name == "host" ) host = value;
+        else if ( name == "port" ) port = static_cast<unsigned short>( std::atoi( value.c_str() ) );
+        else if ( name == "cars" ) car_number = static_cast<size_t>( std::atol( value.c_str() ) );
+        else if ( name == "id" ) id = value;
+        else std::cout << "Unknown argument " << option << std::endl;
+    }
+    if ( car_number == 0 ) return EXIT_FAILURE;
+
+    // server address
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo * server = nullptr;
+    if ( getaddrinfo( host.c_str(), nullptr, &hints, &server ) != 0 || server == nullptr )
+    {
+        std::cout << "Can't resolve host " << host << std::endl;
+        return EXIT_FAILURE;
+    }
+    sockaddr_in server_address = *reinterpret_cast<sockaddr_in *>( server->ai_addr );
+    freeaddrinfo( server );
+
+    // shared AI and cars
+    RobotAxel::AI fleet_ai( IS_TRAINING );
+    std::vector<Fleet_Car> cars( car_number );
+    int const poller = epoll_create1( 0 );
+    for ( size_t car_index = 0; car_index < car_number; car_index++ )
+    {
+        Fleet_Car & car = cars[ car_index ];
+        car.axel.reset( new Axel( &fleet_ai ) );
+        car.identified = false;
+        car.restarting = false;
+        car.active = true;
+        car.identification = std::chrono::steady_clock::time_point();
+        car.reply = "";
+        server_address.sin_port = htons( static_cast<unsigned short>( port + car_index ) );
+        car.socket_descriptor = socket( AF_INET, SOCK_DGRAM, 0 );
+        if ( car.socket_descriptor < 0 || connect( car.socket_descriptor, reinterpret_cast<sockaddr *>( &server_address ), sizeof( server_address ) ) < 0 )
+        {
+            std::cout << "Can't connect to port " << port + car_index << std::endl;
+            return EXIT_FAILURE;
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = car_index;
+        epoll_ctl( poller, EPOLL_CTL_ADD, car.socket_descriptor, &event );
+    }
+    // identification, with the car range finder angles
+    float angles[ TRACK_SENSORS_NUM ];
+    cars[ 0 ].axel->init( angles );
+    std::ostringstream identification = std::ostringstream();
+    identification << id << "(init";
+    for ( int sensor_index = 0; sensor_index < TRACK_SENSORS_NUM; sensor_index++ ) identification << " " << angles[ sensor_index ];
+    identification << ")";
+    std::string const identification_message = identification.str();
+    std::string const restart_message = CarControl( 0.0f, 0.0f, 0, 0.0f, 0.0f, 0, CarControl::META_RESTART ).toString();
+    std::cout << "Driving " << car_number << " cars on ports " << port << " to " << port + car_number - 1 << std::endl;
+
+    // cars that are racing and not yet told to restart
+    auto every_car_finished = [ & ]()
+    {
+        for ( Fleet_Car const & car : cars )
+        {
+            if ( car.active && car.identified && !car.restarting && !car.axel->isFinished() ) return false;
+        }
+        return true;
+    };
+    std::vector<epoll_event> events( car_number );
+    char buffer[ UDP_MSGLEN + 1 ];
+    size_t active_cars = car_number;
+    while ( active_cars > 0 )
+    {
+        // identify cars, retrying every interval
+        auto const now = std::chrono::steady_clock::now();
+        for ( Fleet_Car & car : cars )
+        {
+            if ( !car.active || car.identified || now - car.identification < IDENTIFICATION_INTERVAL ) continue;
+            send( car.socket_descriptor, identification_message.c_str(), identification_message.size(), 0 );
+            car.identification = now;
+        }
+        int const ready = epoll_wait( poller, events.data(), static_cast<int>( events.size() ), 100 );
+        // drive every ready car
+        for ( int event_index = 0; event_index < ready; event_index++ )
+        {
+            Fleet_Car & car = cars[ events[ event_index ].data.u64 ];
+            while ( car.active )
+            {
+                ssize_t const received = recv( car.socket_descriptor, buffer, UDP_MSGLEN, MSG_DONTWAIT );
+                if ( received < 0 ) break;
+                buffer[ received ] = '\0';
+                // identification
+                if ( !car.identified )
+                {
+                    car.identified = std::strcmp( buffer, "***identified***" ) == 0;
+                    continue;
+                }
+                // server requests
+                if ( std::strcmp( buffer, "***shutdown***" ) == 0 )
+                {
+                    car.axel->onShutdown();
+                    car.active = false;
+                    car.reply.clear();
+                    active_cars--;
+                    epoll_ctl( poller, EPOLL_CTL_DEL, car.socket_descriptor, nullptr );
+                    close( car.socket_descriptor );
+                    break;
+                }
+                if ( std::strcmp( buffer, "***restart***" ) == 0 )
+                {
+                    car.axel->onRestart();
+                    car.identified = false;
+                    car.restarting = false;
+                    car.identification = std::chrono::steady_clock::time_point();
+                    car.reply.clear();
+                    continue;
+                }
+                // sensors, only the latest message of the tick is answered
+                car.reply = car.restarting ? restart_message : car.axel->drive( std::string( buffer, static_cast<size_t>( received ) ) );
+                if ( car.restarting || !every_car_finished() ) continue;
+                // every evaluation ended, restart together
+                for ( Fleet_Car & other_car : cars ) other_car.restarting = other_car.active && other_car.identified;
+                car.reply = restart_message;
+            }
+        }
+        // answer the tick
+        for ( Fleet_Car & car : cars )
+        {
+            if ( car.reply.empty() ) continue;
+            send( car.socket_descriptor, car.reply.c_str(), car.reply.size(), 0 );
+            car.reply.clear();
+        }
+    }
+    close( poller );
+    return EXIT_SUCCESS;
+}
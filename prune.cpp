@@ -0,0 +1,204 @@
+/***************************************************************************
+
+    file                 : prune.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Axel.hpp"
+#include "Trace_Reader.hpp"
+
+/// <summary>
+/// Control deviation of a genome from the reference decisions, over every decision of a trace.
+/// </summary>
+struct Deviation
+{
+    /// <summary>
+    /// Largest steer difference.
+    /// </summary>
+    float steer;
+    /// <summary>
+    /// Largest acceleration, brake or clutch difference.
+    /// </summary>
+    float pedals;
+    /// <summary>
+    /// Largest focus difference, in [deg].
+    /// </summary>
+    float focus;
+    /// <summary>
+    /// Fraction of decisions with a different gear.
+    /// </summary>
+    float gear;
+    /// <summary>
+    /// Mean decision time, in [us].
+    /// </summary>
+    float latency;
+};
+
+/// <summary>
+/// Decides every trace state with a genome, through the racing Axel decision pipeline.
+/// </summary>
+/// <param name="genome">Genome to race.</param>
+/// <param name="states">Trace sensors states.</param>
+/// <param name="controls">Decided controls, one per state.</param>
+/// <returns>Mean decision time, in [us].</returns>
+float decideTrace( RobotAxel::Genome const & genome, std::vector<CarState> & states, std::vector<CarControl> & controls )
+{
+    Axel axel( genome );
+    controls.clear();
+    auto const start = std::chrono::steady_clock::now();
+    for ( CarState & car_state : states ) controls.push_back( axel.decide( car_state ) );
+    float const total = std::chrono::duration<float, std::micro>( std::chrono::steady_clock::now() - start ).count();
+    return total / static_cast<float>( std::max<size_t>( states.size(), 1 ) );
+}
+
+/// <summary>
+/// Measures the deviation of a genome from the reference decisions.
+/// </summary>
+/// <param name="genome">Genome to race.</param>
+/// <param name="states">Trace sensors states.</param>
+/// <param name="reference">Reference controls, one per state.</param>
+/// <returns>Control deviation.</returns>
+Deviation measureDeviation( RobotAxel::Genome const & genome, std::vector<CarState> & states, std::vector<CarControl> & reference )
+{
+    std::vector<CarControl> controls = {};
+    controls.reserve( states.size() );
+    Deviation deviation = { 0.0f, 0.0f, 0.0f, 0.0f, decideTrace( genome, states, controls ) };
+    size_t gears = 0;
+    for ( size_t index = 0; index < controls.size(); index++ )
+    {
+        // focus getter is not const
+        CarControl & decided = controls[ index ];
+        CarControl & expected = reference[ index ];
+        deviation.steer = std::max( deviation.steer, std::fabs( decided.getSteer() - expected.getSteer() ) );
+        deviation.pedals = std::max( deviation.pedals, std::fabs( decided.getAccel() - expected.getAccel() ) );
+        deviation.pedals = std::max( deviation.pedals, std::fabs( decided.getBrake() - expected.getBrake() ) );
+        deviation.pedals = std::max( deviation.pedals, std::fabs( decided.getClutch() - expected.getClutch() ) );
+        deviation.focus = std::max( deviation.focus, static_cast<float>( std::abs( decided.getFocus() - expected.getFocus() ) ) );
+        if ( decided.getGear() != expected.getGear() ) gears++;
+    }
+    deviation.gear = static_cast<float>( gears ) / static_cast<float>( std::max<size_t>( controls.size(), 1 ) );
+    return deviation;
+}
+
+/// <summary>
+/// Prunes the racing genome for deployment, removing the lowest magnitude genes and then hidden neurons while its decisions over a trace stay
+/// within tolerance of the unpruned ones.
+/// </summary>
+/// <remarks>
+/// Arguments follow the SCR client style, trace:file genome:genomes/top_genome_final.txt output:genomes/top_genome_pruned.txt steer:0.05 pedals:0.05 focus:5 gear:0.01.
+/// Steer, pedals and focus bound the largest control difference, gear bounds the fraction of decisions with a different gear.
+/// Every round prunes a batch, halving the batch when the pruned genome leaves the tolerance, till a single gene or neuron can't be pruned.
+/// Any trace works, the reference decisions are taken by the unpruned genome over the recorded sensors.
+/// </remarks>
+int main( int argc, char * argv[] )
+{
+    std::string trace = "";
+    std::string genome_file = "genomes/top_genome_final.txt";
+    std::string output = "genomes/top_genome_pruned.txt";
+    Deviation tolerance = { 0.05f, 0.05f, 5.0f, 0.01f, 0.0f };
+    for ( int argument = 1; argument < argc; argument++ )
+    {
+        std::string const option = argv[ argument ];
+        size_t const colon = option.find( ':' );
+        std::string const name = option.substr( 0, colon );
+        std::string const value = colon == std::string::npos ? "" : option.substr( colon + 1 );
+        if ( name == "trace" ) trace = value;
+        else if ( name == "genome" ) genome_file = value;
+        else if ( name == "output" ) output = value;
+        else if ( name == "steer" ) tolerance.steer = std::strtof( value.c_str(), nullptr );
+        else if ( name == "pedals" ) tolerance.pedals = std::strtof( value.c_str(), nullptr );
+        else if ( name == "focus" ) tolerance.focus = std::strtof( value.c_str(), nullptr );
+        else if ( name == "gear" ) tolerance.gear = std::strtof( value.c_str(), nullptr );
+        else std::cout << "Unknown argument " << option << std::endl;
+    }
+    if ( trace.empty() )
+    {
+        std::cout << "Usage: " << argv[ 0 ] << " trace:file [genome:file] [output:file] [steer:0.05] [pedals:0.05] [focus:5] [gear:0.01]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    RobotAxel::Genome original = RobotAxel::Genome();
+    if ( !original.load( genome_file ) )
+    {
+        std::cout << "Can't open genome " << genome_file << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // trace sensors, restart ticks carry no decision
+    Trace_Reader reader( trace );
+    if ( !reader.isOpen() ) return EXIT_FAILURE;
+    std::vector<CarState> states = {};
+    states.reserve( reader.size() );
+    CarState car_state = CarState();
+    CarControl recorded = CarControl();
+    while ( reader.next( car_state, recorded ) )
+    {
+        if ( recorded.getMeta() != CarControl::META_RESTART ) states.push_back( car_state );
+    }
+    if ( states.empty() )
+    {
+        std::cout << "Trace has no decisions" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<CarControl> reference = {};
+    reference.reserve( states.size() );
+    float const original_latency = decideTrace( original, states, reference );
+
+    // lossless compaction first, then batches of genes and hidden neurons
+    RobotAxel::Genome pruned = RobotAxel::Genome( original );
+    size_t removed_genes = 0, removed_neurons = 0;
+    pruned.compact( false, removed_genes, removed_neurons );
+    Deviation deviation = measureDeviation( pruned, states, reference );
+    auto within = []( Deviation const & measured, Deviation const & allowed )
+    {
+        return measured.steer <= allowed.steer && measured.pedals <= allowed.pedals && measured.focus <= allowed.focus && measured.gear <= allowed.gear;
+    };
+    for ( bool const neurons : { false, true } )
+    {
+        auto available = [ & ]() { return neurons ? pruned.getTotalNeurons() - RobotAxel::Settings::INPUTS - RobotAxel::Settings::OUTPUTS : pruned.getTotalGenes(); };
+        size_t batch = std::max<size_t>( available() / 4, 1 );
+        while ( batch > 0 && available() > 0 )
+        {
+            RobotAxel::Genome candidate = RobotAxel::Genome( pruned );
+            if ( neurons ) candidate.pruneNeurons( batch );
+            else candidate.pruneWeights( batch );
+            // nothing left to remove
+            if ( candidate.getTotalGenes() == pruned.getTotalGenes() && candidate.getTotalNeurons() == pruned.getTotalNeurons() ) break;
+            Deviation const measured = measureDeviation( candidate, states, reference );
+            if ( within( measured, tolerance ) )
+            {
+                pruned = candidate;
+                deviation = measured;
+                batch = std::min( batch, std::max<size_t>( available(), 1 ) );
+            }
+            else batch /= 2;
+        }
+    }
+    if ( !within( deviation, tolerance ) )
+    {
+        std::cout << "Compacted genome already leaves the tolerance, nothing written" << std::endl;
+        return EXIT_FAILURE;
+    }
+    pruned.write( output );
+
+    // report
+    std::cout
+        << "Decisions=" << states.size()
+        << " Genes=" << original.getTotalGenes() << "->" << pruned.getTotalGenes()
+        << " Neurons=" << original.getTotalNeurons() << "->" << pruned.getTotalNeurons()
+        << " Decision=" << original_latency << "us->" << deviation.latency << "us"
+        << " Steer=" << deviation.steer
+        << " Pedals=" << deviation.pedals
+        << " Focus=" << deviation.focus
+        << " Gear=" << deviation.gear
+        << " Written=" << output
+        << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/***************************************************************************
+
+    file                 : replay.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Axel.hpp"
+#include "Trace_Reader.hpp"
+
+/// <summary>
+/// Replays a driver trace through the racing Axel decision pipeline as fast as possible, reporting decisions per second, per tick latency and
+/// decisions that differ from the recorded ones.
+/// </summary>
+/// <remarks>
+/// Usage: replay trace_file [repeats]. Decisions only match a trace recorded by the racing AI with the same top genome.
+/// </remarks>
+int main( int argc, char * argv[] )
+{
+    if ( argc < 2 )
+    {
+        std::cout << "Usage: " << argv[ 0 ] << " trace_file [repeats]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    size_t const repeats = argc > 2 ? static_cast<size_t>( std::max( 1, std::atoi( argv[ 2 ] ) ) ) : 1;
+    Trace_Reader reader( argv[ 1 ] );
+    if ( !reader.isOpen() ) return EXIT_FAILURE;
+    Axel axel( false, false );
+
+    CarState car_state = CarState();
+    CarControl recorded = CarControl();
+    std::vector<float> latencies = {};
+    latencies.reserve( reader.size() * repeats );
+    size_t mismatches = 0;
+    auto const start = std::chrono::steady_clock::now();
+    for ( size_t repeat = 0; repeat < repeats; repeat++ )
+    {
+        reader.seek( 0 );
+        while ( reader.next( car_state, recorded ) )
+        {
+            // restart ticks carry no decision
+            if ( recorded.getMeta() == CarControl::META_RESTART ) continue;
+            auto const tick = std::chrono::steady_clock::now();
+            CarControl const & decided = axel.decide( car_state );
+            latencies.push_back( std::chrono::duration<float, std::micro>( std::chrono::steady_clock::now() - tick ).count() );
+            if ( decided.getGear() != recorded.getGear() || decided.getSteer() != recorded.getSteer() || decided.getAccel() != recorded.getAccel()
+                || decided.getBrake() != recorded.getBrake() || decided.getClutch() != recorded.getClutch() ) mismatches++;
+        }
+    }
+    float const total = std::chrono::duration<float>( std::chrono::steady_clock::now() - start ).count();
+    if ( latencies.empty() )
+    {
+        std::cout << "Trace has no decisions" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // report
+    std::sort( latencies.begin(), latencies.end() );
+    float mean = 0.0f;
+    for ( float const & latency : latencies ) mean += latency;
+    mean /= static_cast<float>( latencies.size() );
+    auto percentile = [ & ]( float const fraction ) { return latencies[ static_cast<size_t>( fraction * static_cast<float>( latencies.size() - 1 ) ) ]; };
+    std::cout
+        << "Records=" << reader.size()
+        << " Decisions=" << latencies.size()
+        << " Decisions/s=" << static_cast<float>( latencies.size() ) / total
+        << " Mean=" << mean << "us"
+        << " P50=" << percentile( 0.5f ) << "us"
+        << " P99=" << percentile( 0.99f ) << "us"
+        << " Max=" << latencies.back() << "us"
+        << " Mismatches=" << mismatches
+        << std::endl;
+    return EXIT_SUCCESS;
+}
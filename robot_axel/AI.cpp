@@ -1,135 +1,292 @@
-/***************************************************************************
-
-    file                 : AI.cpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#include "AI.hpp"
-
-#if defined (ROBOT_AXEL_AI)
-
-namespace RobotAxel
-{
-    /***************************************************************************
-     *                                                                         *
-     *   AI interface.                                                         *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Creates the AI using the intended method depending of the objective.
-    /// </summary>
-    /// <param name="training">Whenever should the AI train.</param>
-    AI::AI( bool const & training )
-        :gym( generateGym( training ) ), best_ai( generateBestAI( training ) ) {}
-
-    /// <summary>
-    /// Destroys the created 
-    /// </summary>
-    AI::~AI()
-    {
-        // not training
-        if ( this->best_ai != nullptr ) delete this->best_ai;
-        // gym
-        if ( this->gym != nullptr ) delete this->gym;
-    }
-
-    /// <summary>
-    /// Calculates outputs according to the current network, using the Gym or the top AI.
-    /// </summary>
-    /// <param name="outputs">Array with output neurons values.</param>
-    /// <param name="inputs">The input array used for the update.</param>
-    void AI::evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs )
-    {
-        // not training
-        if ( this->gym == nullptr ) return this->best_ai->evaluate( outputs, inputs );
-        // gym
-        return this->gym->evaluateCurrent( outputs, inputs );
-    }
-
-    /// <summary>
-    /// Appraises AI progress in current environment, this progress is used for AI evaluation, does nothing .
-    /// </summary>
-    /// <param name="progress_rating">Progress evaluation of current AI situation.</param>
-    void AI::appraise( float const & progress_rating )
-    {
-        // not training
-        if ( this->gym == nullptr ) return;
-        // gym
-        this->gym->appraiseCurrent( progress_rating );
-    }
-
-    /// <summary>
-    /// Indicates the Gym to advance to the next Genome for the fitness test, if it is a racing AI, does nothing.
-    /// </summary>
-    void AI::advanceInTrain()
-    {
-        // not training
-        if ( this->gym == nullptr ) return;
-        // gym
-        this->gym->advanceInTrain();
-    }
-
-    /// <summary>
-    /// Retrieves current training generation and species number in generation, as well current top progress.
-    /// </summary>
-    /// <param name="generation">Current AI generation if training, generation reference if not.</param>
-    /// <param name="species">Number of species in generation if training, unchanged if not.</param>
-    /// <param name="progress">Current fitness if training, unchanged if not.</param>
-    /// <param name="top_progress">Current maximum fitness if training, AI progress if not.</param>
-    /// <param name="top_genes">Top gene number.</param>
-    /// <param name="top_neurons">Top neuron number.</param>
-    void AI::getInformation( size_t & generation, size_t & species, float & progress, float & top_progress, size_t & top_genes, size_t & top_neurons ) const
-    {
-        // not training
-        if ( this->gym == nullptr )
-        {
-            top_progress = this->best_ai->getFitness();
-            generation = this->best_ai->getGeneration();
-            top_genes = this->best_ai->getTotalGenes();
-            top_neurons = this->best_ai->getTotalNeurons();
-            return;
-        }
-        // gym
-        this->gym->getInformation( generation, species, progress, top_progress, top_genes, top_neurons );
-    }
-
-    /***************************************************************************
-     *                                                                         *
-     *   AI utilities.                                                         *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Generates the Gym for AI training if training is set.
-    /// </summary>
-    /// <param name="training">Whenever should the AI train.</param>
-    /// <returns>A gym instance pointer or a null pointer.</returns>
-    Gym * const AI::generateGym( bool const & training ) const
-    {
-        if ( training )
-        { return new Gym(); }
-        else
-        { return nullptr; }
-    }
-
-    /// <summary>
-    /// Generates the best AI training is not set.
-    /// </summary>
-    /// <param name="training">Whenever should the AI train.</param>
-    /// <returns>A pointer with the top found Genome, or a null pointer.</returns>
-    Genome const * const AI::generateBestAI( bool const & training ) const
-    {
-        if ( training )
-        { return nullptr; }
-        else
-        { return new Genome( true ); }
-    }
-}
-
-#endif
+/***************************************************************************
+
+    file                 : AI.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "AI.hpp"
+
+#if defined (ROBOT_AXEL_AI)
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   AI interface.                                                         *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Creates the AI using the intended method depending of the objective.
+    /// </summary>
+    /// <param name="training">Whenever should the AI train.</param>
+    AI::AI( bool const & training )
+        :gym( generateGym( training ) ), best_ai( generateBestAI( training ) ) {}
+
+    /// <summary>
+    /// Creates a racing AI driving a given Genome.
+    /// </summary>
+    /// <param name="genome">Genome to race.</param>
+    AI::AI( Genome const & genome )
+        :gym( nullptr ), best_ai( new Genome( genome ) ) {}
+
+    /// <summary>
+    /// Destroys the created 
+    /// </summary>
+    AI::~AI()
+    {
+        // not training
+        if ( this->best_ai != nullptr ) delete this->best_ai;
+        // gym
+        if ( this->gym != nullptr ) delete this->gym;
+    }
+
+    /// <summary>
+    /// Calculates outputs according to the current network, using the Gym or the top AI.
+    /// </summary>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void AI::evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs )
+    {
+        // not training
+        if ( this->gym == nullptr ) return this->best_ai->evaluate( outputs, inputs );
+        // gym
+        return this->gym->evaluateCurrent( outputs, inputs );
+    }
+
+    /// <summary>
+    /// Compiles the current network, of the Gym or the top Genome, for evaluation without allocations.
+    /// </summary>
+    /// <param name="phenotype">Phenotype to build.</param>
+    void AI::compile( Phenotype & phenotype ) const
+    {
+        // not training
+        if ( this->gym == nullptr ) return phenotype.build( *this->best_ai );
+        // gym
+        this->gym->compileCurrent( phenotype );
+    }
+
+    /// <summary>
+    /// Appraises AI progress in current environment, this progress is used for AI evaluation, does nothing .
+    /// </summary>
+    /// <param name="progress_rating">Progress evaluation of current AI situation.</param>
+    /// <param name="time">Evaluation time, in [s].</param>
+    /// <param name="progress_bound">Upper bound of the final progress evaluation, unbounded if unknown.</param>
+    void AI::appraise( float const & progress_rating, float const & time, float const & progress_bound )
+    {
+        // not training
+        if ( this->gym == nullptr ) return;
+        // gym
+        this->gym->appraiseCurrent( progress_rating, time, progress_bound );
+    }
+
+    /// <summary>
+    /// Checks if the current evaluation can no longer reach the training survival threshold, never for a racing AI.
+    /// </summary>
+    /// <returns>Whenever the evaluation should be terminated.</returns>
+    bool const AI::abortEvaluation() const
+    {
+        // not training
+        if ( this->gym == nullptr ) return false;
+        // gym
+        return this->gym->abortCurrent();
+    }
+
+    /// <summary>
+    /// Retrieves the current evaluation horizon, after which the evaluation should end.
+    /// </summary>
+    /// <returns>Horizon in [s], 0 for a full evaluation or a racing AI.</returns>
+    float const AI::evaluationHorizon() const
+    {
+        // not training
+        if ( this->gym == nullptr ) return 0.0f;
+        // gym
+        return this->gym->currentHorizon();
+    }
+
+    /// <summary>
+    /// Indicates the Gym to advance to the next Genome for the fitness test, if it is a racing AI, does nothing.
+    /// </summary>
+    /// <param name="complete">Whenever the evaluation ran to its end, aborted and horizon cut ones are neither cached nor kept as progress curves.</param>
+    void AI::advanceInTrain( bool const & complete )
+    {
+        // not training
+        if ( this->gym == nullptr ) return;
+        // gym
+        this->gym->advanceInTrain( complete );
+    }
+
+    /// <summary>
+    /// Leases a Gym genome to a car racing alongside others, a racing AI leases its top Genome to every car.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <returns>Whenever a genome was leased, false while the remaining genomes of the generation are leased.</returns>
+    bool const AI::leaseGenome( size_t & lease )
+    {
+        // not training
+        if ( this->gym == nullptr )
+        {
+            lease = 0;
+            return true;
+        }
+        // gym
+        return this->gym->leaseGenome( lease );
+    }
+
+    /// <summary>
+    /// Calculates outputs according to a leased network.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void AI::evaluateLeased( size_t const & lease, std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
+    {
+        // not training
+        if ( this->gym == nullptr ) return this->best_ai->evaluate( outputs, inputs );
+        // gym
+        this->gym->evaluateLeased( lease, outputs, inputs );
+    }
+
+    /// <summary>
+    /// Compiles a leased network, for evaluation without allocations.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="phenotype">Phenotype to build.</param>
+    void AI::compileLeased( size_t const & lease, Phenotype & phenotype ) const
+    {
+        // not training
+        if ( this->gym == nullptr ) return phenotype.build( *this->best_ai );
+        // gym
+        this->gym->compileLeased( lease, phenotype );
+    }
+
+    /// <summary>
+    /// Returns a leased genome with the progress of its evaluation, does nothing for a racing AI.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="progress_rating">Progress evaluation of the leased genome.</param>
+    void AI::returnGenome( size_t const & lease, float const & progress_rating )
+    {
+        // not training
+        if ( this->gym == nullptr ) return;
+        // gym
+        this->gym->returnGenome( lease, progress_rating );
+    }
+
+    /// <summary>
+    /// Describes the genome in evaluation, for its evaluation telemetry, a racing AI describes its top Genome.
+    /// </summary>
+    /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+    /// <param name="species">Genome species index if training, 0 if not.</param>
+    /// <param name="hash">Genome structural hash.</param>
+    /// <param name="genes">Genome gene number.</param>
+    /// <param name="neurons">Genome neuron number.</param>
+    void AI::describeCurrent( size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const
+    {
+        // not training
+        if ( this->gym == nullptr )
+        {
+            generation = this->best_ai->getGeneration();
+            species = 0;
+            hash = this->best_ai->hash();
+            genes = this->best_ai->getTotalGenes();
+            neurons = this->best_ai->getTotalNeurons();
+            return;
+        }
+        // gym
+        this->gym->describeCurrent( generation, species, hash, genes, neurons );
+    }
+
+    /// <summary>
+    /// Describes a leased genome, for its evaluation telemetry, a racing AI describes its top Genome.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+    /// <param name="species">Genome species index if training, 0 if not.</param>
+    /// <param name="hash">Genome structural hash.</param>
+    /// <param name="genes">Genome gene number.</param>
+    /// <param name="neurons">Genome neuron number.</param>
+    void AI::describeLeased( size_t const & lease, size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const
+    {
+        // not training
+        if ( this->gym == nullptr ) return describeCurrent( generation, species, hash, genes, neurons );
+        // gym
+        this->gym->describeLeased( lease, generation, species, hash, genes, neurons );
+    }
+
+    /// <summary>
+    /// Retrieves current training generation and species number in generation, as well current top progress.
+    /// </summary>
+    /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+    /// <param name="species">Number of species in generation if training, unchanged if not.</param>
+    /// <param name="progress">Current fitness if training, unchanged if not.</param>
+    /// <param name="top_progress">Current maximum fitness if training, AI progress if not.</param>
+    /// <param name="top_genes">Top gene number.</param>
+    /// <param name="top_neurons">Top neuron number.</param>
+    void AI::getInformation( size_t & generation, size_t & species, float & progress, float & top_progress, size_t & top_genes, size_t & top_neurons ) const
+    {
+        // not training
+        if ( this->gym == nullptr )
+        {
+            top_progress = this->best_ai->getFitness();
+            generation = this->best_ai->getGeneration();
+            top_genes = this->best_ai->getTotalGenes();
+            top_neurons = this->best_ai->getTotalNeurons();
+            return;
+        }
+        // gym
+        this->gym->getInformation( generation, species, progress, top_progress, top_genes, top_neurons );
+    }
+
+    /// <summary>
+    /// Redirects the Gym generation console lines and reports, does nothing for a racing AI.
+    /// </summary>
+    /// <param name="print">Prints a console line, without its end.</param>
+    /// <param name="append">Appends contents to a file, by file name and contents.</param>
+    void AI::redirectOutput( std::function<void( std::string const & )> const & print, std::function<void( std::string const &, std::string const & )> const & append )
+    {
+        // not training
+        if ( this->gym == nullptr ) return;
+        // gym
+        this->gym->redirectOutput( print, append );
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   AI utilities.                                                         *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates the Gym for AI training if training is set.
+    /// </summary>
+    /// <param name="training">Whenever should the AI train.</param>
+    /// <returns>A gym instance pointer or a null pointer.</returns>
+    Gym * const AI::generateGym( bool const & training ) const
+    {
+        if ( training )
+        { return new Gym(); }
+        else
+        { return nullptr; }
+    }
+
+    /// <summary>
+    /// Generates the best AI training is not set.
+    /// </summary>
+    /// <param name="training">Whenever should the AI train.</param>
+    /// <returns>A pointer with the top found Genome, or a null pointer.</returns>
+    Genome const * const AI::generateBestAI( bool const & training ) const
+    {
+        if ( training )
+        { return nullptr; }
+        else
+        { return new Genome( true ); }
+    }
+}
+
+#endif
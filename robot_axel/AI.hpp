@@ -1,114 +1,201 @@
-/***************************************************************************
-
-    file                 : AI.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#pragma once
-
-#ifndef ROBOT_AXEL_AI
-#define ROBOT_AXEL_AI
-
-#include <array>
-#include "Genome.hpp"
-#include "Gym.hpp"
-#include "Settings.hpp"
-
-namespace RobotAxel
-{
-    /// <summary>
-    /// An evolutionary AI implementation based on NEAT and MarI/O.
-    /// </summary>
-    class AI
-    {
-        /***************************************************************************
-         *                                                                         *
-         *   AI local constants and variables.                                     *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Ecosystem used for evolution ( Training ).
-        /// </summary>
-        Gym * const gym;
-        /// <summary>
-        /// Top breed, best network result for input, output stream ( Evaluation only ).
-        /// </summary>
-        Genome const * const best_ai;
-
-        /***************************************************************************
-         *                                                                         *
-         *  AI interface.                                                          *
-         *                                                                         *
-         ***************************************************************************/
-        public:
-        /// <summary>
-        /// Creates the AI using the intended method depending of the objective.
-        /// </summary>
-        /// <param name="training">Whenever should the AI train.</param>
-        AI( bool const & training );
-
-        /// <summary>
-        /// Destroys the created 
-        /// </summary>
-        ~AI();
-
-        /// <summary>
-        /// Calculates outputs according to the current network, using the Gym or the top Genome.
-        /// </summary>
-        /// <param name="outputs">Array with output neurons values.</param>
-        /// <param name="inputs">The input array used for the update.</param>
-        void evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs );
-
-        /// <summary>
-        /// Appraises AI progress in current environment, this progress is used for AI evaluation.
-        /// </summary>
-        /// <param name="progress_rating">Progress evaluation of current AI situation.</param>
-        void appraise( float const & progress_rating );
-
-        /// <summary>
-        /// Indicates the Gym to advance to the next Genome, for the fitness test.
-        /// </summary>
-        void advanceInTrain();
-
-        /// <summary>
-        /// Retrieves current training generation and species number in generation, as well current top progress.
-        /// </summary>
-        /// <param name="generation">Current AI generation if training, generation reference if not.</param>
-        /// <param name="species">Number of species in generation if training, 0 if not.</param>
-        /// <param name="progress">Current fitness if training, 0 if not.</param>
-        /// <param name="top_progress">Current maximum fitness if training, AI progress if not.</param>
-        /// <param name="top_genes">Top gene number.</param>
-        /// <param name="top_neurons">Top neuron number.</param>
-        void getInformation( size_t & generation, size_t & species, float & progress, float & top_progress, size_t & top_genes, size_t & top_neurons ) const;
-
-        /***************************************************************************
-         *                                                                         *
-         *   AI Utilities.                                                         *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Generates the Gym for AI training if training is set.
-        /// </summary>
-        /// <param name="training">Whenever should the AI train.</param>
-        /// <returns>A gym instance pointer or a null pointer.</returns>
-        Gym * const generateGym( bool const & training ) const;
-
-        /// <summary>
-        /// Generates the top AI for the environment if the training is not set.
-        /// </summary>
-        /// <param name="training">Whenever should the AI train.</param>
-        /// <returns>A pointer with the top found Genome, or a null pointer.</returns>
-        Genome const * const generateBestAI( bool const & training ) const;
-    };
-}
-
-#endif
+/***************************************************************************
+
+    file                 : AI.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_AI
+#define ROBOT_AXEL_AI
+
+#include <array>
+#include <functional>
+#include <string>
+#include "Genome.hpp"
+#include "Gym.hpp"
+#include "Phenotype.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// An evolutionary AI implementation based on NEAT and MarI/O.
+    /// </summary>
+    class AI
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   AI local constants and variables.                                     *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Ecosystem used for evolution ( Training ).
+        /// </summary>
+        Gym * const gym;
+        /// <summary>
+        /// Top breed, best network result for input, output stream ( Evaluation only ).
+        /// </summary>
+        Genome const * const best_ai;
+
+        /***************************************************************************
+         *                                                                         *
+         *  AI interface.                                                          *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Creates the AI using the intended method depending of the objective.
+        /// </summary>
+        /// <param name="training">Whenever should the AI train.</param>
+        AI( bool const & training );
+
+        /// <summary>
+        /// Creates a racing AI driving a given Genome.
+        /// </summary>
+        /// <param name="genome">Genome to race.</param>
+        AI( Genome const & genome );
+
+        /// <summary>
+        /// Destroys the created 
+        /// </summary>
+        ~AI();
+
+        /// <summary>
+        /// Calculates outputs according to the current network, using the Gym or the top Genome.
+        /// </summary>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs );
+
+        /// <summary>
+        /// Compiles the current network, of the Gym or the top Genome, for evaluation without allocations.
+        /// </summary>
+        /// <param name="phenotype">Phenotype to build.</param>
+        void compile( Phenotype & phenotype ) const;
+
+        /// <summary>
+        /// Appraises AI progress in current environment, this progress is used for AI evaluation.
+        /// </summary>
+        /// <param name="progress_rating">Progress evaluation of current AI situation.</param>
+        /// <param name="time">Evaluation time, in [s].</param>
+        /// <param name="progress_bound">Upper bound of the final progress evaluation, unbounded if unknown.</param>
+        void appraise( float const & progress_rating, float const & time, float const & progress_bound );
+
+        /// <summary>
+        /// Checks if the current evaluation can no longer reach the training survival threshold, never for a racing AI.
+        /// </summary>
+        /// <returns>Whenever the evaluation should be terminated.</returns>
+        bool const abortEvaluation() const;
+
+        /// <summary>
+        /// Retrieves the current evaluation horizon, after which the evaluation should end.
+        /// </summary>
+        /// <returns>Horizon in [s], 0 for a full evaluation or a racing AI.</returns>
+        float const evaluationHorizon() const;
+
+        /// <summary>
+        /// Indicates the Gym to advance to the next Genome, for the fitness test.
+        /// </summary>
+        /// <param name="complete">Whenever the evaluation ran to its end, aborted and horizon cut ones are neither cached nor kept as progress curves.</param>
+        void advanceInTrain( bool const & complete = true );
+
+        /// <summary>
+        /// Leases a Gym genome to a car racing alongside others, a racing AI leases its top Genome to every car.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <returns>Whenever a genome was leased, false while the remaining genomes of the generation are leased.</returns>
+        bool const leaseGenome( size_t & lease );
+
+        /// <summary>
+        /// Calculates outputs according to a leased network.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluateLeased( size_t const & lease, std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
+
+        /// <summary>
+        /// Compiles a leased network, for evaluation without allocations.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="phenotype">Phenotype to build.</param>
+        void compileLeased( size_t const & lease, Phenotype & phenotype ) const;
+
+        /// <summary>
+        /// Returns a leased genome with the progress of its evaluation, does nothing for a racing AI.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="progress_rating">Progress evaluation of the leased genome.</param>
+        void returnGenome( size_t const & lease, float const & progress_rating );
+
+        /// <summary>
+        /// Describes the genome in evaluation, for its evaluation telemetry, a racing AI describes its top Genome.
+        /// </summary>
+        /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+        /// <param name="species">Genome species index if training, 0 if not.</param>
+        /// <param name="hash">Genome structural hash.</param>
+        /// <param name="genes">Genome gene number.</param>
+        /// <param name="neurons">Genome neuron number.</param>
+        void describeCurrent( size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const;
+
+        /// <summary>
+        /// Describes a leased genome, for its evaluation telemetry, a racing AI describes its top Genome.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+        /// <param name="species">Genome species index if training, 0 if not.</param>
+        /// <param name="hash">Genome structural hash.</param>
+        /// <param name="genes">Genome gene number.</param>
+        /// <param name="neurons">Genome neuron number.</param>
+        void describeLeased( size_t const & lease, size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const;
+
+        /// <summary>
+        /// Retrieves current training generation and species number in generation, as well current top progress.
+        /// </summary>
+        /// <param name="generation">Current AI generation if training, generation reference if not.</param>
+        /// <param name="species">Number of species in generation if training, 0 if not.</param>
+        /// <param name="progress">Current fitness if training, 0 if not.</param>
+        /// <param name="top_progress">Current maximum fitness if training, AI progress if not.</param>
+        /// <param name="top_genes">Top gene number.</param>
+        /// <param name="top_neurons">Top neuron number.</param>
+        void getInformation( size_t & generation, size_t & species, float & progress, float & top_progress, size_t & top_genes, size_t & top_neurons ) const;
+
+        /// <summary>
+        /// Redirects the Gym generation console lines and reports, does nothing for a racing AI.
+        /// </summary>
+        /// <param name="print">Prints a console line, without its end.</param>
+        /// <param name="append">Appends contents to a file, by file name and contents.</param>
+        void redirectOutput( std::function<void( std::string const & )> const & print, std::function<void( std::string const &, std::string const & )> const & append );
+
+        /***************************************************************************
+         *                                                                         *
+         *   AI Utilities.                                                         *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Generates the Gym for AI training if training is set.
+        /// </summary>
+        /// <param name="training">Whenever should the AI train.</param>
+        /// <returns>A gym instance pointer or a null pointer.</returns>
+        Gym * const generateGym( bool const & training ) const;
+
+        /// <summary>
+        /// Generates the top AI for the environment if the training is not set.
+        /// </summary>
+        /// <param name="training">Whenever should the AI train.</param>
+        /// <returns>A pointer with the top found Genome, or a null pointer.</returns>
+        Genome const * const generateBestAI( bool const & training ) const;
+    };
+}
+
+#endif
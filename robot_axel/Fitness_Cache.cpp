@@ -0,0 +1,181 @@
+/***************************************************************************
+
+    file                 : Fitness_Cache.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Fitness_Cache.hpp"
+
+#if defined (ROBOT_AXEL_FITNESS_CACHE)
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Fitness_Cache interface.                                              *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates the cache, loading the saved one if persisted.
+    /// </summary>
+    Fitness_Cache::Fitness_Cache() : entries( {} ), unsaved( {} ), skipped( 0 ), uses( 0 )
+    {
+        if ( !Settings::FITNESS_CACHE_PERSIST ) return;
+        // every line is hash, fitness and samples, later lines were saved later and replace earlier ones
+        std::ifstream myfile( "genomes/fitness_cache.txt" );
+        if ( !myfile.is_open() ) return;
+        size_t lines = 0;
+        unsigned long long hash = 0;
+        Entry entry = Entry();
+        entry.saved = true;
+        while ( myfile >> hash >> entry.fitness >> entry.samples )
+        {
+            entry.used = ++this->uses;
+            this->entries[ hash ] = entry;
+            lines++;
+            if ( this->entries.size() > Settings::FITNESS_CACHE_LIMIT ) evict();
+        }
+        myfile.close();
+        // replaced and evicted lines are dropped once they are most of the file
+        if ( lines > 2 * this->entries.size() ) rewrite();
+    }
+
+    /// <summary>
+    /// Retrieves the fitness of a genome if it was sampled enough to skip its evaluation.
+    /// </summary>
+    /// <param name="hash">Genome hash.</param>
+    /// <param name="fitness">Average fitness, unchanged if not found.</param>
+    /// <returns>Whenever the evaluation can be skipped.</returns>
+    bool const Fitness_Cache::lookup( unsigned long long const & hash, float & fitness )
+    {
+        auto entry = this->entries.find( hash );
+        // not sampled enough, must be evaluated
+        if ( entry == this->entries.end() || entry->second.samples < Settings::FITNESS_CACHE_SAMPLES ) return false;
+        entry->second.used = ++this->uses;
+        fitness = entry->second.fitness;
+        this->skipped++;
+        return true;
+    }
+
+    /// <summary>
+    /// Records a finished evaluation of a genome.
+    /// </summary>
+    /// <param name="hash">Genome hash.</param>
+    /// <param name="fitness">Evaluated fitness.</param>
+    /// <returns>Average fitness of all the genome samples.</returns>
+    float const Fitness_Cache::record( unsigned long long const & hash, float const & fitness )
+    {
+        if ( this->entries.size() >= Settings::FITNESS_CACHE_LIMIT && this->entries.count( hash ) == 0 ) evict();
+        Entry & entry = this->entries[ hash ];
+        // incremental average
+        entry.samples++;
+        entry.fitness += ( fitness - entry.fitness ) / static_cast<float>( entry.samples );
+        entry.used = ++this->uses;
+        // saved again on the next save
+        if ( entry.saved || entry.samples == 1 ) this->unsaved.push_back( hash );
+        entry.saved = false;
+        return entry.fitness;
+    }
+
+    /// <summary>
+    /// Retrieves and resets the number of evaluations skipped.
+    /// </summary>
+    /// <returns>Evaluations skipped since last call.</returns>
+    size_t const Fitness_Cache::takeSkipped()
+    {
+        size_t taken = this->skipped;
+        this->skipped = 0;
+        return taken;
+    }
+
+    /// <summary>
+    /// Appends the entries changed since the last save to file, if persisted.
+    /// </summary>
+    void Fitness_Cache::save()
+    {
+        if ( !Settings::FITNESS_CACHE_PERSIST )
+        {
+            this->unsaved.clear();
+            return;
+        }
+        std::ofstream myfile( "genomes/fitness_cache.txt", std::ios::app );
+        for ( unsigned long long const & hash : this->unsaved )
+        {
+            // evicted, or saved by an earlier change
+            auto entry = this->entries.find( hash );
+            if ( entry == this->entries.end() || entry->second.saved ) continue;
+            myfile << std::to_string( entry->first ) + " " + std::to_string( entry->second.fitness ) + " " + std::to_string( entry->second.samples ) + "\n";
+            entry->second.saved = true;
+        }
+        myfile.close();
+        this->unsaved.clear();
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Fitness_Cache utilities.                                              *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Evicts the least recently used quarter of the entries, once over Settings::FITNESS_CACHE_LIMIT.
+    /// </summary>
+    void Fitness_Cache::evict()
+    {
+        if ( this->entries.size() < Settings::FITNESS_CACHE_LIMIT ) return;
+        // use stamp of the last evicted entry, stamps are unique
+        std::vector<size_t> used = {};
+        used.reserve( this->entries.size() );
+        for ( auto const & entry : this->entries ) used.push_back( entry.second.used );
+        size_t const evicted = this->entries.size() - Settings::FITNESS_CACHE_LIMIT * 3 / 4;
+        std::nth_element( used.begin(), used.begin() + ( evicted - 1 ), used.end() );
+        size_t const last_evicted = used[ evicted - 1 ];
+        for ( auto entry = this->entries.begin(); entry != this->entries.end(); )
+        {
+            if ( entry->second.used <= last_evicted ) entry = this->entries.erase( entry );
+            else entry++;
+        }
+    }
+
+    /// <summary>
+    /// Rewrites the file with the current entries only.
+    /// </summary>
+    void Fitness_Cache::rewrite()
+    {
+        // oldest first, so the use order survives the next load
+        std::vector<std::pair<size_t, unsigned long long>> order = {};
+        order.reserve( this->entries.size() );
+        for ( auto const & entry : this->entries ) order.push_back( { entry.second.used, entry.first } );
+        std::sort( order.begin(), order.end() );
+        std::ofstream myfile( "genomes/fitness_cache.txt" );
+        for ( std::pair<size_t, unsigned long long> const & line : order )
+        {
+            Entry const & entry = this->entries[ line.second ];
+            myfile << std::to_string( line.second ) + " " + std::to_string( entry.fitness ) + " " + std::to_string( entry.samples ) + "\n";
+        }
+        myfile.close();
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Entry class.                                                          *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates an entry without samples.
+    /// </summary>
+    Fitness_Cache::Entry::Entry() : fitness( 0.0f ), samples( 0 ), used( 0 ), saved( false ) {}
+}
+
+#endif
@@ -0,0 +1,151 @@
+/***************************************************************************
+
+    file                 : Fitness_Cache.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_FITNESS_CACHE
+#define ROBOT_AXEL_FITNESS_CACHE
+
+#include <unordered_map>
+#include <vector>
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Evaluated fitness memory, keyed by genome structural hash, used to skip or re-sample episodes of repeated genomes.
+    /// </summary>
+    /// <remarks>
+    /// Holds at most Settings::FITNESS_CACHE_LIMIT genomes, evicting the least recently used ones.
+    /// The file is appended the entries changed since the last save, later lines replace earlier ones, and is rewritten on load once mostly stale.
+    /// </remarks>
+    class Fitness_Cache
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Entry class.                                                          *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Evaluation results of a genome.
+        /// </summary>
+        class Entry
+        {
+            // Friendship declarations
+            friend class Fitness_Cache;
+
+            /// <summary>
+            /// Average fitness of all samples.
+            /// </summary>
+            float fitness;
+            /// <summary>
+            /// Number of evaluations sampled.
+            /// </summary>
+            size_t samples;
+            /// <summary>
+            /// Cache use count of the last lookup or record.
+            /// </summary>
+            size_t used;
+            /// <summary>
+            /// Whenever the file holds the current samples.
+            /// </summary>
+            bool saved;
+
+            public:
+            /// <summary>
+            /// Generates an entry without samples.
+            /// </summary>
+            Entry();
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Fitness_Cache local constants and variables.                          *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Evaluation results by genome hash.
+        /// </summary>
+        std::unordered_map<unsigned long long, Entry> entries;
+        /// <summary>
+        /// Hashes of the entries changed since the last save, in change order.
+        /// </summary>
+        std::vector<unsigned long long> unsaved;
+        /// <summary>
+        /// Number of evaluations skipped with a cached fitness.
+        /// </summary>
+        size_t skipped;
+        /// <summary>
+        /// Lookups and records so far, stamping the entries use.
+        /// </summary>
+        size_t uses;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Fitness_Cache interface.                                              *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates the cache, loading the saved one if persisted.
+        /// </summary>
+        Fitness_Cache();
+
+        /// <summary>
+        /// Retrieves the fitness of a genome if it was sampled enough to skip its evaluation.
+        /// </summary>
+        /// <param name="hash">Genome hash.</param>
+        /// <param name="fitness">Average fitness, unchanged if not found.</param>
+        /// <returns>Whenever the evaluation can be skipped.</returns>
+        bool const lookup( unsigned long long const & hash, float & fitness );
+
+        /// <summary>
+        /// Records a finished evaluation of a genome.
+        /// </summary>
+        /// <param name="hash">Genome hash.</param>
+        /// <param name="fitness">Evaluated fitness.</param>
+        /// <returns>Average fitness of all the genome samples.</returns>
+        float const record( unsigned long long const & hash, float const & fitness );
+
+        /// <summary>
+        /// Retrieves and resets the number of evaluations skipped.
+        /// </summary>
+        /// <returns>Evaluations skipped since last call.</returns>
+        size_t const takeSkipped();
+
+        /// <summary>
+        /// Appends the entries changed since the last save to file, if persisted.
+        /// </summary>
+        void save();
+
+        /***************************************************************************
+         *                                                                         *
+         *   Fitness_Cache utilities.                                              *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Evicts the least recently used quarter of the entries, once over Settings::FITNESS_CACHE_LIMIT.
+        /// </summary>
+        void evict();
+
+        /// <summary>
+        /// Rewrites the file with the current entries only.
+        /// </summary>
+        void rewrite();
+    };
+}
+
+#endif
@@ -1,599 +1,966 @@
-/***************************************************************************
-
-    file                 : Genome.cpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#include "Genome.hpp"
-
-#if defined (ROBOT_AXEL_GENOME)
-
-#include <algorithm>
-#include <cmath>
-#include <cassert>
-
-#include <iostream>
-#include <fstream>
-#include <sys/stat.h>
-#include <dirent.h>
-#include <errno.h>
-
-namespace RobotAxel
-{
-    /***************************************************************************
-     *                                                                         *
-     *   Genome interface.                                                     *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Generate basic Genome.
-    /// </summary>
-    Genome::Genome( bool const & generate_top ) : fitness( 0 ), generation( 0 ), total_neurons( 0 ), network( {} )
-    {
-        if ( generate_top )
-        {
-            DIR* dir = opendir( "genomes/" );
-            if ( dir )
-            {
-                ;
-            }
-            else
-            {
-                mkdir( "genomes/", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH );
-            }
-
-            std::ifstream myfile( "genomes/top_genome_final.txt" );
-            std::string line;
-            if ( myfile.is_open() )
-            /*if(false)*/
-            {
-                getline( myfile, line );
-                this->generation = static_cast<size_t>( std::stof( line ) );
-                getline( myfile, line );
-                this->fitness = std::stof( line );
-                getline( myfile, line );
-                this->total_neurons = static_cast<size_t>( std::stof( line ) );
-
-                std::vector<std::string> genomeInfo;
-                std::string tmp_value;
-
-                while ( myfile >> tmp_value ) { genomeInfo.push_back( tmp_value ); }
-                size_t i = 0;
-                for ( i = 0; i < ( genomeInfo.size() / 4 ); i++ )
-                {
-                    Gene newGene = Gene(
-                        static_cast<size_t>( std::stof( genomeInfo[ i * 4 ] ) ),
-                        static_cast<size_t>( std::stof( genomeInfo[ ( i * 4 ) + 1 ] ) ),
-                        static_cast<bool>( std::stof( genomeInfo[ ( i * 4 ) + 3 ] ) )
-                    );
-                    newGene.weight = std::stof( genomeInfo[ ( i * 4 ) + 2 ] );
-                    this->network.push_back( newGene );
-                }
-                myfile.close();
-            }
-            else
-            {
-                // total neurons is equal to Inputs + Outputs
-                this->total_neurons = Settings::INPUTS + Settings::OUTPUTS;
-                // generate genes to fully connect each input to all outputs
-                if ( Settings::BASIC_FULL_LINK )
-                {
-                    for ( size_t output_index = Settings::INPUTS; output_index < this->total_neurons; output_index++ )
-                    {
-                        for ( size_t input_index = 0; input_index < Settings::INPUTS; input_index++ )
-                        {
-                            this->network.push_back( Gene( input_index, output_index, true ) );
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    /// <summary>
-    /// Retrieves AI gene number.
-    /// </summary>
-    /// <returns>AI total genes.</returns>
-    size_t Genome::getTotalGenes() const { return this->network.size(); }
-
-    /// <summary>
-    /// Retrieves AI neuron number.
-    /// </summary>
-    /// <returns>AI total neurons.</returns>
-    size_t Genome::getTotalNeurons() const { return this->total_neurons; }
-
-    /// <summary>
-    /// Retrieves AI generation.
-    /// </summary>
-    /// <returns>AI fitness.</returns>
-    size_t Genome::getGeneration() const { return this->generation; }
-
-    /// <summary>
-    /// Retrieves AI fitness.
-    /// </summary>
-    /// <returns>AI fitness.</returns>
-    float Genome::getFitness() const { return this->fitness; }
-
-    /// <summary>
-    /// Updates Genome's generation reference.
-    /// </summary>
-    /// <param name="generation">The new generation value.</param>
-    void Genome::setGeneration( size_t const & generation ) { this->generation = generation; }
-
-    /// <summary>
-    /// Updates Genome's fitness reference.
-    /// </summary>
-    /// <param name="fitness">The new fitness value.</param>
-    void Genome::setFitness( float const & fitness ) { this->fitness = fitness; }
-
-    /// <summary>
-    /// Calculates outputs according to the current network.
-    /// </summary>
-    /// <param name="outputs">Array with output neurons values.</param>
-    /// <param name="inputs">The input array used for the update.</param>
-    void Genome::evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
-    {
-        for ( size_t index = 0; index < Settings::INPUTS; index++ )
-        {
-            assert( inputs[ index ] >= 0.0f && inputs[ index ] <= 1.0f );
-        }
-        // no genes, do nothing
-        if ( this->network.empty() ) return;
-        // generate neuron network
-        std::vector<Neuron> neurons = {};
-        // fill with neurons
-        for ( size_t index = 0; index < this->total_neurons; index++ )
-        {
-            neurons.push_back( Neuron( index, this->network ) );
-        }
-        // update input neurons
-        for ( size_t index = 0; index < Settings::INPUTS; index++ )
-        {
-            neurons[ index ].value = inputs[ index ];
-        }
-
-        // update network
-        for ( size_t index = Settings::INPUTS; index < this->total_neurons; index++ )
-        {
-            // get neuron
-            Neuron & neuron = neurons[ index ];
-            // no incoming, continue
-            if ( neuron.incoming.empty() ) continue;
-            // calculate sum of all incoming genes values
-            for ( Gene const * incoming_gene : neuron.incoming )
-            {
-                if ( incoming_gene->enabled ) neuron.value += neurons[ incoming_gene->from ].value * incoming_gene->weight;
-            }
-            // treat sum result
-            neuron.value = ( Settings::SIGMOID_RANGE / ( 1 + std::exp( Settings::SIGMOID_GROWTH_RATE * neuron.value ) ) ) + Settings::SIGMOID_OFFSET;
-        }
-
-        size_t output_neuron_offset = this->total_neurons - Settings::OUTPUTS;
-        // retrieve outputs
-        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
-        {
-            assert( index < outputs.size() );
-            outputs[ index ] = neurons[ index + output_neuron_offset ].value;
-        }
-        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
-        {
-            assert( outputs[ index ] >= Settings::LINK_OFFSET && outputs[ index ] <= Settings::LINK_OFFSET + Settings::LINK_RANGE );
-        }
-    }
-
-    /// <summary>
-    /// Does one random mutation depending on the AI mutation settings.
-    /// </summary>
-    void Genome::mutate()
-    {
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // randomizes a chance, if below weight chance, trigger weight mutation
-        if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_CHANCE )
-        {
-            mutateWeight();
-        }
-        // randomizes a chance, if below node chance, trigger node mutation
-        if ( rng.generateRandom() < Settings::MUTATE_NODE_CHANCE && this->total_neurons < Settings::NEURON_LIMIT )
-        {
-            mutateNode();
-        }
-        // randomizes a chance, if below link chance, trigger link mutation
-        if ( rng.generateRandom() < Settings::MUTATE_LINK_CHANCE )
-        {
-            mutateLink();
-        }
-        // randomizes a chance, if below state chance, trigger state mutation
-        if ( rng.generateRandom() < Settings::MUTATE_STATE_CHANCE )
-        {
-            mutateState();
-        }
-    }
-
-    /// <summary>
-    /// Compares two genomes and retrieves % of disjoint genes (how many more new exist), and diference in weights of equal genes (same innovation num).
-    /// </summary>
-    /// <param name="other">Genome for comparison..</param>
-    /// <param name="disjoint">Disjoint rating.</param>
-    /// <param name="weights">Weight difference.</param>
-    void Genome::compare( Genome const & other, float & disjoint, float & weights ) const
-    {
-        // no genes in both, do nothing
-        if ( this->network.empty() && other.network.empty() ) return;
-        // reset given values
-        disjoint = 0.0f;
-        weights = 0.0f;
-
-        // number coincident
-        float coincident = 0.0f;
-        // maximum genes
-        float maximum_genes = static_cast<float>( std::max( this->network.size(), other.network.size() ) );
-
-        if ( this->network.empty() )
-        {
-            disjoint = 1.0f;
-            weights = 1.0f;
-            return;
-        }
-
-        // check for gene equalities and diferences ( equals are removed from other genes vector )
-        for ( Gene const & gene : this->network )
-        {
-            // found flag
-            bool found = false;
-            // cycle trough all other to find if exist equal
-            for ( Gene const & other_gene : other.network )
-            {
-                // check if have the same innovation
-                if ( gene.innovation == other_gene.innovation )
-                {
-                    // add to weights and increment coincident
-                    weights += fabsf( gene.weight - other_gene.weight );
-                    coincident += 1.0f;
-                    // stop cycle and change flag to found
-                    found = true;
-                    break;
-                }
-            }
-            // no equal found
-            if ( !found ) disjoint += 1.0f;
-        }
-        // update disjoint and weights
-        disjoint = ( disjoint + static_cast<float>( other.network.size() ) ) / maximum_genes;
-        weights = coincident == 0.0f ? 0.0f : weights / coincident;
-    }
-
-    /// <summary>
-    /// Creates a new genome form a crossover between this genome and another one given, with characteristics of both.
-    /// </summary>
-    /// <remarks>
-    /// The higher fitness genome should be the caller.
-    /// </remarks>
-    /// <param name="other">The genome for crossover</param>
-    /// <returns>A new genome with characteristics of both parents.</returns>
-    Genome Genome::crossover( Genome const & other ) const
-    {
-        // generated child
-        Genome child = Genome( *this );
-        // no genes, do nothing
-        if ( this->network.empty() && other.network.empty() ) return child;
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // child has the maximum number of neurons between parents
-        child.total_neurons = other.total_neurons < this->total_neurons ? this->total_neurons : other.total_neurons;
-        // looks for possible gene additions from other
-        for ( Gene const & other_gene : other.network )
-        {
-            // is gene found
-            bool found = false;
-            // find gene
-            for ( Gene const & gene : this->network )
-            {
-                if ( other_gene == gene )
-                {
-                    found = true;
-                    break;
-                }
-            }
-            // if not found chance add
-            if ( !found )
-            {
-                if ( rng.generateRandom() < Settings::CROSSOVER_GENE_ADDITION ) child.network.push_back( other_gene );
-            }
-        }
-        // return generated child
-        return child;
-    }
-
-    void Genome::serialize( bool finish_training )
-    {
-        std::ofstream myfile;
-        std::cout << "---------------------Writing in file " << "genomes/top_genome_generation_" + std::to_string( this->generation ) + "_fitness_" + std::to_string( this->fitness ) + ".txt" << "!------------------------" << std::endl;
-        std::string textFileName;
-        if ( finish_training )
-        {
-            textFileName = "genomes/top_genome_final.txt";
-        }
-        else
-        {
-            textFileName = "genomes/top_genome_generation_" + std::to_string( this->generation ) + "_fitness_" + std::to_string( this->fitness ) + ".txt";
-        }
-        myfile.open( textFileName );
-        // first line is generation
-        myfile << std::to_string( this->generation ) + "\n";
-        // second line fitness
-        myfile << std::to_string( this->fitness ) + "\n";
-        // third line total neurons
-        myfile << std::to_string( this->total_neurons ) + "\n";
-        // after all genes
-        for ( Gene const & gene : this->network )
-        {
-            myfile << std::to_string( gene.from ) + " " + std::to_string( gene.to ) + " " + std::to_string( gene.weight ) + " " + std::to_string( gene.enabled ) + "\n";
-        }
-
-        myfile.close();
-        std::cout << "Finished writing on file" << std::endl;
-
-    }
-
-    /***************************************************************************
-     *                                                                         *
-     *   Genome utilities.                                                     *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Either randomizes weight or makes a small mutation in weight of all genes.
-    /// </summary>
-    void Genome::mutateWeight()
-    {
-        // no genes, do nothing
-        if ( this->network.empty() ) return;
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // if chance type is below all chance, mutates all
-        if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_ALL_CHANCE )
-        {
-            // if below new random chance, randomizes all weights
-            if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_NEW_RANDOM_CHANCE ) { for ( Gene & gene : this->network ) gene.randomGeneWeight(); }
-            // otherwise deviates current chances
-            else { for ( Gene & gene : this->network ) gene.deviateGeneWeight(); }
-        }
-        // apply to a single random target
-        else
-        {
-            // randomizes target
-            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
-            assert( target_index < this->network.size() );
-
-            // change target
-            if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_NEW_RANDOM_CHANCE ) { this->network[ target_index ].randomGeneWeight(); }
-            // otherwise deviates current chances
-            else { this->network[ target_index ].deviateGeneWeight(); }
-
-        }
-    }
-
-    /// <summary>
-    /// Changes a random gene enabled state.
-    /// </summary>
-    void Genome::mutateState()
-    {
-        // no genes, do nothing
-        if ( this->network.empty() ) return;
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // change all genes in neuron
-        if ( rng.generateRandom() < Settings::MUTATE_STATE_INVERT_ALL_NEURON_GENES_CHANCE )
-        {
-            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->total_neurons ) ) );
-            assert( target_index < this->total_neurons );
-            // create target
-            Neuron target = Neuron( target_index, this->network );
-            // change all incoming enabled state
-            for ( Gene const * target_gene : target.incoming )
-            {
-                for ( Gene & gene : this->network )
-                {
-                    if ( *target_gene == gene )
-                    {
-                        gene.enabled = !gene.enabled;
-                        break;
-                    }
-                }
-            }
-        }
-        // change single gene
-        else
-        {
-            // randomizes target
-            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
-            assert( target_index < this->network.size() );
-            // change enabled state
-            this->network[ target_index ].enabled = !this->network[ target_index ].enabled;
-        }
-    }
-
-    /// <summary>
-    /// Creates a new link between two neurons if there is none.
-    /// </summary>
-    /// <remarks>
-    /// To maintain the evaluations correct, only creates links from lower neuron indexes to higher ones (prevents use of non yet evaluated neurons).
-    /// </remarks>
-    void Genome::mutateLink()
-    {
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // maximum range
-        size_t range = this->total_neurons;
-        // randomizes all neurons besides output
-        size_t non_output_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( range - Settings::OUTPUTS ) ) );
-        assert( non_output_index < range );
-        // randomizes all neurons besides input
-        size_t non_input_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( range - Settings::INPUTS ) ) ) + Settings::INPUTS;
-        assert( non_output_index < range );
-
-        // if same neuron, does nothing
-        if ( non_output_index == non_input_index ) return;
-
-        // random non-output neuron ( input + hidden ) and non-input neuron ( output + hidden )
-        Neuron non_output = Neuron( non_output_index, this->network );
-        Neuron non_input = Neuron( non_input_index, this->network );
-
-        // if already connected, does nothing
-        if ( non_output.hasLink( non_input_index ) || non_input.hasLink( non_output_index ) ) { return; }
-
-        // if non_output has lower index add link from non-input to non-output
-        if ( non_output_index < non_input_index ) { this->network.push_back( Gene( non_output_index, non_input_index, true ) ); }
-        // if non_input has lower index add link from non-output to non-input
-        if ( non_input_index < non_output_index ) { this->network.push_back( Gene( non_input_index, non_output_index, true ) ); }
-    }
-
-    /// <summary>
-    /// Generates a new node mutation, by transforming a gene into the same connection with a "middle-man". Original gene is disabled.
-    /// </summary>
-    /// <remarks>
-    /// Updates every other neuron gene connections from selected neuron with the changes in gene.from indexes.
-    /// </remarks>
-    void Genome::mutateNode()
-    {
-        // no genes, do nothing
-        if ( this->network.empty() ) return;
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // randomize target
-        size_t target_gene_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
-        assert( target_gene_index < this->network.size() );
-
-        // if gene is disabled, does nothing
-        if ( !this->network[ target_gene_index ].enabled ) return;
-
-        // disable gene
-        this->network[ target_gene_index ].enabled = false;
-
-        // target to neuron index in outputs use the last index before outputs for new neuron other wise use the gene.to value
-        size_t target_index = this->network[ target_gene_index ].to;
-        if ( this->total_neurons - Settings::OUTPUTS < this->network[ target_gene_index ].to ) { target_index = this->total_neurons - Settings::OUTPUTS; }
-        // increment total neurons in genome
-        this->total_neurons++;
-
-        // create genes
-        Gene bot_gene = Gene( this->network[ target_gene_index ].from, target_index, true );
-        Gene top_gene = Gene( target_index, this->network[ target_gene_index ].from, true );
-        // update all genes indexes
-        for ( Gene & gene : this->network )
-        {
-            if ( target_index <= gene.from ) { gene.from++; }
-            if ( target_index <= gene.to ) { gene.to++; }
-        }
-        // add new genes
-        this->network.push_back( bot_gene );
-        this->network.push_back( top_gene );
-    }
-
-    /***************************************************************************
-     *                                                                         *
-     *   Gene, Neuron and Network classes.                                     *
-     *                                                                         *
-     ***************************************************************************/
-    /// Generates a simple gene, with everything at 0 and not enabled.
-    /// </summary>
-    Genome::Gene::Gene()
-        : innovation( 0 ), from( 0 ), weight( 0 ), enabled( false ) {}
-
-    /// <summary>
-    /// Generates a gene with given settings.
-    /// </summary>
-    /// <param name="from">Input neuron index.</param>
-    /// <param name="enabled">Link connection status.</param>
-    Genome::Gene::Gene( size_t const & from, size_t const & to, bool const & enabled )
-        : innovation( Settings::newInnovation() ), from( from ), to( to ), weight( 0 ), enabled( enabled )
-    {
-        // randomizes a gene weight
-        randomGeneWeight();
-    }
-
-    /// <summary>
-    /// Deviates the current gene degree by a certain range.
-    /// </summary>
-    void Genome::Gene::deviateGeneWeight()
-    {
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-        // generates a random gene weight
-        this->weight += rng.generateRandom() * Settings::MUTATE_WEIGHT_DEVIATION_RANGE - Settings::MUTATE_WEIGHT_DEVIATION_RANGE / 2.0f;
-        // if over limits set to limit
-        if ( this->weight < Settings::LINK_OFFSET )
-        { this->weight = Settings::LINK_OFFSET; }
-        if ( this->weight > Settings::LINK_RANGE + Settings::LINK_OFFSET )
-        { this->weight = Settings::LINK_RANGE + Settings::LINK_OFFSET; }
-    }
-
-    /// <summary>
-    /// Deviates the current gene degree by a certain range.
-    /// </summary>
-    void Genome::Gene::randomGeneWeight()
-    {
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-        // generates a random gene weight
-        this->weight = rng.generateRandom() * Settings::LINK_RANGE + Settings::LINK_OFFSET;
-    }
-
-    /// <summary>
-    /// Checks if both neurons have the same reference.
-    /// </summary>
-    /// <param name="other">The one for comparison.</param>
-    /// <returns>Is equal.</returns>
-    bool const Genome::Gene::operator== ( Gene const & other ) const
-    {
-        if ( this == &other ) return true;
-        if ( this->innovation == other.innovation ) return true;
-        if ( this->from == other.from && this->to == other.to ) return true;
-        return false;
-    }
-
-    /// <summary>
-    /// Generates a simple Neuron.
-    /// </summary>
-    /// <param name="index">Neuron index.</param>
-    /// <param name="network">Gene network.</param>
-    Genome::Neuron::Neuron( size_t const & index, std::vector<Gene> const & network ) : incoming( {} ), value( 0 )
-    {
-        // if neuron input does nothing
-        if ( index < Settings::INPUTS ) return;
-        // otherwise find gene
-        for ( Gene const & gene : network )
-        {
-            if ( gene.to == index ) this->incoming.push_back( &gene );
-        }
-    }
-
-    /// <summary>
-    /// Checks if neuron already has link.
-    /// </summary>
-    /// <param name="neuron_index">Index of link to find.</param>
-    /// <returns>If neuron has link.</returns>
-    bool const Genome::Neuron::hasLink( size_t const & neuron_index ) const
-    {
-        for ( Gene const * gene : this->incoming )
-        {
-            if ( gene->from == neuron_index ) return true;
-        }
-        return false;
-    }
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Genome.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Genome.hpp"
+
+#if defined (ROBOT_AXEL_GENOME)
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cassert>
+
+#include <iostream>
+#include <fstream>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Genome interface.                                                     *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generate basic Genome.
+    /// </summary>
+    Genome::Genome( bool const & generate_top ) : fitness( 0 ), generation( 0 ), evaluated( false ), birth( 0 ), total_neurons( 0 ), network( {} )
+    {
+        if ( generate_top )
+        {
+            DIR* dir = opendir( "genomes/" );
+            if ( dir )
+            {
+                ;
+            }
+            else
+            {
+                mkdir( "genomes/", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH );
+            }
+
+            if ( !load( "genomes/top_genome_final.txt" ) )
+            {
+                // total neurons is equal to Inputs + Outputs
+                this->total_neurons = Settings::INPUTS + Settings::OUTPUTS;
+                // generate genes to fully connect each input to all outputs
+                if ( Settings::BASIC_FULL_LINK )
+                {
+                    for ( size_t output_index = Settings::INPUTS; output_index < this->total_neurons; output_index++ )
+                    {
+                        for ( size_t input_index = 0; input_index < Settings::INPUTS; input_index++ )
+                        {
+                            this->network.push_back( Gene( input_index, output_index, true ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Retrieves AI gene number.
+    /// </summary>
+    /// <returns>AI total genes.</returns>
+    size_t Genome::getTotalGenes() const { return this->network.size(); }
+
+    /// <summary>
+    /// Retrieves AI neuron number.
+    /// </summary>
+    /// <returns>AI total neurons.</returns>
+    size_t Genome::getTotalNeurons() const { return this->total_neurons; }
+
+    /// <summary>
+    /// Retrieves AI generation.
+    /// </summary>
+    /// <returns>AI fitness.</returns>
+    size_t Genome::getGeneration() const { return this->generation; }
+
+    /// <summary>
+    /// Retrieves AI fitness.
+    /// </summary>
+    /// <returns>AI fitness.</returns>
+    float Genome::getFitness() const { return this->fitness; }
+
+    /// <summary>
+    /// Retrieves if the AI fitness results from a finished evaluation.
+    /// </summary>
+    /// <returns>AI evaluation state.</returns>
+    bool Genome::isEvaluated() const { return this->evaluated; }
+
+    /// <summary>
+    /// Retrieves the steady-state evaluations finished before the genome was created.
+    /// </summary>
+    /// <returns>AI birth reference.</returns>
+    size_t Genome::getBirth() const { return this->birth; }
+
+    /// <summary>
+    /// Updates Genome's generation reference.
+    /// </summary>
+    /// <param name="generation">The new generation value.</param>
+    void Genome::setGeneration( size_t const & generation ) { this->generation = generation; }
+
+    /// <summary>
+    /// Updates Genome's fitness reference.
+    /// </summary>
+    /// <param name="fitness">The new fitness value.</param>
+    void Genome::setFitness( float const & fitness ) { this->fitness = fitness; }
+
+    /// <summary>
+    /// Updates Genome's evaluation state.
+    /// </summary>
+    /// <param name="evaluated">The new evaluation state.</param>
+    void Genome::setEvaluated( bool const & evaluated ) { this->evaluated = evaluated; }
+
+    /// <summary>
+    /// Updates Genome's birth reference.
+    /// </summary>
+    /// <param name="birth">The steady-state evaluations finished before the genome was created.</param>
+    void Genome::setBirth( size_t const & birth ) { this->birth = birth; }
+
+    /// <summary>
+    /// Calculates outputs according to the current network.
+    /// </summary>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void Genome::evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
+    {
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            assert( inputs[ index ] >= 0.0f && inputs[ index ] <= 1.0f );
+        }
+        // no genes, do nothing
+        if ( this->network.empty() ) return;
+        // generate neuron network
+        std::vector<Neuron> neurons = {};
+        // fill with neurons
+        for ( size_t index = 0; index < this->total_neurons; index++ )
+        {
+            neurons.push_back( Neuron( index, this->network ) );
+        }
+        // update input neurons
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            neurons[ index ].value = inputs[ index ];
+        }
+
+        // update network
+        for ( size_t index = Settings::INPUTS; index < this->total_neurons; index++ )
+        {
+            // get neuron
+            Neuron & neuron = neurons[ index ];
+            // no incoming, continue
+            if ( neuron.incoming.empty() ) continue;
+            // calculate sum of all incoming genes values
+            for ( Gene const * incoming_gene : neuron.incoming )
+            {
+                if ( incoming_gene->enabled ) neuron.value += neurons[ incoming_gene->from ].value * incoming_gene->weight;
+            }
+            // treat sum result
+            neuron.value = ( Settings::SIGMOID_RANGE / ( 1 + std::exp( Settings::SIGMOID_GROWTH_RATE * neuron.value ) ) ) + Settings::SIGMOID_OFFSET;
+        }
+
+        size_t output_neuron_offset = this->total_neurons - Settings::OUTPUTS;
+        // retrieve outputs
+        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
+        {
+            assert( index < outputs.size() );
+            outputs[ index ] = neurons[ index + output_neuron_offset ].value;
+        }
+        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
+        {
+            assert( outputs[ index ] >= Settings::LINK_OFFSET && outputs[ index ] <= Settings::LINK_OFFSET + Settings::LINK_RANGE );
+        }
+    }
+
+    /// <summary>
+    /// Does one random mutation depending on the AI mutation settings.
+    /// </summary>
+    void Genome::mutate()
+    {
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // randomizes a chance, if below weight chance, trigger weight mutation
+        if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_CHANCE )
+        {
+            mutateWeight();
+        }
+        // randomizes a chance, if below node chance, trigger node mutation
+        if ( rng.generateRandom() < Settings::MUTATE_NODE_CHANCE && this->total_neurons < Settings::NEURON_LIMIT )
+        {
+            mutateNode();
+        }
+        // randomizes a chance, if below link chance, trigger link mutation
+        if ( rng.generateRandom() < Settings::MUTATE_LINK_CHANCE )
+        {
+            mutateLink();
+        }
+        // randomizes a chance, if below state chance, trigger state mutation
+        if ( rng.generateRandom() < Settings::MUTATE_STATE_CHANCE )
+        {
+            mutateState();
+        }
+    }
+
+    /// <summary>
+    /// Compares two genomes and retrieves % of disjoint genes (how many more new exist), and diference in weights of equal genes (same innovation num).
+    /// </summary>
+    /// <param name="other">Genome for comparison..</param>
+    /// <param name="disjoint">Disjoint rating.</param>
+    /// <param name="weights">Weight difference.</param>
+    void Genome::compare( Genome const & other, float & disjoint, float & weights ) const
+    {
+        // no genes in both, do nothing
+        if ( this->network.empty() && other.network.empty() ) return;
+        // reset given values
+        disjoint = 0.0f;
+        weights = 0.0f;
+
+        // number coincident
+        float coincident = 0.0f;
+        // maximum genes
+        float maximum_genes = static_cast<float>( std::max( this->network.size(), other.network.size() ) );
+
+        if ( this->network.empty() )
+        {
+            disjoint = 1.0f;
+            weights = 1.0f;
+            return;
+        }
+
+        // check for gene equalities and diferences ( equals are removed from other genes vector )
+        for ( Gene const & gene : this->network )
+        {
+            // found flag
+            bool found = false;
+            // cycle trough all other to find if exist equal
+            for ( Gene const & other_gene : other.network )
+            {
+                // check if have the same innovation
+                if ( gene.innovation == other_gene.innovation )
+                {
+                    // add to weights and increment coincident
+                    weights += fabsf( gene.weight - other_gene.weight );
+                    coincident += 1.0f;
+                    // stop cycle and change flag to found
+                    found = true;
+                    break;
+                }
+            }
+            // no equal found
+            if ( !found ) disjoint += 1.0f;
+        }
+        // update disjoint and weights
+        disjoint = ( disjoint + static_cast<float>( other.network.size() ) ) / maximum_genes;
+        weights = coincident == 0.0f ? 0.0f : weights / coincident;
+    }
+
+    /// <summary>
+    /// Creates a new genome form a crossover between this genome and another one given, with characteristics of both.
+    /// </summary>
+    /// <remarks>
+    /// The higher fitness genome should be the caller.
+    /// </remarks>
+    /// <param name="other">The genome for crossover</param>
+    /// <returns>A new genome with characteristics of both parents.</returns>
+    Genome Genome::crossover( Genome const & other ) const
+    {
+        // generated child
+        Genome child = Genome( *this );
+        // no genes, do nothing
+        if ( this->network.empty() && other.network.empty() ) return child;
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // child has the maximum number of neurons between parents
+        child.total_neurons = other.total_neurons < this->total_neurons ? this->total_neurons : other.total_neurons;
+        // looks for possible gene additions from other
+        for ( Gene const & other_gene : other.network )
+        {
+            // is gene found
+            bool found = false;
+            // find gene
+            for ( Gene const & gene : this->network )
+            {
+                if ( other_gene == gene )
+                {
+                    found = true;
+                    break;
+                }
+            }
+            // if not found chance add
+            if ( !found )
+            {
+                if ( rng.generateRandom() < Settings::CROSSOVER_GENE_ADDITION ) child.network.push_back( other_gene );
+            }
+        }
+        // return generated child
+        return child;
+    }
+
+    /// <summary>
+    /// Measures the genome memory and the part of its network that can't affect the outputs.
+    /// </summary>
+    /// <param name="used">Bytes of the genome and its genes.</param>
+    /// <param name="capacity">Bytes of the genome and its gene buffer capacity.</param>
+    /// <param name="disabled_genes">Number of disabled genes.</param>
+    /// <param name="dead_neurons">Number of hidden neurons without enabled incoming or outgoing genes.</param>
+    void Genome::measureMemory( size_t & used, size_t & capacity, size_t & disabled_genes, size_t & dead_neurons ) const
+    {
+        used = sizeof( Genome ) + this->network.size() * sizeof( Gene );
+        capacity = sizeof( Genome ) + this->network.capacity() * sizeof( Gene );
+        disabled_genes = 0;
+        dead_neurons = 0;
+        // enabled links of every neuron, 1 for incoming and 2 for outgoing
+        std::vector<unsigned char> links( this->total_neurons, 0 );
+        for ( Gene const & gene : this->network )
+        {
+            if ( !gene.enabled )
+            {
+                disabled_genes++;
+                continue;
+            }
+            if ( gene.to < this->total_neurons ) links[ gene.to ] |= 1;
+            if ( gene.from < this->total_neurons ) links[ gene.from ] |= 2;
+        }
+        // hidden neurons lie between inputs and outputs
+        for ( size_t index = Settings::INPUTS; index + Settings::OUTPUTS < this->total_neurons; index++ )
+        {
+            if ( links[ index ] != 3 ) dead_neurons++;
+        }
+    }
+
+    /// <summary>
+    /// Removes the genes and hidden neurons that can never affect the outputs, keeping the outputs of every evaluation unchanged.
+    /// </summary>
+    /// <remarks>
+    /// Hidden neurons are kept while an enabled gene chain links them forward from a neuron with a value to an output, remaining neurons are renumbered in order.
+    /// Kept genes keep their innovation, so compare and crossover still align them with relatives.
+    /// A neuron with only ineffective incoming genes loses them all, the sigmoid of an empty sum is 0 as an unlinked neuron.
+    /// </remarks>
+    /// <param name="keep_history">Keeps every gene between kept neurons, disabled or not, for speciation and later re-enabling.</param>
+    /// <param name="removed_genes">Number of removed genes.</param>
+    /// <param name="removed_neurons">Number of removed hidden neurons.</param>
+    void Genome::compact( bool const & keep_history, size_t & removed_genes, size_t & removed_neurons )
+    {
+        removed_genes = 0;
+        removed_neurons = 0;
+        // no genes, nothing to remove
+        if ( this->network.empty() ) return;
+        size_t const neurons = this->total_neurons;
+        size_t const output_offset = neurons - Settings::OUTPUTS;
+        // a non-input neuron with any incoming gene applies the sigmoid, otherwise its value stays 0
+        std::vector<bool> connected( neurons, false );
+        for ( Gene const & gene : this->network )
+        {
+            if ( gene.to >= Settings::INPUTS && gene.to < neurons ) connected[ gene.to ] = true;
+        }
+        // only enabled forward or self links from a neuron with a value add to their destination, higher neurons are still 0 when read
+        auto contributes = [ & ]( Gene const & gene )
+        {
+            return gene.enabled && gene.to >= Settings::INPUTS && gene.to < neurons && gene.from <= gene.to && ( gene.from < Settings::INPUTS || connected[ gene.from ] );
+        };
+        // neurons reaching an output, marked from the highest origin down as forward links reach higher neurons
+        std::vector<size_t> forward = {};
+        for ( size_t index = 0; index < this->network.size(); index++ )
+        {
+            if ( contributes( this->network[ index ] ) && this->network[ index ].from < this->network[ index ].to ) forward.push_back( index );
+        }
+        std::sort( forward.begin(), forward.end(), [ this ]( size_t const & g1, size_t const & g2 ) { return this->network[ g1 ].from > this->network[ g2 ].from; } );
+        std::vector<bool> useful( neurons, false );
+        for ( size_t index = output_offset; index < neurons; index++ ) useful[ index ] = true;
+        for ( size_t const & index : forward )
+        {
+            if ( useful[ this->network[ index ].to ] ) useful[ this->network[ index ].from ] = true;
+        }
+        // effective genes and the neurons they link are kept, inputs and outputs always are
+        std::vector<bool> kept_neurons( neurons, false );
+        std::vector<bool> kept_genes( this->network.size(), false );
+        for ( size_t index = 0; index < neurons; index++ ) kept_neurons[ index ] = index < Settings::INPUTS || index >= output_offset;
+        for ( size_t index = 0; index < this->network.size(); index++ )
+        {
+            Gene const & gene = this->network[ index ];
+            if ( !contributes( gene ) || !useful[ gene.to ] ) continue;
+            kept_genes[ index ] = true;
+            kept_neurons[ gene.from ] = true;
+            kept_neurons[ gene.to ] = true;
+        }
+        // history keeps the remaining genes between kept neurons
+        if ( keep_history )
+        {
+            for ( size_t index = 0; index < this->network.size(); index++ )
+            {
+                Gene const & gene = this->network[ index ];
+                if ( gene.from < neurons && gene.to < neurons && kept_neurons[ gene.from ] && kept_neurons[ gene.to ] ) kept_genes[ index ] = true;
+            }
+        }
+        // kept neurons left without incoming genes stay 0, as they would with only ineffective ones
+        static_assert( Settings::SIGMOID_RANGE / 2.0f + Settings::SIGMOID_OFFSET == 0.0f, "compaction needs the sigmoid of 0 to be 0" );
+        // renumbers kept neurons in order, so every link keeps its direction
+        std::vector<size_t> renumbered( neurons, 0 );
+        size_t kept_total = 0;
+        for ( size_t index = 0; index < neurons; index++ )
+        {
+            renumbered[ index ] = kept_total;
+            if ( kept_neurons[ index ] ) kept_total++;
+        }
+        std::vector<Gene> network = {};
+        network.reserve( this->network.size() );
+        for ( size_t index = 0; index < this->network.size(); index++ )
+        {
+            if ( !kept_genes[ index ] ) continue;
+            Gene gene = this->network[ index ];
+            gene.from = renumbered[ gene.from ];
+            gene.to = renumbered[ gene.to ];
+            network.push_back( gene );
+        }
+        // an empty network evaluates nothing, unlike unlinked outputs
+        if ( network.empty() ) return;
+        removed_genes = this->network.size() - network.size();
+        removed_neurons = neurons - kept_total;
+        this->total_neurons = kept_total;
+        this->network = network;
+    }
+
+    /// <summary>
+    /// Calculates the genome structural hash, equal genomes have the same hash independently of gene order.
+    /// </summary>
+    /// <returns>Genome hash.</returns>
+    unsigned long long const Genome::hash() const
+    {
+        // splitmix64 finalizer
+        auto mix = []( unsigned long long value )
+        {
+            value ^= value >> 30;
+            value *= 0xBF58476D1CE4E5B9ull;
+            value ^= value >> 27;
+            value *= 0x94D049BB133111EBull;
+            value ^= value >> 31;
+            return value;
+        };
+        // neuron number is part of the structure
+        unsigned long long genome_hash = mix( this->total_neurons );
+        // genes are combined by addition, so gene order doesn't change the hash
+        for ( Gene const & gene : this->network )
+        {
+            unsigned int weight_bits = 0;
+            std::memcpy( &weight_bits, &gene.weight, sizeof( weight_bits ) );
+            unsigned long long gene_hash = mix( gene.innovation );
+            gene_hash = mix( gene_hash ^ ( static_cast<unsigned long long>( gene.from ) << 32 | gene.to ) );
+            gene_hash = mix( gene_hash ^ ( static_cast<unsigned long long>( weight_bits ) << 1 | ( gene.enabled ? 1 : 0 ) ) );
+            genome_hash += gene_hash;
+        }
+        return genome_hash;
+    }
+
+    /// <summary>
+    /// Calculates the genome MinHash signature over gene innovations, with the weight of every minimum gene as a weight sketch.
+    /// </summary>
+    /// <param name="hashes">Minimum innovation hash for every hash function.</param>
+    /// <param name="weights">Weight of the gene with the minimum hash for every hash function.</param>
+    void Genome::signature( std::array<unsigned int, Settings::SPECIES_INDEX_HASHES> & hashes, std::array<float, Settings::SPECIES_INDEX_HASHES> & weights ) const
+    {
+        // reset signature
+        hashes.fill( 0xFFFFFFFFu );
+        weights.fill( 0.0f );
+        // keep minimum of every hash function
+        for ( Gene const & gene : this->network )
+        {
+            for ( size_t function = 0; function < Settings::SPECIES_INDEX_HASHES; function++ )
+            {
+                // murmur3 finalizer over innovation and function seed
+                unsigned int hash = gene.innovation ^ ( static_cast<unsigned int>( function + 1 ) * 0x9E3779B9u );
+                hash ^= hash >> 16;
+                hash *= 0x85EBCA6Bu;
+                hash ^= hash >> 13;
+                hash *= 0xC2B2AE35u;
+                hash ^= hash >> 16;
+                if ( hash < hashes[ function ] )
+                {
+                    hashes[ function ] = hash;
+                    weights[ function ] = gene.weight;
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Writes the genome as the generation top genome, or as the final one, a compacted copy if Settings::COMPACT_CHAMPIONS.
+    /// </summary>
+    /// <param name="finish_training">Whenever the genome is written as the final one.</param>
+    /// <returns>Serialization console lines, for the caller to print.</returns>
+    std::string const Genome::serialize( bool finish_training ) const
+    {
+        std::string textFileName;
+        if ( finish_training )
+        {
+            textFileName = "genomes/top_genome_final.txt";
+        }
+        else
+        {
+            textFileName = "genomes/top_genome_generation_" + std::to_string( this->generation ) + "_fitness_" + std::to_string( this->fitness ) + ".txt";
+        }
+        std::string lines = "---------------------Writing in file " + textFileName + "!------------------------";
+        if ( !Settings::COMPACT_CHAMPIONS )
+        {
+            write( textFileName );
+            return lines + "\nFinished writing on file";
+        }
+        // champions are written without the genes that can't affect the outputs, the genome keeps its history for speciation and breeding
+        Genome champion = *this;
+        size_t removed_genes = 0, removed_neurons = 0;
+        champion.compact( false, removed_genes, removed_neurons );
+        champion.write( textFileName );
+        return lines + "\nCompacted " + std::to_string( removed_genes ) + " genes and " + std::to_string( removed_neurons ) + " neurons\nFinished writing on file";
+    }
+
+    /// <summary>
+    /// Replaces the genome by one written to a file, innovations are renumbered.
+    /// </summary>
+    /// <param name="file_name">Genome file name.</param>
+    /// <returns>Whenever the file was read.</returns>
+    bool const Genome::load( std::string const & file_name )
+    {
+        std::ifstream myfile( file_name );
+        std::string line;
+        if ( !myfile.is_open() ) return false;
+        this->network.clear();
+        getline( myfile, line );
+        this->generation = static_cast<size_t>( std::stof( line ) );
+        getline( myfile, line );
+        this->fitness = std::stof( line );
+        getline( myfile, line );
+        this->total_neurons = static_cast<size_t>( std::stof( line ) );
+
+        std::vector<std::string> genomeInfo;
+        std::string tmp_value;
+
+        while ( myfile >> tmp_value ) { genomeInfo.push_back( tmp_value ); }
+        size_t i = 0;
+        for ( i = 0; i < ( genomeInfo.size() / 4 ); i++ )
+        {
+            Gene newGene = Gene(
+                static_cast<size_t>( std::stof( genomeInfo[ i * 4 ] ) ),
+                static_cast<size_t>( std::stof( genomeInfo[ ( i * 4 ) + 1 ] ) ),
+                static_cast<bool>( std::stof( genomeInfo[ ( i * 4 ) + 3 ] ) )
+            );
+            newGene.weight = std::stof( genomeInfo[ ( i * 4 ) + 2 ] );
+            this->network.push_back( newGene );
+        }
+        myfile.close();
+        return true;
+    }
+
+    /// <summary>
+    /// Writes the genome to a file, generation, fitness and neurons first, then every gene.
+    /// </summary>
+    /// <param name="file_name">Genome file name.</param>
+    void Genome::write( std::string const & file_name ) const
+    {
+        std::ofstream myfile;
+        myfile.open( file_name );
+        // first line is generation
+        myfile << std::to_string( this->generation ) + "\n";
+        // second line fitness
+        myfile << std::to_string( this->fitness ) + "\n";
+        // third line total neurons
+        myfile << std::to_string( this->total_neurons ) + "\n";
+        // after all genes
+        for ( Gene const & gene : this->network )
+        {
+            myfile << std::to_string( gene.from ) + " " + std::to_string( gene.to ) + " " + std::to_string( gene.weight ) + " " + std::to_string( gene.enabled ) + "\n";
+        }
+
+        myfile.close();
+    }
+
+    /// <summary>
+    /// Removes the enabled genes of lowest weight magnitude, then compacts the genome.
+    /// </summary>
+    /// <param name="count">Number of enabled genes to remove.</param>
+    void Genome::pruneWeights( size_t const & count )
+    {
+        std::vector<Gene *> enabled = {};
+        for ( Gene & gene : this->network )
+        {
+            if ( gene.enabled ) enabled.push_back( &gene );
+        }
+        size_t const pruned = std::min( count, enabled.size() );
+        std::partial_sort(
+            enabled.begin(), enabled.begin() + pruned, enabled.end(),
+            []( Gene const * g1, Gene const * g2 ) { return std::fabs( g1->weight ) < std::fabs( g2->weight ); }
+        );
+        for ( size_t index = 0; index < pruned; index++ ) enabled[ index ]->enabled = false;
+        size_t removed_genes = 0, removed_neurons = 0;
+        compact( false, removed_genes, removed_neurons );
+    }
+
+    /// <summary>
+    /// Removes the hidden neurons of lowest outgoing weight magnitude, disabling their genes, then compacts the genome.
+    /// </summary>
+    /// <param name="count">Number of hidden neurons to remove.</param>
+    void Genome::pruneNeurons( size_t const & count )
+    {
+        size_t const output_offset = this->total_neurons - Settings::OUTPUTS;
+        if ( output_offset <= Settings::INPUTS ) return;
+        // outgoing magnitude of every hidden neuron
+        std::vector<float> magnitudes( output_offset - Settings::INPUTS, 0.0f );
+        for ( Gene const & gene : this->network )
+        {
+            if ( gene.enabled && gene.from >= Settings::INPUTS && gene.from < output_offset ) magnitudes[ gene.from - Settings::INPUTS ] += std::fabs( gene.weight );
+        }
+        std::vector<size_t> hidden( magnitudes.size(), 0 );
+        for ( size_t index = 0; index < hidden.size(); index++ ) hidden[ index ] = index;
+        size_t const pruned = std::min( count, hidden.size() );
+        std::partial_sort(
+            hidden.begin(), hidden.begin() + pruned, hidden.end(),
+            [ &magnitudes ]( size_t const & n1, size_t const & n2 ) { return magnitudes[ n1 ] < magnitudes[ n2 ]; }
+        );
+        std::vector<bool> removed( this->total_neurons, false );
+        for ( size_t index = 0; index < pruned; index++ ) removed[ hidden[ index ] + Settings::INPUTS ] = true;
+        for ( Gene & gene : this->network )
+        {
+            if ( ( gene.from < removed.size() && removed[ gene.from ] ) || ( gene.to < removed.size() && removed[ gene.to ] ) ) gene.enabled = false;
+        }
+        size_t removed_genes = 0, removed_neurons = 0;
+        compact( false, removed_genes, removed_neurons );
+    }
+
+    /// <summary>
+    /// Appends the genome in compact binary form, with fitness, neurons and genes only.
+    /// </summary>
+    /// <param name="bytes">Buffer to append to.</param>
+    void Genome::pack( std::vector<unsigned char> & bytes ) const
+    {
+        // appends the raw bytes of a value
+        auto write = [ &bytes ]( void const * value, size_t const size )
+        {
+            unsigned char const * raw = static_cast<unsigned char const *>( value );
+            bytes.insert( bytes.end(), raw, raw + size );
+        };
+        // header is fitness, neurons and gene count
+        unsigned short const neurons = static_cast<unsigned short>( this->total_neurons );
+        unsigned int const genes = static_cast<unsigned int>( this->network.size() );
+        write( &this->fitness, sizeof( float ) );
+        write( &neurons, sizeof( unsigned short ) );
+        write( &genes, sizeof( unsigned int ) );
+        // every gene is innovation, from, to, weight and state
+        for ( Gene const & gene : this->network )
+        {
+            unsigned short const from = static_cast<unsigned short>( gene.from );
+            unsigned short const to = static_cast<unsigned short>( gene.to );
+            unsigned char const enabled = gene.enabled ? 1 : 0;
+            write( &gene.innovation, sizeof( unsigned int ) );
+            write( &from, sizeof( unsigned short ) );
+            write( &to, sizeof( unsigned short ) );
+            write( &gene.weight, sizeof( float ) );
+            write( &enabled, sizeof( unsigned char ) );
+        }
+    }
+
+    /// <summary>
+    /// Replaces the genome by one in compact binary form, advancing the read position.
+    /// </summary>
+    /// <param name="position">Read position.</param>
+    /// <param name="end">End of the readable bytes.</param>
+    /// <returns>Whenever a complete and valid genome was read.</returns>
+    bool const Genome::unpack( unsigned char const * & position, unsigned char const * const end )
+    {
+        // reads the raw bytes of a value, if available
+        auto read = [ &position, end ]( void * value, size_t const size )
+        {
+            if ( static_cast<size_t>( end - position ) < size ) return false;
+            std::memcpy( value, position, size );
+            position += size;
+            return true;
+        };
+        float fitness = 0.0f;
+        unsigned short neurons = 0;
+        unsigned int genes = 0;
+        if ( !read( &fitness, sizeof( float ) ) || !read( &neurons, sizeof( unsigned short ) ) || !read( &genes, sizeof( unsigned int ) ) ) return false;
+        if ( neurons < Settings::INPUTS + Settings::OUTPUTS || neurons > Settings::NEURON_LIMIT ) return false;
+        std::vector<Gene> network = {};
+        for ( unsigned int gene_index = 0; gene_index < genes; gene_index++ )
+        {
+            Gene gene = Gene();
+            unsigned short from = 0;
+            unsigned short to = 0;
+            unsigned char enabled = 0;
+            if ( !read( &gene.innovation, sizeof( unsigned int ) ) || !read( &from, sizeof( unsigned short ) ) || !read( &to, sizeof( unsigned short ) ) ) return false;
+            if ( !read( &gene.weight, sizeof( float ) ) || !read( &enabled, sizeof( unsigned char ) ) ) return false;
+            if ( from >= neurons || to >= neurons ) return false;
+            gene.from = from;
+            gene.to = to;
+            gene.enabled = enabled != 0;
+            network.push_back( gene );
+        }
+        this->fitness = fitness;
+        this->total_neurons = neurons;
+        this->network = network;
+        return true;
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Genome utilities.                                                     *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Either randomizes weight or makes a small mutation in weight of all genes.
+    /// </summary>
+    void Genome::mutateWeight()
+    {
+        // no genes, do nothing
+        if ( this->network.empty() ) return;
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // if chance type is below all chance, mutates all
+        if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_ALL_CHANCE )
+        {
+            // if below new random chance, randomizes all weights
+            if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_NEW_RANDOM_CHANCE ) { for ( Gene & gene : this->network ) gene.randomGeneWeight(); }
+            // otherwise deviates current chances
+            else { for ( Gene & gene : this->network ) gene.deviateGeneWeight(); }
+        }
+        // apply to a single random target
+        else
+        {
+            // randomizes target
+            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
+            assert( target_index < this->network.size() );
+
+            // change target
+            if ( rng.generateRandom() < Settings::MUTATE_WEIGHT_NEW_RANDOM_CHANCE ) { this->network[ target_index ].randomGeneWeight(); }
+            // otherwise deviates current chances
+            else { this->network[ target_index ].deviateGeneWeight(); }
+
+        }
+    }
+
+    /// <summary>
+    /// Changes a random gene enabled state.
+    /// </summary>
+    void Genome::mutateState()
+    {
+        // no genes, do nothing
+        if ( this->network.empty() ) return;
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // change all genes in neuron
+        if ( rng.generateRandom() < Settings::MUTATE_STATE_INVERT_ALL_NEURON_GENES_CHANCE )
+        {
+            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->total_neurons ) ) );
+            assert( target_index < this->total_neurons );
+            // create target
+            Neuron target = Neuron( target_index, this->network );
+            // change all incoming enabled state
+            for ( Gene const * target_gene : target.incoming )
+            {
+                for ( Gene & gene : this->network )
+                {
+                    if ( *target_gene == gene )
+                    {
+                        gene.enabled = !gene.enabled;
+                        break;
+                    }
+                }
+            }
+        }
+        // change single gene
+        else
+        {
+            // randomizes target
+            size_t target_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
+            assert( target_index < this->network.size() );
+            // change enabled state
+            this->network[ target_index ].enabled = !this->network[ target_index ].enabled;
+        }
+    }
+
+    /// <summary>
+    /// Creates a new link between two neurons if there is none.
+    /// </summary>
+    /// <remarks>
+    /// To maintain the evaluations correct, only creates links from lower neuron indexes to higher ones (prevents use of non yet evaluated neurons).
+    /// </remarks>
+    void Genome::mutateLink()
+    {
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // maximum range
+        size_t range = this->total_neurons;
+        // randomizes all neurons besides output
+        size_t non_output_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( range - Settings::OUTPUTS ) ) );
+        assert( non_output_index < range );
+        // randomizes all neurons besides input
+        size_t non_input_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( range - Settings::INPUTS ) ) ) + Settings::INPUTS;
+        assert( non_output_index < range );
+
+        // if same neuron, does nothing
+        if ( non_output_index == non_input_index ) return;
+
+        // random non-output neuron ( input + hidden ) and non-input neuron ( output + hidden )
+        Neuron non_output = Neuron( non_output_index, this->network );
+        Neuron non_input = Neuron( non_input_index, this->network );
+
+        // if already connected, does nothing
+        if ( non_output.hasLink( non_input_index ) || non_input.hasLink( non_output_index ) ) { return; }
+
+        // if non_output has lower index add link from non-input to non-output
+        if ( non_output_index < non_input_index ) { this->network.push_back( Gene( non_output_index, non_input_index, true ) ); }
+        // if non_input has lower index add link from non-output to non-input
+        if ( non_input_index < non_output_index ) { this->network.push_back( Gene( non_input_index, non_output_index, true ) ); }
+    }
+
+    /// <summary>
+    /// Generates a new node mutation, by transforming a gene into the same connection with a "middle-man". Original gene is disabled.
+    /// </summary>
+    /// <remarks>
+    /// Updates every other neuron gene connections from selected neuron with the changes in gene.from indexes.
+    /// </remarks>
+    void Genome::mutateNode()
+    {
+        // no genes, do nothing
+        if ( this->network.empty() ) return;
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // randomize target
+        size_t target_gene_index = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->network.size() ) ) );
+        assert( target_gene_index < this->network.size() );
+
+        // if gene is disabled, does nothing
+        if ( !this->network[ target_gene_index ].enabled ) return;
+
+        // disable gene
+        this->network[ target_gene_index ].enabled = false;
+
+        // target to neuron index in outputs use the last index before outputs for new neuron other wise use the gene.to value
+        size_t target_index = this->network[ target_gene_index ].to;
+        if ( this->total_neurons - Settings::OUTPUTS < this->network[ target_gene_index ].to ) { target_index = this->total_neurons - Settings::OUTPUTS; }
+        // increment total neurons in genome
+        this->total_neurons++;
+
+        // create genes
+        Gene bot_gene = Gene( this->network[ target_gene_index ].from, target_index, true );
+        Gene top_gene = Gene( target_index, this->network[ target_gene_index ].from, true );
+        // update all genes indexes
+        for ( Gene & gene : this->network )
+        {
+            if ( target_index <= gene.from ) { gene.from++; }
+            if ( target_index <= gene.to ) { gene.to++; }
+        }
+        // add new genes
+        this->network.push_back( bot_gene );
+        this->network.push_back( top_gene );
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Gene, Neuron and Network classes.                                     *
+     *                                                                         *
+     ***************************************************************************/
+    /// Generates a simple gene, with everything at 0 and not enabled.
+    /// </summary>
+    Genome::Gene::Gene()
+        : innovation( 0 ), from( 0 ), weight( 0 ), enabled( false ) {}
+
+    /// <summary>
+    /// Generates a gene with given settings.
+    /// </summary>
+    /// <param name="from">Input neuron index.</param>
+    /// <param name="enabled">Link connection status.</param>
+    Genome::Gene::Gene( size_t const & from, size_t const & to, bool const & enabled )
+        : innovation( Settings::newInnovation() ), from( from ), to( to ), weight( 0 ), enabled( enabled )
+    {
+        // randomizes a gene weight
+        randomGeneWeight();
+    }
+
+    /// <summary>
+    /// Deviates the current gene degree by a certain range.
+    /// </summary>
+    void Genome::Gene::deviateGeneWeight()
+    {
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+        // generates a random gene weight
+        this->weight += rng.generateRandom() * Settings::MUTATE_WEIGHT_DEVIATION_RANGE - Settings::MUTATE_WEIGHT_DEVIATION_RANGE / 2.0f;
+        // if over limits set to limit
+        if ( this->weight < Settings::LINK_OFFSET )
+        { this->weight = Settings::LINK_OFFSET; }
+        if ( this->weight > Settings::LINK_RANGE + Settings::LINK_OFFSET )
+        { this->weight = Settings::LINK_RANGE + Settings::LINK_OFFSET; }
+    }
+
+    /// <summary>
+    /// Deviates the current gene degree by a certain range.
+    /// </summary>
+    void Genome::Gene::randomGeneWeight()
+    {
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+        // generates a random gene weight
+        this->weight = rng.generateRandom() * Settings::LINK_RANGE + Settings::LINK_OFFSET;
+    }
+
+    /// <summary>
+    /// Checks if both neurons have the same reference.
+    /// </summary>
+    /// <param name="other">The one for comparison.</param>
+    /// <returns>Is equal.</returns>
+    bool const Genome::Gene::operator== ( Gene const & other ) const
+    {
+        if ( this == &other ) return true;
+        if ( this->innovation == other.innovation ) return true;
+        if ( this->from == other.from && this->to == other.to ) return true;
+        return false;
+    }
+
+    /// <summary>
+    /// Generates a simple Neuron.
+    /// </summary>
+    /// <param name="index">Neuron index.</param>
+    /// <param name="network">Gene network.</param>
+    Genome::Neuron::Neuron( size_t const & index, std::vector<Gene> const & network ) : incoming( {} ), value( 0 )
+    {
+        // if neuron input does nothing
+        if ( index < Settings::INPUTS ) return;
+        // otherwise find gene
+        for ( Gene const & gene : network )
+        {
+            if ( gene.to == index ) this->incoming.push_back( &gene );
+        }
+    }
+
+    /// <summary>
+    /// Checks if neuron already has link.
+    /// </summary>
+    /// <param name="neuron_index">Index of link to find.</param>
+    /// <returns>If neuron has link.</returns>
+    bool const Genome::Neuron::hasLink( size_t const & neuron_index ) const
+    {
+        for ( Gene const * gene : this->incoming )
+        {
+            if ( gene->from == neuron_index ) return true;
+        }
+        return false;
+    }
+}
+
+#endif
@@ -1,272 +1,396 @@
-/***************************************************************************
-
-    file                 : Genome.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#pragma once
-
-#ifndef ROBOT_AXEL_GENOME
-#define ROBOT_AXEL_GENOME
-
-#include <array>
-#include <vector>
-#include "Random_Generator.hpp"
-#include "Settings.hpp"
-
-namespace RobotAxel
-{
-    /// <summary>
-    /// AI Brain, contains network that processes the inputs to outputs.
-    /// </summary>
-    class Genome
-    {
-        /***************************************************************************
-         *                                                                         *
-         *   Gene, Neuron and Network classes.                                     *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Node connection.
-        /// </summary>
-        class Gene
-        {
-            // Friendship declarations
-            friend class Genome;
-
-            private:
-            /// <summary>
-            /// Innovation reference.
-            /// </summary>
-            unsigned int innovation;
-            /// <summary>
-            /// Origin neuron index.
-            /// </summary>
-            size_t from;
-            /// <summary>
-            /// Destination neuron index.
-            /// </summary>
-            size_t to;
-            /// <summary>
-            /// Link weight.
-            /// </summary>
-            float weight;
-            /// <summary>
-            /// Activation state.
-            /// </summary>
-            bool enabled;
-
-            public:
-            /// <summary>
-            /// Generates a simple gene, with everything at 0, not enabled and without innovation number.
-            /// </summary>
-            Gene();
-
-            private:
-            /// <summary>
-            /// Generates a gene with given settings.
-            /// </summary>
-            /// <param name="from">Input neuron index.</param>
-            /// <param name="to">Output neuron index.</param>
-            /// <param name="enabled">Link connection status.</param>
-            Gene( size_t const & from, size_t const & to, bool const & enabled );
-
-            /// <summary>
-            /// Deviates the current gene degree by a certain range.
-            /// </summary>
-            void deviateGeneWeight();
-
-            /// <summary>
-            /// Randomizes a new weight value for a gene.
-            /// </summary>
-            /// <returns>A weight created according to settings.</returns>
-            void randomGeneWeight();
-
-            /// <summary>
-            /// Checks if both neurons have the same reference.
-            /// </summary>
-            /// <param name="other">The one for comparison.</param>
-            /// <returns>Is equal.</returns>
-            bool const operator== ( Gene const & other ) const;
-
-        };
-
-        /// <summary>
-        /// AI node, and list of incoming connections.
-        /// </summary>
-        class Neuron
-        {
-            // Friendship declarations
-            friend class Genome;
-
-            private:
-            /// <summary>
-            /// List of incoming genes indexes (empty in initial neurons).
-            /// </summary>
-            std::vector<Gene const *> incoming;
-            /// <summary>
-            /// Neuron output, (input in initial neurons).
-            /// </summary>
-            float value;
-
-            /// <summary>
-            /// Generates a simple Neuron.
-            /// </summary>
-            /// <param name="index">Neuron index.</param>
-            /// <param name="network">Gene network.</param>
-            Neuron( size_t const & index, std::vector<Gene> const & network );
-
-            /// <summary>
-            /// Checks if neuron already has link.
-            /// </summary>
-            /// <param name="neuron_index">Index of link to find.</param>
-            /// <returns>If neuron has link.</returns>
-            bool const hasLink( size_t const & neuron_index ) const;
-        };
-
-        /***************************************************************************
-         *                                                                         *
-         *   Genome local constants and variables.                                 *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Genome fitness.
-        /// </summary>
-        float fitness;
-        /// <summary>
-        /// AI Generation reference.
-        /// </summary>
-        size_t generation;
-        /// <summary>
-        /// Number of neurons.
-        /// </summary>
-        size_t total_neurons;
-        /// <summary>
-        /// AI brain structure.
-        /// </summary>
-        std::vector<Gene> network;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Genome interface.                                                     *
-         *                                                                         *
-         ***************************************************************************/
-        public:
-        /// <summary>
-        /// Generates a simple Genome if top genome isn't set. 
-        /// Otherwise either generates one from previous top from a file, if exists, or a basic one.
-        /// </summary>
-        Genome( bool const & generate_top = false );
-
-        /// <summary>
-        /// Retrieves AI gene number.
-        /// </summary>
-        /// <returns>AI total genes.</returns>
-        size_t getTotalGenes() const;
-
-        /// <summary>
-        /// Retrieves AI neuron number.
-        /// </summary>
-        /// <returns>AI total neurons.</returns>
-        size_t getTotalNeurons() const;
-
-        /// <summary>
-        /// Retrieves AI generation.
-        /// </summary>
-        /// <returns>AI fitness.</returns>
-        size_t getGeneration() const;
-
-        /// <summary>
-        /// Retrieves AI fitness.
-        /// </summary>
-        /// <returns>AI fitness.</returns>
-        float getFitness() const;
-
-        /// <summary>
-        /// Updates Genome's generation reference.
-        /// </summary>
-        /// <param name="generation">The new generation value.</param>
-        void setGeneration( size_t const & generation );
-
-        /// <summary>
-        /// Updates Genome's fitness reference.
-        /// </summary>
-        /// <param name="fitness">The new fitness value.</param>
-        void setFitness( float const & fitness );
-
-        /// <summary>
-        /// Calculates outputs according to the current network.
-        /// </summary>
-        /// <param name="outputs">Array with output neurons values.</param>
-        /// <param name="inputs">The input array used for the update.</param>
-        void evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
-
-        /// <summary>
-        /// Does one random mutation depending on the settings given.
-        /// </summary>
-        void mutate();
-
-        /// <summary>
-        /// Compares two genomes.
-        /// </summary>
-        /// <param name="other">Genome for comparison..</param>
-        /// <param name="disjoint">Disjoint rating.</param>
-        /// <param name="weights">Weight difference.</param>
-        void compare( Genome const & other, float & disjoint, float & weights ) const;
-
-        /// <summary>
-        /// Creates a new genome form a crossover between this genome and another one given, with characteristics of both.
-        /// </summary>
-        /// <remarks>
-        /// The higher fitness genome should be the caller.
-        /// </remarks>
-        /// <param name="other">The genome for crossover</param>
-        /// <returns>A new genome with characteristics of both parents.</returns>
-        Genome crossover( Genome const & other ) const;
-
-        void serialize( bool finish_training );
-
-        /***************************************************************************
-         *                                                                         *
-         *   Genome utilities.                                                     *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Either randomizes weight or makes a small mutation in weight of all genes.
-        /// </summary>
-        void mutateWeight();
-
-        /// <summary>
-        /// Changes a random gene enabled state.
-        /// </summary>
-        void mutateState();
-
-        /// <summary>
-        /// Creates a new link between two neurons if there is none.
-        /// </summary>
-        /// <remarks>
-        /// To maintain the evaluations correct, only creates links from lower neuron indexes to higher ones (prevents use of non yet evaluated neurons).
-        /// </remarks>
-        void mutateLink();
-
-        /// <summary>
-        /// Generates a new node mutation, by transforming a gene into the same connection with a "middle-man". Original gene is disabled.
-        /// </summary>
-        /// <remarks>
-        /// Updates every other neuron gene connections from selected neuron with the changes in gene.from indexes.
-        /// </remarks>
-        void mutateNode();
-    };
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Genome.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_GENOME
+#define ROBOT_AXEL_GENOME
+
+#include <array>
+#include <string>
+#include <vector>
+#include "Random_Generator.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// AI Brain, contains network that processes the inputs to outputs.
+    /// </summary>
+    class Genome
+    {
+        // Friendship declarations
+        friend class Phenotype;
+        friend class Benchmark;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gene, Neuron and Network classes.                                     *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Node connection.
+        /// </summary>
+        class Gene
+        {
+            // Friendship declarations
+            friend class Genome;
+            friend class Phenotype;
+            friend class Benchmark;
+
+            private:
+            /// <summary>
+            /// Innovation reference.
+            /// </summary>
+            unsigned int innovation;
+            /// <summary>
+            /// Origin neuron index.
+            /// </summary>
+            size_t from;
+            /// <summary>
+            /// Destination neuron index.
+            /// </summary>
+            size_t to;
+            /// <summary>
+            /// Link weight.
+            /// </summary>
+            float weight;
+            /// <summary>
+            /// Activation state.
+            /// </summary>
+            bool enabled;
+
+            public:
+            /// <summary>
+            /// Generates a simple gene, with everything at 0, not enabled and without innovation number.
+            /// </summary>
+            Gene();
+
+            private:
+            /// <summary>
+            /// Generates a gene with given settings.
+            /// </summary>
+            /// <param name="from">Input neuron index.</param>
+            /// <param name="to">Output neuron index.</param>
+            /// <param name="enabled">Link connection status.</param>
+            Gene( size_t const & from, size_t const & to, bool const & enabled );
+
+            /// <summary>
+            /// Deviates the current gene degree by a certain range.
+            /// </summary>
+            void deviateGeneWeight();
+
+            /// <summary>
+            /// Randomizes a new weight value for a gene.
+            /// </summary>
+            /// <returns>A weight created according to settings.</returns>
+            void randomGeneWeight();
+
+            /// <summary>
+            /// Checks if both neurons have the same reference.
+            /// </summary>
+            /// <param name="other">The one for comparison.</param>
+            /// <returns>Is equal.</returns>
+            bool const operator== ( Gene const & other ) const;
+
+        };
+
+        /// <summary>
+        /// AI node, and list of incoming connections.
+        /// </summary>
+        class Neuron
+        {
+            // Friendship declarations
+            friend class Genome;
+
+            private:
+            /// <summary>
+            /// List of incoming genes indexes (empty in initial neurons).
+            /// </summary>
+            std::vector<Gene const *> incoming;
+            /// <summary>
+            /// Neuron output, (input in initial neurons).
+            /// </summary>
+            float value;
+
+            /// <summary>
+            /// Generates a simple Neuron.
+            /// </summary>
+            /// <param name="index">Neuron index.</param>
+            /// <param name="network">Gene network.</param>
+            Neuron( size_t const & index, std::vector<Gene> const & network );
+
+            /// <summary>
+            /// Checks if neuron already has link.
+            /// </summary>
+            /// <param name="neuron_index">Index of link to find.</param>
+            /// <returns>If neuron has link.</returns>
+            bool const hasLink( size_t const & neuron_index ) const;
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Genome local constants and variables.                                 *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Genome fitness.
+        /// </summary>
+        float fitness;
+        /// <summary>
+        /// AI Generation reference.
+        /// </summary>
+        size_t generation;
+        /// <summary>
+        /// Whenever the fitness results from a finished evaluation.
+        /// </summary>
+        bool evaluated;
+        /// <summary>
+        /// Steady-state evaluations finished before the genome was created, its age reference ( Steady-state only ).
+        /// </summary>
+        size_t birth;
+        /// <summary>
+        /// Number of neurons.
+        /// </summary>
+        size_t total_neurons;
+        /// <summary>
+        /// AI brain structure.
+        /// </summary>
+        std::vector<Gene> network;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Genome interface.                                                     *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates a simple Genome if top genome isn't set. 
+        /// Otherwise either generates one from previous top from a file, if exists, or a basic one.
+        /// </summary>
+        Genome( bool const & generate_top = false );
+
+        /// <summary>
+        /// Retrieves AI gene number.
+        /// </summary>
+        /// <returns>AI total genes.</returns>
+        size_t getTotalGenes() const;
+
+        /// <summary>
+        /// Retrieves AI neuron number.
+        /// </summary>
+        /// <returns>AI total neurons.</returns>
+        size_t getTotalNeurons() const;
+
+        /// <summary>
+        /// Retrieves AI generation.
+        /// </summary>
+        /// <returns>AI fitness.</returns>
+        size_t getGeneration() const;
+
+        /// <summary>
+        /// Retrieves AI fitness.
+        /// </summary>
+        /// <returns>AI fitness.</returns>
+        float getFitness() const;
+
+        /// <summary>
+        /// Retrieves if the AI fitness results from a finished evaluation.
+        /// </summary>
+        /// <returns>AI evaluation state.</returns>
+        bool isEvaluated() const;
+
+        /// <summary>
+        /// Retrieves the steady-state evaluations finished before the genome was created.
+        /// </summary>
+        /// <returns>AI birth reference.</returns>
+        size_t getBirth() const;
+
+        /// <summary>
+        /// Updates Genome's generation reference.
+        /// </summary>
+        /// <param name="generation">The new generation value.</param>
+        void setGeneration( size_t const & generation );
+
+        /// <summary>
+        /// Updates Genome's fitness reference.
+        /// </summary>
+        /// <param name="fitness">The new fitness value.</param>
+        void setFitness( float const & fitness );
+
+        /// <summary>
+        /// Updates Genome's evaluation state.
+        /// </summary>
+        /// <param name="evaluated">The new evaluation state.</param>
+        void setEvaluated( bool const & evaluated );
+
+        /// <summary>
+        /// Updates Genome's birth reference.
+        /// </summary>
+        /// <param name="birth">The steady-state evaluations finished before the genome was created.</param>
+        void setBirth( size_t const & birth );
+
+        /// <summary>
+        /// Calculates outputs according to the current network.
+        /// </summary>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
+
+        /// <summary>
+        /// Does one random mutation depending on the settings given.
+        /// </summary>
+        void mutate();
+
+        /// <summary>
+        /// Compares two genomes.
+        /// </summary>
+        /// <param name="other">Genome for comparison..</param>
+        /// <param name="disjoint">Disjoint rating.</param>
+        /// <param name="weights">Weight difference.</param>
+        void compare( Genome const & other, float & disjoint, float & weights ) const;
+
+        /// <summary>
+        /// Creates a new genome form a crossover between this genome and another one given, with characteristics of both.
+        /// </summary>
+        /// <remarks>
+        /// The higher fitness genome should be the caller.
+        /// </remarks>
+        /// <param name="other">The genome for crossover</param>
+        /// <returns>A new genome with characteristics of both parents.</returns>
+        Genome crossover( Genome const & other ) const;
+
+        /// <summary>
+        /// Calculates the genome structural hash, equal genomes have the same hash independently of gene order.
+        /// </summary>
+        /// <returns>Genome hash.</returns>
+        unsigned long long const hash() const;
+
+        /// <summary>
+        /// Measures the genome memory and the part of its network that can't affect the outputs.
+        /// </summary>
+        /// <param name="used">Bytes of the genome and its genes.</param>
+        /// <param name="capacity">Bytes of the genome and its gene buffer capacity.</param>
+        /// <param name="disabled_genes">Number of disabled genes.</param>
+        /// <param name="dead_neurons">Number of hidden neurons without enabled incoming or outgoing genes.</param>
+        void measureMemory( size_t & used, size_t & capacity, size_t & disabled_genes, size_t & dead_neurons ) const;
+
+        /// <summary>
+        /// Removes the genes and hidden neurons that can never affect the outputs, keeping the outputs of every evaluation unchanged.
+        /// </summary>
+        /// <remarks>
+        /// Hidden neurons are kept while an enabled gene chain links them forward from a neuron with a value to an output, remaining neurons are renumbered in order.
+        /// Kept genes keep their innovation, so compare and crossover still align them with relatives.
+        /// A neuron with only ineffective incoming genes loses them all, the sigmoid of an empty sum is 0 as an unlinked neuron.
+        /// </remarks>
+        /// <param name="keep_history">Keeps every gene between kept neurons, disabled or not, for speciation and later re-enabling.</param>
+        /// <param name="removed_genes">Number of removed genes.</param>
+        /// <param name="removed_neurons">Number of removed hidden neurons.</param>
+        void compact( bool const & keep_history, size_t & removed_genes, size_t & removed_neurons );
+
+        /// <summary>
+        /// Calculates the genome MinHash signature over gene innovations, with the weight of every minimum gene as a weight sketch.
+        /// </summary>
+        /// <param name="hashes">Minimum innovation hash for every hash function.</param>
+        /// <param name="weights">Weight of the gene with the minimum hash for every hash function.</param>
+        void signature( std::array<unsigned int, Settings::SPECIES_INDEX_HASHES> & hashes, std::array<float, Settings::SPECIES_INDEX_HASHES> & weights ) const;
+
+        /// <summary>
+        /// Writes the genome as the generation top genome, or as the final one, a compacted copy if Settings::COMPACT_CHAMPIONS.
+        /// </summary>
+        /// <param name="finish_training">Whenever the genome is written as the final one.</param>
+        /// <returns>Serialization console lines, for the caller to print.</returns>
+        std::string const serialize( bool finish_training ) const;
+
+        /// <summary>
+        /// Replaces the genome by one written to a file, innovations are renumbered.
+        /// </summary>
+        /// <param name="file_name">Genome file name.</param>
+        /// <returns>Whenever the file was read.</returns>
+        bool const load( std::string const & file_name );
+
+        /// <summary>
+        /// Writes the genome to a file, generation, fitness and neurons first, then every gene.
+        /// </summary>
+        /// <param name="file_name">Genome file name.</param>
+        void write( std::string const & file_name ) const;
+
+        /// <summary>
+        /// Removes the enabled genes of lowest weight magnitude, then compacts the genome.
+        /// </summary>
+        /// <remarks>
+        /// Lossy, the outputs change, for deployment only.
+        /// </remarks>
+        /// <param name="count">Number of enabled genes to remove.</param>
+        void pruneWeights( size_t const & count );
+
+        /// <summary>
+        /// Removes the hidden neurons of lowest outgoing weight magnitude, disabling their genes, then compacts the genome.
+        /// </summary>
+        /// <remarks>
+        /// Lossy, the outputs change, for deployment only.
+        /// </remarks>
+        /// <param name="count">Number of hidden neurons to remove.</param>
+        void pruneNeurons( size_t const & count );
+
+        /// <summary>
+        /// Appends the genome in compact binary form, with fitness, neurons and genes only.
+        /// </summary>
+        /// <param name="bytes">Buffer to append to.</param>
+        void pack( std::vector<unsigned char> & bytes ) const;
+
+        /// <summary>
+        /// Replaces the genome by one in compact binary form, advancing the read position.
+        /// </summary>
+        /// <param name="position">Read position.</param>
+        /// <param name="end">End of the readable bytes.</param>
+        /// <returns>Whenever a complete and valid genome was read.</returns>
+        bool const unpack( unsigned char const * & position, unsigned char const * const end );
+
+        /***************************************************************************
+         *                                                                         *
+         *   Genome utilities.                                                     *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Either randomizes weight or makes a small mutation in weight of all genes.
+        /// </summary>
+        void mutateWeight();
+
+        /// <summary>
+        /// Changes a random gene enabled state.
+        /// </summary>
+        void mutateState();
+
+        /// <summary>
+        /// Creates a new link between two neurons if there is none.
+        /// </summary>
+        /// <remarks>
+        /// To maintain the evaluations correct, only creates links from lower neuron indexes to higher ones (prevents use of non yet evaluated neurons).
+        /// </remarks>
+        void mutateLink();
+
+        /// <summary>
+        /// Generates a new node mutation, by transforming a gene into the same connection with a "middle-man". Original gene is disabled.
+        /// </summary>
+        /// <remarks>
+        /// Updates every other neuron gene connections from selected neuron with the changes in gene.from indexes.
+        /// </remarks>
+        void mutateNode();
+    };
+}
+
+#endif
@@ -1,419 +1,1356 @@
-/***************************************************************************
-
-    file                 : Gym.cpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#include "Gym.hpp"
-
-#if defined (ROBOT_AXEL_GYM)
-
-#include <algorithm>
-#include <iostream>
-#include <cassert>
-
-namespace RobotAxel
-{
-    /***************************************************************************
-     *                                                                         *
-     *   Gym interface.                                                        *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Generates gym with initial population
-    /// </summary>
-    Gym::Gym() : all_species( {} ), current_species( 0 ), current_genome( 0 ), generation( 0 ), top_fitness_genome( Genome( true ) )
-    {
-        this->generation = top_fitness_genome.getGeneration();
-        // create a base population of top genome mutation
-        for ( size_t individual = 0; individual < Settings::GYM_POPULATION; individual++ )
-        {
-            Genome new_genome = Genome( top_fitness_genome );
-            assert( new_genome.getTotalGenes() == top_fitness_genome.getTotalGenes() && new_genome.getTotalNeurons() == top_fitness_genome.getTotalNeurons() );
-            // mutate and add
-            new_genome.mutate();
-            addGenomeToRespectiveSpecies( new_genome );
-        }
-    }
-
-    /// <summary>
-    /// Save top_genome before deleting gym.
-    /// </summary>
-    Gym::~Gym()
-    {
-        // if last genome before quitting is better save as top
-        if ( top_fitness_genome.getFitness() < currentGenome().getFitness() )
-        {
-            currentGenome().serialize( true );
-        }
-        // if not serializes top
-        else
-        {
-            top_fitness_genome.serialize( true );
-        }
-    }
-
-    /// <summary>
-    /// Calculates outputs according to the current network, using the Gym or the top Genome.
-    /// </summary>
-    /// <param name="outputs">Array with output neurons values.</param>
-    /// <param name="inputs">The input array used for the update.</param>
-    void Gym::evaluateCurrent( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
-    {
-        currentGenome().evaluate( outputs, inputs );
-    }
-
-    /// <summary>
-    /// Updates current Genome's fitness reference.
-    /// </summary>
-    /// <param name="fitness">The fitness of the previous evaluation.</param>
-    void Gym::appraiseCurrent( float const & fitness )
-    {
-        currentGenome().setFitness( fitness );
-    }
-
-    /// <summary>
-    /// Indicates the Gym to advance to the next Genome, for the fitness test. If all species were evaluated advances generation.
-    /// </summary>
-    void Gym::advanceInTrain()
-    {
-        // increment current genome
-        this->current_genome++;
-        // check if over current species genome list size
-        if ( current_genome < this->all_species[ this->current_species ].genomes.size() ) return;
-        // increment current species and set current genome to 0
-        this->current_species++;
-        this->current_genome = 0;
-        // check if over species list size
-        if ( current_species < this->all_species.size() ) return;
-        // set current species to 0
-        this->current_species = 0;
-        // advance generation if all species were fully evaluated
-        advanceGeneration();
-    }
-
-    /// <summary>
-    /// Retrieves current training generation and species number in generation, as well current top fitness.
-    /// </summary>
-    /// <param name="generation">Current AI generation.</param>
-    /// <param name="species">Number of species in generation.</param>
-    /// <param name="fitness">Current fitness.</param>
-    /// <param name="top_fitness">Current maximum fitness.</param>
-    /// <param name="top_genes">Top gene number.</param>
-    /// <param name="top_neurons">Top neuron number.</param>
-    void Gym::getInformation( size_t & generation, size_t & species, float & fitness, float & top_fitness, size_t & top_genes, size_t & top_neurons ) const
-    {
-        generation = this->generation;
-        species = this->all_species.size();
-        fitness = currentGenome().getFitness();
-        top_fitness = this->top_fitness_genome.getFitness();
-        top_genes = this->top_fitness_genome.getTotalGenes();
-        top_neurons = this->top_fitness_genome.getTotalNeurons();
-    }
-
-    /***************************************************************************
-     *                                                                         *
-     *   Gym utilities.                                                        *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Retrieves current genome in training.
-    /// </summary>
-    /// <returns>The current genome reference.</returns>
-    Genome const & Gym::currentGenome() const
-    {
-        return this->all_species[ this->current_species ].genomes[ this->current_genome ];
-    }
-
-    /// <summary>
-    /// Retrieves current genome in training.
-    /// </summary>
-    /// <returns>The current genome reference.</returns>
-    Genome & Gym::currentGenome()
-    {
-        return this->all_species[ this->current_species ].genomes[ this->current_genome ];
-    }
-
-    /// <summary>
-    /// Adds genome to a similar species, if none is found creates one for it.
-    /// </summary>
-    /// <param name="genome">Genome to add.</param>
-    void Gym::addGenomeToRespectiveSpecies( Genome & genome )
-    {
-        // try to add to an existent species if from same species
-        for ( Species & species : this->all_species )
-        {
-            if ( species.fromSpecies( genome ) )
-            {
-                species.genomes.push_back( genome );
-                return;
-            }
-        }
-        // add to new created species otherwise
-        Species new_species = Species();
-        new_species.genomes.push_back( genome );
-        this->all_species.push_back( new_species );
-    }
-
-    /// <summary>
-    /// Advances generation by:
-    ///     - Culling half of every species;
-    ///     - Removing stale species;
-    ///     - Remove weak species;
-    ///     - Breed new children
-    ///     - Culling everything but top species;
-    ///     - Add children to species.
-    /// </summary>
-    void Gym::advanceGeneration()
-    {
-        assert( !this->all_species.empty() );
-        // cull half species
-        cullSpecies( true );
-        // remove stale species
-        removeStaleSpecies();
-        // remove weak species
-        removeWeakSpecies();
-        // set new top fitness genome
-        this->top_fitness_genome = Genome( this->all_species[ 0 ].genomes[ 0 ] );
-        // serializing in file
-        this->top_fitness_genome.serialize( false );
-        // children list
-        std::vector<Genome> children = breedChildren();
-        // cull all but best genome on all species
-        cullSpecies();
-        // add mutated children to species
-        for ( Genome & child : children )
-        {
-            child.mutate();
-            addGenomeToRespectiveSpecies( child );
-        }
-        // advance generation
-        this->generation++;
-        for ( Species & species : this->all_species )
-        {
-            for ( Genome & genome : species.genomes )
-            {
-                genome.setGeneration( this->generation );
-            }
-        }
-    }
-
-    /// <summary>
-    /// Eliminates either half or every but the best genome in every species, also orders every specie's genomes by descending order.
-    /// </summary>
-    /// <param name="half_cull">Trigger half culling or full culling.</param>
-    void Gym::cullSpecies( bool const & half_cull )
-    {
-        for ( Species & species : this->all_species )
-        {
-            // single genome species
-            if ( species.genomes.size() == 1 )
-            {
-                return;
-            }
-            // sort in descending fitness order
-            std::sort(
-                species.genomes.begin(), species.genomes.end(),
-                []( Genome & g1, Genome & g2 ) { return g1.getFitness() > g2.getFitness(); }
-            );
-            // set cull limit
-            size_t remaining = half_cull ? species.genomes.size() / 2 : 1;
-            // cull species to remaining count
-            species.genomes.erase( species.genomes.begin() + remaining, species.genomes.end() );
-        }
-    }
-
-    /// <summary>
-    /// Removes all stale species from current generation. Also orders species by their best genome fitness.
-    /// </summary>
-    /// <remarks>
-    /// A specie is considered stale if has over Settings::SPECIES_STALE_THRESHOLD genomes and no progress was made.
-    /// </remarks>
-    void Gym::removeStaleSpecies()
-    {
-        // single species
-        if ( this->all_species.size() == 1 )
-        {
-            return;
-        }
-        // sort species in descending order
-        std::sort(
-            this->all_species.begin(), this->all_species.end(),
-            []( Species & s1, Species & s2 ) { return s1.genomes[ 0 ].getFitness() > s2.genomes[ 0 ].getFitness(); }
-        );
-        // species iterator from beginning
-        auto species_iterator = this->all_species.begin() + 1;
-        // remove all stale species
-        while ( species_iterator != this->all_species.end() )
-        {
-            if ( species_iterator->genomes.size() < Settings::SPECIES_STALE_THRESHOLD )
-            {
-                species_iterator = this->all_species.erase( species_iterator );
-            }
-            else
-            {
-                species_iterator++;
-            }
-        }
-    }
-
-    /// <summary>
-    /// Removes all weak species from current generation.
-    /// </summary>
-    /// <remarks>
-    /// A specie is considered weak if has no breed chance.
-    /// </remarks>
-    void Gym::removeWeakSpecies()
-    {
-        // single species
-        if ( this->all_species.size() == 1 )
-        {
-            return;
-        }
-        // total average fitness
-        float total_average_fitness = totalAverageFitness();
-        // species iterator from beginning
-        auto species_iterator = this->all_species.begin() + 1;
-        // remove all weak species
-        while ( species_iterator != this->all_species.end() )
-        {
-            if ( species_iterator->speciesBreedCount( total_average_fitness ) < Settings::SPECIES_BREED_THRESHOLD )
-            {
-                species_iterator = this->all_species.erase( species_iterator );
-            }
-            else
-            {
-                species_iterator++;
-            }
-        }
-    }
-
-    /// <summary>
-    /// Calculates the total average fitness of all species.
-    /// </summary>
-    /// <returns>The total average calculated fitness.</returns>
-    float const Gym::totalAverageFitness() const
-    {
-        // sum of all species's average fitness
-        float total = 0.0f;
-        // calculate sum
-        for ( Species const & species : this->all_species )
-        {
-            total += species.averageFitness();
-        }
-        // return the average of all genomes sizes
-        return total;
-    }
-
-    /// <summary>
-    /// Breed all children till population target.
-    /// </summary>
-    /// <returns>The breed children.</returns>
-    std::vector<Genome> const Gym::breedChildren() const
-    {
-        // bread children
-        std::vector<Genome> children = {};
-        // total average fitness
-        float total_average_fitness = totalAverageFitness();
-        // for every species bread it's children
-        for ( Species const & species : this->all_species )
-        {
-            // species breed count
-            size_t breedCount = species.speciesBreedCount( total_average_fitness );
-            // breed till breed count
-            for ( size_t breed = 0; breed < breedCount; breed++ )
-            {
-                children.push_back( species.breedChild() );
-            }
-        }
-        // return all created children
-        return children;
-    }
-
-    /***************************************************************************
-     *                                                                         *
-     *   Species class.                                                        *
-     *                                                                         *
-     ***************************************************************************/
-    /// <summary>
-    /// Generates a simple species.
-    /// </summary>
-    Gym::Species::Species() : genomes( {} ) {}
-
-    /// <summary>
-    /// Checks if given genome belongs to species.
-    /// </summary>
-    /// <param name="genome">Genome to check.</param>
-    /// <returns>Whenever genome belongs to species.</returns>
-    bool const Gym::Species::fromSpecies( Genome const & genome ) const
-    {
-        // initialise values
-        float disjoint = 0.0f;
-        float weights = 0.0f;
-        // compare with first
-        this->genomes[ 0 ].compare( genome, disjoint, weights );
-        // update
-        disjoint = Settings::SPECIES_DELTA_DIJOINT * disjoint;
-        weights = Settings::SPECIES_DELTA_WEIGHTS * weights;
-        // if sum of disjoint and weights over threshold, not from species
-        return disjoint + weights < Settings::SPECIES_DELTA_THRESHOLD;
-    }
-
-    /// <summary>
-    /// Average fitness from a species.
-    /// </summary>
-    float const Gym::Species::averageFitness() const
-    {
-        // sum of all genome's fitness
-        float total = 0.0f;
-        // calculate sum
-        for ( Genome const & genome : this->genomes )
-        {
-            total += genome.getFitness();
-        }
-        // return the average of all genomes sizes
-        return this->genomes.empty() ? total : total / static_cast<float>( this->genomes.size() );
-    }
-
-    /// <summary>
-    /// Calculates the species total offspring to reach the target population in comparison to all other species.
-    /// </summary>
-    /// <param name="species">Species for breed count</param>
-    /// <returns>Breed count.</returns>
-    size_t const Gym::Species::speciesBreedCount( float const & total_average_fitness ) const
-    {
-        return static_cast<size_t>( std::floor( ( averageFitness() / total_average_fitness ) * static_cast<float>( Settings::GYM_POPULATION ) ) ) - 1;
-    }
-
-    /// <summary>
-    /// Breed a new genome from this species.
-    /// </summary>
-    /// <returns>Breed child.</returns>
-    Genome Gym::Species::breedChild() const
-    {
-        // retrieve god
-        Random_Generator & rng = Random_Generator::getInstance();
-
-        // uses always top species parent as base
-        Genome const & parent_one = this->genomes[ 0 ];
-        // if below crossover change, crossover a new gene
-        if ( rng.generateRandom() < Settings::CROSSOVER_CHANCE )
-        {
-            size_t parent_index_two = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->genomes.size() ) ) );
-            Genome const & parent_two = this->genomes[ parent_index_two ];
-            // return generated child
-            return parent_one.crossover( parent_two );
-        }
-        // otherwise copy a of the species top genome
-        return Genome( parent_one );
-    }
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Gym.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Gym.hpp"
+
+#if defined (ROBOT_AXEL_GYM)
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <cassert>
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Gym interface.                                                        *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates gym with initial population
+    /// </summary>
+    /// <param name="population">Target population.</param>
+    Gym::Gym( size_t const & population ) : population( population ), all_species( {} ), current_species( 0 ), current_genome( 0 ), generation( 0 ), top_fitness_genome( Genome( true ) ), replacements( 0 ), evaluations( 0 ),
+        fitness_cache( Fitness_Cache() ), current_curve( {} ), current_bound( std::numeric_limits<float>::infinity() ), curves( {} ), contenders( {} ), rung_contenders( {} ), rung( 0 ), rung_position( 0 ),
+        island(), leases( {} ), next_lease( 0 ), returned_leases( 0 ), generation_phases( {} ), memory_high_water( 0 ), upcoming( {} ),
+        print_line( []( std::string const & line ) { std::cout << line << std::endl; } ),
+        append_file( []( std::string const & file_name, std::string const & contents ) { std::ofstream file( file_name, std::ios::app ); file << contents; } ), pipeline()
+    {
+        this->upcoming.reserve( Settings::PREPARED_PHENOTYPES );
+        this->generation = top_fitness_genome.getGeneration();
+        // every island builds the same top genome, new innovations are shared from here on
+        this->island.shareInnovation();
+        // create a base population of top genome mutation
+        std::vector<Genome> initial_population = {};
+        for ( size_t individual = 0; individual < this->population; individual++ )
+        {
+            Genome new_genome = Genome( top_fitness_genome );
+            assert( new_genome.getTotalGenes() == top_fitness_genome.getTotalGenes() && new_genome.getTotalNeurons() == top_fitness_genome.getTotalNeurons() );
+            // mutate
+            new_genome.mutate();
+            initial_population.push_back( new_genome );
+        }
+        // add to species
+        addGenomesToRespectiveSpecies( initial_population );
+        // race the first rung
+        startHalving();
+        // lease the first generation
+        startLeasing();
+        // skip already evaluated genomes
+        while ( skipCachedGenome() ) advanceGenome();
+    }
+
+    /// <summary>
+    /// Save top_genome before deleting gym.
+    /// </summary>
+    Gym::~Gym()
+    {
+        // if last genome before quitting is better save as top
+        if ( top_fitness_genome.getFitness() < currentGenome().getFitness() )
+        {
+            this->print_line( currentGenome().serialize( true ) );
+        }
+        // if not serializes top
+        else
+        {
+            this->print_line( top_fitness_genome.serialize( true ) );
+        }
+        // save evaluated fitness
+        this->fitness_cache.save();
+    }
+
+    /// <summary>
+    /// Calculates outputs according to the current network, using the Gym or the top Genome.
+    /// </summary>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void Gym::evaluateCurrent( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
+    {
+        currentGenome().evaluate( outputs, inputs );
+    }
+
+    /// <summary>
+    /// Compiles the current Genome network, or takes it prepared, then prepares the next ones in background.
+    /// </summary>
+    /// <remarks>
+    /// Only genomes of the current generation, or rung, are prepared, a restart at its end compiles the first genome of the next one.
+    /// Prepared phenotypes are told apart by genome address, so advanceGeneration and advanceSteadyState clear the pipeline before the population changes.
+    /// </remarks>
+    /// <param name="phenotype">Phenotype to build.</param>
+    void Gym::compileCurrent( Phenotype & phenotype )
+    {
+        if ( !this->pipeline.take( currentGenome(), phenotype ) ) phenotype.build( currentGenome() );
+        // steady-state children are only known once bred
+        if ( Settings::PREPARED_PHENOTYPES == 0 || Settings::GYM_STEADY_STATE ) return;
+        this->upcoming.clear();
+        if ( Settings::HALVING )
+        {
+            for ( size_t position = this->rung_position + 1; position < this->rung_contenders.size() && this->upcoming.size() < Settings::PREPARED_PHENOTYPES; position++ )
+            {
+                Contender const & contender = this->contenders[ this->rung_contenders[ position ] ];
+                this->upcoming.push_back( &this->all_species[ contender.species ].genomes[ contender.genome ] );
+            }
+        }
+        else
+        {
+            size_t species_index = this->current_species, genome_index = this->current_genome + 1;
+            while ( species_index < this->all_species.size() && this->upcoming.size() < Settings::PREPARED_PHENOTYPES )
+            {
+                if ( genome_index < this->all_species[ species_index ].genomes.size() )
+                {
+                    this->upcoming.push_back( &this->all_species[ species_index ].genomes[ genome_index ] );
+                    genome_index++;
+                }
+                else
+                {
+                    species_index++;
+                    genome_index = 0;
+                }
+            }
+        }
+        this->pipeline.prepare( this->upcoming, phenotype );
+    }
+
+    /// <summary>
+    /// Updates current Genome's fitness reference.
+    /// </summary>
+    /// <param name="fitness">The fitness of the previous evaluation.</param>
+    /// <param name="time">Evaluation time, in [s].</param>
+    /// <param name="bound">Upper bound of the final fitness of the evaluation, unbounded if unknown.</param>
+    void Gym::appraiseCurrent( float const & fitness, float const & time, float const & bound )
+    {
+        currentGenome().setFitness( fitness );
+        this->current_bound = bound;
+        // sample progress curve
+        if ( !Settings::EARLY_ABORT || !Settings::EARLY_ABORT_ELITE_CURVES ) return;
+        while ( static_cast<float>( this->current_curve.size() ) * Settings::EARLY_ABORT_INTERVAL <= time )
+        {
+            this->current_curve.push_back( fitness );
+        }
+    }
+
+    /// <summary>
+    /// Checks if the current Genome can no longer reach its species survival threshold.
+    /// </summary>
+    /// <remarks>
+    /// Ends evaluations whose progress bound is below the threshold.
+    /// With Settings::EARLY_ABORT_ELITE_CURVES also ends the ones whose progress plus Settings::EARLY_ABORT_SAFETY times the highest gain of a species survivor, from the same time till its end, is below it.
+    /// </remarks>
+    /// <returns>Whenever the evaluation should be terminated.</returns>
+    bool const Gym::abortCurrent() const
+    {
+        if ( !Settings::EARLY_ABORT || !fullEvaluation() ) return false;
+        Species const & species = this->all_species[ this->current_species ];
+        // unknown threshold
+        if ( species.survival_threshold <= 0.0f ) return false;
+        // even at top speed till the time limit, genome stays below threshold
+        if ( this->current_bound < species.survival_threshold ) return true;
+        if ( !Settings::EARLY_ABORT_ELITE_CURVES || this->current_curve.empty() ) return false;
+        // too soon
+        size_t sample = this->current_curve.size() - 1;
+        if ( static_cast<float>( sample ) * Settings::EARLY_ABORT_INTERVAL < Settings::EARLY_ABORT_MIN_TIME ) return false;
+        // no elite raced this long, no bound
+        if ( species.elite_gains.size() <= sample ) return false;
+        // even gaining more than any elite, genome stays below threshold
+        return currentGenome().getFitness() + Settings::EARLY_ABORT_SAFETY * species.elite_gains[ sample ] < species.survival_threshold;
+    }
+
+    /// <summary>
+    /// Retrieves the evaluation horizon of the current Genome, after which its evaluation should end.
+    /// </summary>
+    /// <returns>Horizon in [s], 0 if the full evaluation is raced.</returns>
+    float const Gym::currentHorizon() const
+    {
+        if ( fullEvaluation() ) return 0.0f;
+        // every rung is eta times longer than the previous
+        float horizon = Settings::HALVING_BASE_HORIZON;
+        for ( size_t rung_index = 0; rung_index < this->rung; rung_index++ )
+        {
+            horizon *= static_cast<float>( Settings::HALVING_ETA );
+        }
+        return horizon;
+    }
+
+    /// <summary>
+    /// Indicates the Gym to advance to the next Genome, for the fitness test. If all species were evaluated advances generation.
+    /// </summary>
+    /// <param name="complete">Whenever the evaluation ran to its end, aborted and horizon cut ones are neither cached nor kept as progress curves.</param>
+    void Gym::advanceInTrain( bool const & complete )
+    {
+        // record finished evaluation, repeated genomes use the average of their samples, a cut one would be skipped with its partial fitness
+        bool const finished = complete && fullEvaluation();
+        if ( Settings::FITNESS_CACHE && finished )
+        {
+            currentGenome().setFitness( this->fitness_cache.record( currentGenome().hash(), currentGenome().getFitness() ) );
+        }
+        // keep finished progress curve, a cut one would understate the elite gains
+        this->current_bound = std::numeric_limits<float>::infinity();
+        if ( Settings::EARLY_ABORT && Settings::EARLY_ABORT_ELITE_CURVES )
+        {
+            if ( finished ) this->curves[ currentGenome().hash() ] = this->current_curve;
+            this->current_curve.clear();
+        }
+        // advance till a genome requiring evaluation is found
+        do
+        {
+            advanceGenome();
+        }
+        while ( skipCachedGenome() );
+    }
+
+    /// <summary>
+    /// Leases the next genome of the generation requiring evaluation, to a car racing alongside others.
+    /// </summary>
+    /// <remarks>
+    /// Leases follow the generation order, the generation advances once every genome returned.
+    /// Genomes in the fitness cache return at once, early termination and successive halving only apply to a single car, steady-state training can't lease and fails the fleet build.
+    /// </remarks>
+    /// <param name="lease">Leased genome identifier, valid till returned.</param>
+    /// <returns>Whenever a genome was leased, false while the remaining genomes of the generation are leased.</returns>
+    bool const Gym::leaseGenome( size_t & lease )
+    {
+        assert( !Settings::GYM_STEADY_STATE );
+        // a cached last genome advances generation and restarts leasing
+        while ( this->next_lease < this->leases.size() )
+        {
+            lease = this->next_lease;
+            this->next_lease++;
+            Contender const & contender = this->leases[ lease ];
+            Genome & genome = this->all_species[ contender.species ].genomes[ contender.genome ];
+            // cached fitness
+            float fitness = 0.0f;
+            if ( Settings::FITNESS_CACHE && this->fitness_cache.lookup( genome.hash(), fitness ) )
+            {
+                genome.setFitness( fitness );
+                completeLease();
+                continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Calculates outputs according to a leased genome network.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void Gym::evaluateLeased( size_t const & lease, std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const
+    {
+        Contender const & contender = this->leases[ lease ];
+        this->all_species[ contender.species ].genomes[ contender.genome ].evaluate( outputs, inputs );
+    }
+
+    /// <summary>
+    /// Compiles a leased genome network, or takes it prepared, then prepares the next leases in background.
+    /// </summary>
+    /// <remarks>
+    /// Prepared phenotypes are told apart by genome address, leases only end in advanceGeneration, which clears the pipeline before the population changes.
+    /// </remarks>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="phenotype">Phenotype to build.</param>
+    void Gym::compileLeased( size_t const & lease, Phenotype & phenotype )
+    {
+        Contender const & contender = this->leases[ lease ];
+        Genome const & genome = this->all_species[ contender.species ].genomes[ contender.genome ];
+        if ( !this->pipeline.take( genome, phenotype ) ) phenotype.build( genome );
+        if ( Settings::PREPARED_PHENOTYPES == 0 ) return;
+        // leases follow the generation order
+        this->upcoming.clear();
+        for ( size_t next = this->next_lease; next < this->leases.size() && this->upcoming.size() < Settings::PREPARED_PHENOTYPES; next++ )
+        {
+            this->upcoming.push_back( &this->all_species[ this->leases[ next ].species ].genomes[ this->leases[ next ].genome ] );
+        }
+        this->pipeline.prepare( this->upcoming, phenotype );
+    }
+
+    /// <summary>
+    /// Returns a leased genome with the fitness of its evaluation.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="fitness">The fitness of the evaluation.</param>
+    void Gym::returnGenome( size_t const & lease, float const & fitness )
+    {
+        assert( lease < this->next_lease );
+        Contender const & contender = this->leases[ lease ];
+        Genome & genome = this->all_species[ contender.species ].genomes[ contender.genome ];
+        // repeated genomes use the average of their samples
+        genome.setFitness( Settings::FITNESS_CACHE ? this->fitness_cache.record( genome.hash(), fitness ) : fitness );
+        completeLease();
+    }
+
+    /// <summary>
+    /// Describes the current Genome, for its evaluation telemetry.
+    /// </summary>
+    /// <param name="generation">Current AI generation.</param>
+    /// <param name="species">Genome species index.</param>
+    /// <param name="hash">Genome structural hash.</param>
+    /// <param name="genes">Genome gene number.</param>
+    /// <param name="neurons">Genome neuron number.</param>
+    void Gym::describeCurrent( size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const
+    {
+        Genome const & genome = currentGenome();
+        generation = this->generation;
+        species = this->current_species;
+        hash = genome.hash();
+        genes = genome.getTotalGenes();
+        neurons = genome.getTotalNeurons();
+    }
+
+    /// <summary>
+    /// Describes a leased genome, for its evaluation telemetry.
+    /// </summary>
+    /// <param name="lease">Leased genome identifier.</param>
+    /// <param name="generation">Current AI generation.</param>
+    /// <param name="species">Genome species index.</param>
+    /// <param name="hash">Genome structural hash.</param>
+    /// <param name="genes">Genome gene number.</param>
+    /// <param name="neurons">Genome neuron number.</param>
+    void Gym::describeLeased( size_t const & lease, size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const
+    {
+        Contender const & contender = this->leases[ lease ];
+        Genome const & genome = this->all_species[ contender.species ].genomes[ contender.genome ];
+        generation = this->generation;
+        species = contender.species;
+        hash = genome.hash();
+        genes = genome.getTotalGenes();
+        neurons = genome.getTotalNeurons();
+    }
+
+    /// <summary>
+    /// Retrieves current training generation and species number in generation, as well current top fitness.
+    /// </summary>
+    /// <param name="generation">Current AI generation.</param>
+    /// <param name="species">Number of species in generation.</param>
+    /// <param name="fitness">Current fitness.</param>
+    /// <param name="top_fitness">Current maximum fitness.</param>
+    /// <param name="top_genes">Top gene number.</param>
+    /// <param name="top_neurons">Top neuron number.</param>
+    void Gym::getInformation( size_t & generation, size_t & species, float & fitness, float & top_fitness, size_t & top_genes, size_t & top_neurons ) const
+    {
+        generation = this->generation;
+        species = this->all_species.size();
+        fitness = currentGenome().getFitness();
+        top_fitness = this->top_fitness_genome.getFitness();
+        top_genes = this->top_fitness_genome.getTotalGenes();
+        top_neurons = this->top_fitness_genome.getTotalNeurons();
+    }
+
+    /// <summary>
+    /// Redirects the generation console lines and reports, so a driver can write them away from its driving thread.
+    /// </summary>
+    /// <param name="print">Prints a console line, without its end.</param>
+    /// <param name="append">Appends contents to a file, by file name and contents.</param>
+    void Gym::redirectOutput( std::function<void( std::string const & )> const & print, std::function<void( std::string const &, std::string const & )> const & append )
+    {
+        this->print_line = print;
+        this->append_file = append;
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Gym utilities.                                                        *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Retrieves current genome in training.
+    /// </summary>
+    /// <returns>The current genome reference.</returns>
+    Genome const & Gym::currentGenome() const
+    {
+        return this->all_species[ this->current_species ].genomes[ this->current_genome ];
+    }
+
+    /// <summary>
+    /// Retrieves current genome in training.
+    /// </summary>
+    /// <returns>The current genome reference.</returns>
+    Genome & Gym::currentGenome()
+    {
+        return this->all_species[ this->current_species ].genomes[ this->current_genome ];
+    }
+
+    /// <summary>
+    /// Advances to the next Genome, if all species were evaluated advances generation.
+    /// </summary>
+    void Gym::advanceGenome()
+    {
+        // steady-state evolution replaces genomes one at a time
+        if ( Settings::GYM_STEADY_STATE ) return advanceSteadyState();
+        // successive halving races rungs before advancing generation
+        if ( Settings::HALVING ) return advanceHalving();
+        // increment current genome
+        this->current_genome++;
+        // check if over current species genome list size
+        if ( current_genome < this->all_species[ this->current_species ].genomes.size() ) return;
+        // increment current species and set current genome to 0
+        this->current_species++;
+        this->current_genome = 0;
+        // check if over species list size
+        if ( current_species < this->all_species.size() ) return;
+        // set current species to 0
+        this->current_species = 0;
+        // advance generation if all species were fully evaluated
+        advanceGeneration();
+    }
+
+    /// <summary>
+    /// Uses the cached fitness of the current genome instead of evaluating it, if it was sampled enough.
+    /// </summary>
+    /// <returns>Whenever the current genome evaluation was skipped.</returns>
+    bool const Gym::skipCachedGenome()
+    {
+        if ( !Settings::FITNESS_CACHE || !fullEvaluation() ) return false;
+        // cached fitness
+        float fitness = 0.0f;
+        if ( !this->fitness_cache.lookup( currentGenome().hash(), fitness ) ) return false;
+        currentGenome().setFitness( fitness );
+        return true;
+    }
+
+    /// <summary>
+    /// Adds genome to a similar species, if none is found creates one for it.
+    /// </summary>
+    /// <param name="genome">Genome to add.</param>
+    /// <param name="first_species">Index of the first species to compare with.</param>
+    /// <returns>Index of the species that received the genome.</returns>
+    size_t const Gym::addGenomeToRespectiveSpecies( Genome & genome, size_t const & first_species )
+    {
+        // try to add to an existent species if from same species
+        for ( size_t species_index = first_species; species_index < this->all_species.size(); species_index++ )
+        {
+            Species & species = this->all_species[ species_index ];
+            if ( species.fromSpecies( genome ) )
+            {
+                species.genomes.push_back( genome );
+                return species_index;
+            }
+        }
+        // add to new created species otherwise
+        Species new_species = Species();
+        new_species.genomes.push_back( genome );
+        this->all_species.push_back( new_species );
+        return this->all_species.size() - 1;
+    }
+
+    /// <summary>
+    /// Adds a batch of genomes to similar species, comparing them with the current species in parallel and assigning them in batch order.
+    /// </summary>
+    /// <remarks>
+    /// Results are the same as adding each genome in order with addGenomeToRespectiveSpecies.
+    /// Genomes matching no current species open new ones in rounds, every round compares the genomes left with the last opened species in parallel.
+    /// </remarks>
+    /// <param name="genomes">Genomes to add.</param>
+    void Gym::addGenomesToRespectiveSpecies( std::vector<Genome> & genomes )
+    {
+        // species representatives don't change while adding, genomes are only appended
+        size_t const existing_species = this->all_species.size();
+        // first matching existing species of every genome, existing species number if none
+        std::vector<size_t> matches( genomes.size(), existing_species );
+        // comparison workers for a number of genomes, leaving out threads without a worthy share
+        size_t const maximum_workers = Settings::SPECIATION_THREADS == 0 ? std::thread::hardware_concurrency() : Settings::SPECIATION_THREADS;
+        auto workers_for = [ & ]( size_t const compared ) { return std::max<size_t>( 1, std::min( maximum_workers, compared / Settings::SPECIATION_MIN_SHARE ) ); };
+        // runs the comparisons of every worker, this thread takes the first share
+        auto run_workers = [ & ]( size_t const workers, std::function<void( size_t const, size_t const )> const & compare )
+        {
+            std::vector<std::thread> threads = {};
+            for ( size_t worker = 1; worker < workers; worker++ ) threads.push_back( std::thread( compare, worker, workers ) );
+            compare( 0, workers );
+            for ( std::thread & thread : threads ) thread.join();
+        };
+        // index species representatives when there are enough species to prune
+        bool const indexed = Settings::SPECIES_INDEX_MIN_SPECIES != 0 && Settings::SPECIES_INDEX_MIN_SPECIES <= existing_species;
+        Species_Index index = Species_Index();
+        if ( indexed )
+        {
+            for ( size_t species_index = 0; species_index < existing_species; species_index++ )
+            {
+                index.insert( this->all_species[ species_index ].genomes[ 0 ] );
+            }
+        }
+        // compares every worker genome against the existing species representatives
+        auto match_genomes = [ & ]( size_t const worker, size_t const workers )
+        {
+            std::vector<size_t> candidates = {};
+            for ( size_t genome_index = worker; genome_index < genomes.size(); genome_index += workers )
+            {
+                Genome const & genome = genomes[ genome_index ];
+                // full comparison
+                if ( !indexed )
+                {
+                    for ( size_t species_index = 0; species_index < existing_species; species_index++ )
+                    {
+                        if ( this->all_species[ species_index ].fromSpecies( genome ) )
+                        {
+                            matches[ genome_index ] = species_index;
+                            break;
+                        }
+                    }
+                    continue;
+                }
+                // candidates comparison
+                index.candidates( genome, candidates );
+                for ( size_t const & species_index : candidates )
+                {
+                    if ( this->all_species[ species_index ].fromSpecies( genome ) )
+                    {
+                        matches[ genome_index ] = species_index;
+                        break;
+                    }
+                }
+                if ( matches[ genome_index ] < existing_species || !Settings::SPECIES_INDEX_FALLBACK ) continue;
+                // no candidate matched, compare with the remaining species
+                auto candidate = candidates.begin();
+                for ( size_t species_index = 0; species_index < existing_species; species_index++ )
+                {
+                    if ( candidate != candidates.end() && *candidate == species_index )
+                    {
+                        candidate++;
+                        continue;
+                    }
+                    if ( this->all_species[ species_index ].fromSpecies( genome ) )
+                    {
+                        matches[ genome_index ] = species_index;
+                        break;
+                    }
+                }
+            }
+        };
+        if ( existing_species != 0 ) run_workers( workers_for( genomes.size() ), match_genomes );
+        // assign in batch order, existing species only receive the genomes matching them first
+        std::vector<size_t> unmatched = {};
+        for ( size_t genome_index = 0; genome_index < genomes.size(); genome_index++ )
+        {
+            if ( matches[ genome_index ] < existing_species ) this->all_species[ matches[ genome_index ] ].genomes.push_back( genomes[ genome_index ] );
+            else unmatched.push_back( genome_index );
+        }
+        // unmatched genomes open species in rounds, the first one left opens a species and the ones after it are compared with it in parallel
+        std::vector<unsigned char> joins = {};
+        for ( size_t opener = 0; opener < unmatched.size(); opener++ )
+        {
+            Species new_species = Species();
+            new_species.genomes.push_back( genomes[ unmatched[ opener ] ] );
+            this->all_species.push_back( new_species );
+            size_t const species_index = this->all_species.size() - 1;
+            Species const & opened = this->all_species[ species_index ];
+            joins.assign( unmatched.size(), 0 );
+            auto match_opened = [ & ]( size_t const worker, size_t const workers )
+            {
+                for ( size_t position = opener + 1 + worker; position < unmatched.size(); position += workers )
+                {
+                    joins[ position ] = opened.fromSpecies( genomes[ unmatched[ position ] ] ) ? 1 : 0;
+                }
+            };
+            run_workers( workers_for( unmatched.size() - opener - 1 ), match_opened );
+            // matching genomes join in batch order, the others are left for the next rounds
+            size_t left = opener + 1;
+            for ( size_t position = opener + 1; position < unmatched.size(); position++ )
+            {
+                if ( joins[ position ] != 0 ) this->all_species[ species_index ].genomes.push_back( genomes[ unmatched[ position ] ] );
+                else unmatched[ left++ ] = unmatched[ position ];
+            }
+            unmatched.resize( left );
+        }
+    }
+
+    /// <summary>
+    /// Advances generation by:
+    ///     - Culling half of every species;
+    ///     - Removing stale species;
+    ///     - Remove weak species;
+    ///     - Breed new children
+    ///     - Culling everything but top species;
+    ///     - Add children to species.
+    /// </summary>
+    void Gym::advanceGeneration()
+    {
+        assert( !this->all_species.empty() );
+        // genomes are culled, bred and moved from here on
+        this->pipeline.clear();
+        // adds the time since the previous phase end to a phase
+        auto phase_end = std::chrono::steady_clock::now();
+        auto lap = [ & ]( size_t const & phase )
+        {
+            auto const now = std::chrono::steady_clock::now();
+            this->generation_phases[ phase ] += std::chrono::duration<double>( now - phase_end ).count();
+            phase_end = now;
+        };
+        // cull half species
+        cullSpecies( true );
+        // update species survival from the remaining elites
+        updateEliteCurves();
+        lap( CULL_PHASE );
+        // remove stale species
+        removeStaleSpecies();
+        // remove weak species
+        removeWeakSpecies();
+        // remove the genes that can't affect the outputs
+        compactPopulation();
+        lap( REMOVAL_PHASE );
+        // set new top fitness genome
+        this->top_fitness_genome = Genome( this->all_species[ 0 ].genomes[ 0 ] );
+        // serializing in file
+        this->print_line( this->top_fitness_genome.serialize( false ) );
+        // saving evaluated fitness
+        this->print_line( "Fitness cache skipped " + std::to_string( this->fitness_cache.takeSkipped() ) + " evaluations" );
+        this->fitness_cache.save();
+        lap( SERIALIZATION_PHASE );
+        // send top genomes to the other islands
+        bool const migrating = migrationGeneration();
+        if ( migrating ) this->print_line( "Island sent " + std::to_string( this->island.emigrate( selectEmigrants() ) ) + " migrants" );
+        // children list
+        std::vector<Genome> children = breedChildren();
+        sampleMemory( children );
+        lap( BREEDING_PHASE );
+        // cull all but best genome on all species
+        cullSpecies();
+        lap( CULL_PHASE );
+        // mutate children
+        for ( Genome & child : children )
+        {
+            child.mutate();
+        }
+        // receive other islands migrants, unchanged
+        if ( migrating ) this->print_line( "Island received " + std::to_string( this->island.immigrate( children ) ) + " migrants" );
+        lap( BREEDING_PHASE );
+        // add mutated children to species
+        addGenomesToRespectiveSpecies( children );
+        // children are copied into the species, the footprint peaks till they are released
+        sampleMemory( children );
+        lap( SPECIATION_PHASE );
+        // advance generation
+        this->generation++;
+        for ( Species & species : this->all_species )
+        {
+            for ( Genome & genome : species.genomes )
+            {
+                genome.setGeneration( this->generation );
+            }
+        }
+        // report the new population memory
+        reportMemory();
+        lap( SERIALIZATION_PHASE );
+    }
+
+    /// <summary>
+    /// Eliminates either half or every but the best genome in every species, also orders every specie's genomes by descending order.
+    /// </summary>
+    /// <param name="half_cull">Trigger half culling or full culling.</param>
+    void Gym::cullSpecies( bool const & half_cull )
+    {
+        for ( Species & species : this->all_species )
+        {
+            // single genome species
+            if ( species.genomes.size() == 1 )
+            {
+                return;
+            }
+            // sort in descending fitness order
+            std::sort(
+                species.genomes.begin(), species.genomes.end(),
+                []( Genome & g1, Genome & g2 ) { return g1.getFitness() > g2.getFitness(); }
+            );
+            // set cull limit
+            size_t remaining = half_cull ? species.genomes.size() / 2 : 1;
+            // cull species to remaining count
+            species.genomes.erase( species.genomes.begin() + remaining, species.genomes.end() );
+        }
+    }
+
+    /// <summary>
+    /// Updates every species survival threshold, and with Settings::EARLY_ABORT_ELITE_CURVES its elite progress gains from its survivors curves, must follow a half culling.
+    /// </summary>
+    void Gym::updateEliteCurves()
+    {
+        if ( !Settings::EARLY_ABORT ) return;
+        // survivors curves, others are no longer needed
+        std::unordered_map<unsigned long long, std::vector<float>> elite_curves = {};
+        for ( Species & species : this->all_species )
+        {
+            species.survival_threshold = 0.0f;
+            species.elite_gains.clear();
+            for ( Genome const & genome : species.genomes )
+            {
+                // lowest survivor fitness
+                if ( species.survival_threshold == 0.0f || genome.getFitness() < species.survival_threshold )
+                {
+                    species.survival_threshold = genome.getFitness();
+                }
+                // highest gain till the end, from every sample
+                if ( !Settings::EARLY_ABORT_ELITE_CURVES ) continue;
+                auto curve = this->curves.find( genome.hash() );
+                if ( curve == this->curves.end() ) continue;
+                if ( species.elite_gains.size() < curve->second.size() ) species.elite_gains.resize( curve->second.size(), 0.0f );
+                for ( size_t sample = 0; sample < curve->second.size(); sample++ )
+                {
+                    species.elite_gains[ sample ] = std::max( species.elite_gains[ sample ], genome.getFitness() - curve->second[ sample ] );
+                }
+                elite_curves[ curve->first ] = curve->second;
+            }
+        }
+        this->curves = elite_curves;
+    }
+
+    /// <summary>
+    /// Removes all stale species from current generation. Also orders species by their best genome fitness.
+    /// </summary>
+    /// <remarks>
+    /// A specie is considered stale if has over Settings::SPECIES_STALE_THRESHOLD genomes and no progress was made.
+    /// </remarks>
+    void Gym::removeStaleSpecies()
+    {
+        // single species
+        if ( this->all_species.size() == 1 )
+        {
+            return;
+        }
+        // sort species in descending order
+        std::sort(
+            this->all_species.begin(), this->all_species.end(),
+            []( Species & s1, Species & s2 ) { return s1.genomes[ 0 ].getFitness() > s2.genomes[ 0 ].getFitness(); }
+        );
+        // species iterator from beginning
+        auto species_iterator = this->all_species.begin() + 1;
+        // remove all stale species
+        while ( species_iterator != this->all_species.end() )
+        {
+            if ( species_iterator->genomes.size() < Settings::SPECIES_STALE_THRESHOLD )
+            {
+                species_iterator = this->all_species.erase( species_iterator );
+            }
+            else
+            {
+                species_iterator++;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Removes all weak species from current generation.
+    /// </summary>
+    /// <remarks>
+    /// A specie is considered weak if has no breed chance.
+    /// </remarks>
+    void Gym::removeWeakSpecies()
+    {
+        // single species
+        if ( this->all_species.size() == 1 )
+        {
+            return;
+        }
+        // total average fitness
+        float total_average_fitness = totalAverageFitness();
+        // species iterator from beginning
+        auto species_iterator = this->all_species.begin() + 1;
+        // remove all weak species
+        while ( species_iterator != this->all_species.end() )
+        {
+            if ( species_iterator->speciesBreedCount( total_average_fitness, this->population ) < Settings::SPECIES_BREED_THRESHOLD )
+            {
+                species_iterator = this->all_species.erase( species_iterator );
+            }
+            else
+            {
+                species_iterator++;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Calculates the total average fitness of all species.
+    /// </summary>
+    /// <returns>The total average calculated fitness.</returns>
+    float const Gym::totalAverageFitness() const
+    {
+        // sum of all species's average fitness
+        float total = 0.0f;
+        // calculate sum
+        for ( Species const & species : this->all_species )
+        {
+            total += species.averageFitness();
+        }
+        // return the average of all genomes sizes
+        return total;
+    }
+
+    /// <summary>
+    /// Breed all children till population target.
+    /// </summary>
+    /// <returns>The breed children.</returns>
+    std::vector<Genome> const Gym::breedChildren() const
+    {
+        // bread children
+        std::vector<Genome> children = {};
+        // total average fitness
+        float total_average_fitness = totalAverageFitness();
+        // for every species bread it's children
+        for ( Species const & species : this->all_species )
+        {
+            // species breed count
+            size_t breedCount = species.speciesBreedCount( total_average_fitness, this->population );
+            // breed till breed count
+            for ( size_t breed = 0; breed < breedCount; breed++ )
+            {
+                children.push_back( species.breedChild() );
+            }
+        }
+        // return all created children
+        return children;
+    }
+
+    /// <summary>
+    /// Checks if the current generation exchanges genomes with the other islands.
+    /// </summary>
+    /// <returns>Whenever it is a migration generation.</returns>
+    bool const Gym::migrationGeneration() const
+    {
+        return this->island.isConnected() && ( this->generation + 1 ) % Settings::ISLAND_MIGRATION_INTERVAL == 0;
+    }
+
+    /// <summary>
+    /// Retrieves the best genome of the top species, to send to the other islands.
+    /// </summary>
+    /// <returns>Up to Settings::ISLAND_MIGRANTS genomes.</returns>
+    std::vector<Genome> const Gym::selectEmigrants() const
+    {
+        // species are ordered by their best genome and genomes by fitness
+        std::vector<Genome> emigrants = {};
+        for ( size_t species_index = 0; species_index < this->all_species.size() && emigrants.size() < Settings::ISLAND_MIGRANTS; species_index++ )
+        {
+            emigrants.push_back( this->all_species[ species_index ].genomes[ 0 ] );
+        }
+        return emigrants;
+    }
+
+    /// <summary>
+    /// Appends the population memory and bloat of the current generation to the memory report, and prints its totals.
+    /// </summary>
+    /// <remarks>
+    /// Used bytes count genomes and genes, capacity bytes add the species, genome and gene buffers capacity.
+    /// Every species reports the min / median / max genes and neurons of its genomes.
+    /// </remarks>
+    void Gym::reportMemory()
+    {
+        if ( !Settings::MEMORY_REPORT ) return;
+        size_t total_genomes = 0, total_genes = 0, total_disabled = 0, total_dead = 0;
+        size_t total_used = 0, total_capacity = sizeof( Species ) * this->all_species.capacity();
+        std::ostringstream species_lines;
+        std::vector<size_t> genes = {}, neurons = {};
+        for ( size_t species_index = 0; species_index < this->all_species.size(); species_index++ )
+        {
+            Species const & species = this->all_species[ species_index ];
+            size_t species_used = 0, species_disabled = 0, species_dead = 0;
+            size_t species_capacity = ( species.genomes.capacity() - species.genomes.size() ) * sizeof( Genome ) + species.elite_gains.capacity() * sizeof( float );
+            genes.clear();
+            neurons.clear();
+            for ( Genome const & genome : species.genomes )
+            {
+                size_t used = 0, capacity = 0, disabled_genes = 0, dead_neurons = 0;
+                genome.measureMemory( used, capacity, disabled_genes, dead_neurons );
+                species_used += used;
+                species_capacity += capacity;
+                species_disabled += disabled_genes;
+                species_dead += dead_neurons;
+                genes.push_back( genome.getTotalGenes() );
+                neurons.push_back( genome.getTotalNeurons() );
+            }
+            if ( species.genomes.empty() ) continue;
+            std::sort( genes.begin(), genes.end() );
+            std::sort( neurons.begin(), neurons.end() );
+            size_t species_genes = 0;
+            for ( size_t const & count : genes ) species_genes += count;
+            species_lines
+                << "  Species " << species_index
+                << " Genomes=" << species.genomes.size()
+                << " Genes=" << genes.front() << "/" << genes[ genes.size() / 2 ] << "/" << genes.back()
+                << " Neurons=" << neurons.front() << "/" << neurons[ neurons.size() / 2 ] << "/" << neurons.back()
+                << " Disabled=" << 100.0f * static_cast<float>( species_disabled ) / static_cast<float>( std::max<size_t>( species_genes, 1 ) ) << "%"
+                << " Dead=" << species_dead
+                << " Used=" << species_used / 1024 << "kB"
+                << " Capacity=" << species_capacity / 1024 << "kB"
+                << "\n";
+            total_genomes += species.genomes.size();
+            total_genes += species_genes;
+            total_disabled += species_disabled;
+            total_dead += species_dead;
+            total_used += species_used;
+            total_capacity += species_capacity;
+        }
+        this->memory_high_water = std::max( this->memory_high_water, total_capacity );
+
+        std::ostringstream totals;
+        totals
+            << "Genomes=" << total_genomes
+            << " Species=" << this->all_species.size()
+            << " Bytes/genome=" << total_used / std::max<size_t>( total_genomes, 1 ) << "/" << total_capacity / std::max<size_t>( total_genomes, 1 )
+            << " Disabled=" << 100.0f * static_cast<float>( total_disabled ) / static_cast<float>( std::max<size_t>( total_genes, 1 ) ) << "%"
+            << " Dead=" << total_dead
+            << " Used=" << total_used / 1024 << "kB"
+            << " Capacity=" << total_capacity / 1024 << "kB"
+            << " High-water=" << this->memory_high_water / 1024 << "kB";
+        this->print_line( "Population memory " + totals.str() );
+        this->append_file( "genomes/memory_report.txt", "Generation " + std::to_string( this->generation ) + " " + totals.str() + "\n" + species_lines.str() );
+    }
+
+    /// <summary>
+    /// Raises the memory high-water mark to the current footprint of the population and the genomes bred next to it.
+    /// </summary>
+    /// <param name="children">Genomes alive outside the population.</param>
+    void Gym::sampleMemory( std::vector<Genome> const & children )
+    {
+        if ( !Settings::MEMORY_REPORT ) return;
+        size_t used = 0, capacity = 0, disabled_genes = 0, dead_neurons = 0;
+        size_t total_capacity = sizeof( Species ) * this->all_species.capacity() + ( children.capacity() - children.size() ) * sizeof( Genome );
+        for ( Genome const & child : children )
+        {
+            child.measureMemory( used, capacity, disabled_genes, dead_neurons );
+            total_capacity += capacity;
+        }
+        for ( Species const & species : this->all_species )
+        {
+            total_capacity += ( species.genomes.capacity() - species.genomes.size() ) * sizeof( Genome ) + species.elite_gains.capacity() * sizeof( float );
+            for ( Genome const & genome : species.genomes )
+            {
+                genome.measureMemory( used, capacity, disabled_genes, dead_neurons );
+                total_capacity += capacity;
+            }
+        }
+        this->memory_high_water = std::max( this->memory_high_water, total_capacity );
+    }
+
+    /// <summary>
+    /// Compacts every genome of every species every Settings::COMPACT_INTERVAL generations, keeping the disabled genes speciation compares.
+    /// </summary>
+    void Gym::compactPopulation()
+    {
+        if ( Settings::COMPACT_INTERVAL == 0 || this->generation % Settings::COMPACT_INTERVAL != 0 ) return;
+        size_t total_genes = 0, total_neurons = 0;
+        for ( Species & species : this->all_species )
+        {
+            for ( Genome & genome : species.genomes )
+            {
+                size_t removed_genes = 0, removed_neurons = 0;
+                genome.compact( true, removed_genes, removed_neurons );
+                total_genes += removed_genes;
+                total_neurons += removed_neurons;
+            }
+        }
+        this->print_line( "Population compacted " + std::to_string( total_genes ) + " genes and " + std::to_string( total_neurons ) + " neurons" );
+    }
+
+    /// <summary>
+    /// Advances the steady-state evolution by:
+    ///     - Recording the finished evaluation in its species statistics;
+    ///     - Selecting the next not yet evaluated genome, if any;
+    ///     - Removing the stale species every population size replacements;
+    ///     - Otherwise replacing the worst eligible genome by a new child and selecting it.
+    /// </summary>
+    void Gym::advanceSteadyState()
+    {
+        // genomes are sorted and replaced from here on
+        this->pipeline.clear();
+        // record finished evaluation in its species statistics
+        Species & species = this->all_species[ this->current_species ];
+        Genome & genome = currentGenome();
+        genome.setEvaluated( true );
+        species.evaluated_fitness += genome.getFitness();
+        species.evaluated_genomes++;
+        this->evaluations++;
+        // keep best found genome
+        if ( this->top_fitness_genome.getFitness() < genome.getFitness() )
+        {
+            this->top_fitness_genome = Genome( genome );
+        }
+        // keep evaluated genomes first and in descending fitness order, breeding uses the first as parent
+        std::stable_sort(
+            species.genomes.begin(), species.genomes.end(),
+            []( Genome const & g1, Genome const & g2 )
+            { return g1.isEvaluated() != g2.isEvaluated() ? g1.isEvaluated() : g1.getFitness() > g2.getFitness(); }
+        );
+        // evaluate every pending genome before replacing any
+        if ( selectUnevaluatedGenome() ) return;
+        // a generation is counted for every population size replacements, champions are never replaced so species only end as stale species
+        this->replacements++;
+        if ( this->replacements >= this->population )
+        {
+            this->replacements = 0;
+            this->generation++;
+            removeStaleSpecies();
+            // serializing in file
+            this->print_line( this->top_fitness_genome.serialize( false ) );
+            // report the population memory
+            reportMemory();
+        }
+        // replace worst genome by a new child, a population without eligible genomes grows till some are old enough
+        size_t total_genomes = 0;
+        for ( Species const & population_species : this->all_species ) total_genomes += population_species.genomes.size();
+        while ( total_genomes >= this->population && removeWorstGenome() ) total_genomes--;
+        Genome child = breedSteadyStateChild();
+        child.mutate();
+        child.setFitness( 0.0f );
+        child.setEvaluated( false );
+        child.setGeneration( this->generation );
+        child.setBirth( this->evaluations );
+        // child is the next genome in training
+        this->current_species = addGenomeToRespectiveSpecies( child );
+        this->current_genome = this->all_species[ this->current_species ].genomes.size() - 1;
+    }
+
+    /// <summary>
+    /// Sets the first not yet evaluated genome as current.
+    /// </summary>
+    /// <returns>Whenever a not evaluated genome was found.</returns>
+    bool const Gym::selectUnevaluatedGenome()
+    {
+        for ( size_t species_index = 0; species_index < this->all_species.size(); species_index++ )
+        {
+            std::vector<Genome> const & genomes = this->all_species[ species_index ].genomes;
+            for ( size_t genome_index = 0; genome_index < genomes.size(); genome_index++ )
+            {
+                if ( genomes[ genome_index ].isEvaluated() ) continue;
+                this->current_species = species_index;
+                this->current_genome = genome_index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes the eligible genome with the worst fitness adjusted by its species size.
+    /// </summary>
+    /// <remarks>
+    /// Eligible genomes are evaluated, at least Settings::STEADY_STATE_MIN_AGE evaluations old and not their species champion, so no species is emptied.
+    /// </remarks>
+    /// <returns>Whenever a genome was removed.</returns>
+    bool const Gym::removeWorstGenome()
+    {
+        // worst genome position, species size is used as not found
+        size_t worst_species = this->all_species.size();
+        size_t worst_genome = 0;
+        float worst_fitness = 0.0f;
+        // find worst eligible genome, fitness is shared by the species size to protect small species
+        for ( size_t species_index = 0; species_index < this->all_species.size(); species_index++ )
+        {
+            // species keep their evaluated genomes first, in descending fitness order, so the first is the champion
+            std::vector<Genome> const & genomes = this->all_species[ species_index ].genomes;
+            for ( size_t genome_index = 1; genome_index < genomes.size(); genome_index++ )
+            {
+                if ( !genomes[ genome_index ].isEvaluated() ) continue;
+                if ( this->evaluations - genomes[ genome_index ].getBirth() < static_cast<size_t>( Settings::STEADY_STATE_MIN_AGE ) ) continue;
+                float adjusted_fitness = genomes[ genome_index ].getFitness() / static_cast<float>( genomes.size() );
+                if ( worst_species == this->all_species.size() || adjusted_fitness < worst_fitness )
+                {
+                    worst_species = species_index;
+                    worst_genome = genome_index;
+                    worst_fitness = adjusted_fitness;
+                }
+            }
+        }
+        // nothing eligible, nothing to remove
+        if ( worst_species == this->all_species.size() ) return false;
+        // update species statistics and remove genome
+        Species & species = this->all_species[ worst_species ];
+        species.evaluated_fitness -= species.genomes[ worst_genome ].getFitness();
+        species.evaluated_genomes--;
+        if ( species.evaluated_genomes == 0 ) species.evaluated_fitness = 0.0f;
+        species.genomes.erase( species.genomes.begin() + worst_genome );
+        return true;
+    }
+
+    /// <summary>
+    /// Breeds a child from a species chosen proportionally to its evaluated average fitness.
+    /// </summary>
+    /// <returns>The breed child.</returns>
+    Genome Gym::breedSteadyStateChild() const
+    {
+        assert( !this->all_species.empty() );
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // sum of all species's evaluated average fitness
+        float total = 0.0f;
+        for ( Species const & species : this->all_species )
+        {
+            total += species.evaluatedAverageFitness();
+        }
+        // roulette selection of the parent species
+        float target = rng.generateRandom() * total;
+        for ( Species const & species : this->all_species )
+        {
+            if ( species.evaluated_genomes == 0 ) continue;
+            target -= species.evaluatedAverageFitness();
+            if ( target <= 0.0f ) return species.breedChild();
+        }
+        // rounding leftovers, use the top species
+        return this->all_species[ 0 ].breedChild();
+    }
+
+    /// <summary>
+    /// Starts the successive halving of the current generation, every genome races the first rung.
+    /// </summary>
+    void Gym::startHalving()
+    {
+        if ( Settings::GYM_STEADY_STATE || !Settings::HALVING ) return;
+        this->contenders.clear();
+        this->rung_contenders.clear();
+        this->rung = 0;
+        this->rung_position = 0;
+        for ( size_t species_index = 0; species_index < this->all_species.size(); species_index++ )
+        {
+            for ( size_t genome_index = 0; genome_index < this->all_species[ species_index ].genomes.size(); genome_index++ )
+            {
+                this->rung_contenders.push_back( this->contenders.size() );
+                this->contenders.push_back( Contender( species_index, genome_index ) );
+            }
+        }
+        // first contender is the next genome in training
+        this->current_species = this->contenders[ 0 ].species;
+        this->current_genome = this->contenders[ 0 ].genome;
+    }
+
+    /// <summary>
+    /// Advances the successive halving by:
+    ///     - Recording the finished evaluation in its contender;
+    ///     - Selecting the next contender of the rung, if any;
+    ///     - Otherwise promoting the best rung contenders to the next rung;
+    ///     - After the last rung, normalizing fitness, advancing generation and starting a new halving.
+    /// </summary>
+    void Gym::advanceHalving()
+    {
+        // record finished evaluation
+        this->contenders[ this->rung_contenders[ this->rung_position ] ].fitness.push_back( currentGenome().getFitness() );
+        this->rung_position++;
+        // next contender in rung
+        if ( this->rung_position < this->rung_contenders.size() )
+        {
+            Contender const & contender = this->contenders[ this->rung_contenders[ this->rung_position ] ];
+            this->current_species = contender.species;
+            this->current_genome = contender.genome;
+            return;
+        }
+        // last rung finished, every genome has a comparable fitness
+        if ( fullEvaluation() )
+        {
+            normalizeContenders();
+            this->current_species = 0;
+            this->current_genome = 0;
+            advanceGeneration();
+            startHalving();
+            return;
+        }
+        // promote the best 1 / eta contenders, at least one
+        std::stable_sort(
+            this->rung_contenders.begin(), this->rung_contenders.end(),
+            [ & ]( size_t const & c1, size_t const & c2 ) { return this->contenders[ c1 ].fitness.back() > this->contenders[ c2 ].fitness.back(); }
+        );
+        size_t promoted = std::max<size_t>( 1, this->rung_contenders.size() / Settings::HALVING_ETA );
+        this->rung_contenders.erase( this->rung_contenders.begin() + promoted, this->rung_contenders.end() );
+        // race the promoted in population order
+        std::sort( this->rung_contenders.begin(), this->rung_contenders.end() );
+        this->rung++;
+        this->rung_position = 0;
+        Contender const & contender = this->contenders[ this->rung_contenders[ 0 ] ];
+        this->current_species = contender.species;
+        this->current_genome = contender.genome;
+    }
+
+    /// <summary>
+    /// Starts leasing the genomes of the current generation.
+    /// </summary>
+    void Gym::startLeasing()
+    {
+        this->leases.clear();
+        this->next_lease = 0;
+        this->returned_leases = 0;
+        for ( size_t species_index = 0; species_index < this->all_species.size(); species_index++ )
+        {
+            for ( size_t genome_index = 0; genome_index < this->all_species[ species_index ].genomes.size(); genome_index++ )
+            {
+                this->leases.push_back( Contender( species_index, genome_index ) );
+            }
+        }
+    }
+
+    /// <summary>
+    /// Counts a returned genome, advancing generation once every genome of the generation returned.
+    /// </summary>
+    void Gym::completeLease()
+    {
+        this->returned_leases++;
+        if ( this->returned_leases < this->leases.size() ) return;
+        // single car training position is reset, as on a generation advance
+        this->current_species = 0;
+        this->current_genome = 0;
+        advanceGeneration();
+        startLeasing();
+    }
+
+    /// <summary>
+    /// Checks if the current Genome races the full evaluation, always true without successive halving.
+    /// </summary>
+    /// <returns>Whenever current rung is the last one.</returns>
+    bool const Gym::fullEvaluation() const
+    {
+        return Settings::GYM_STEADY_STATE || !Settings::HALVING || this->rung + 1 >= Settings::HALVING_RUNGS;
+    }
+
+    /// <summary>
+    /// Scales the fitness of every contender eliminated before the last rung, to the full evaluation of the finalists.
+    /// </summary>
+    /// <remarks>
+    /// Each rung scale is the ratio between the finalists full evaluation fitness sum and their fitness sum in that rung.
+    /// Scaled fitness is capped by the lowest finalist fitness, an eliminated contender never ranks above a finalist.
+    /// </remarks>
+    void Gym::normalizeContenders()
+    {
+        // finalists fitness sums of every rung, and lowest full evaluation fitness
+        std::vector<float> rung_sums( Settings::HALVING_RUNGS, 0.0f );
+        float lowest_finalist = 0.0f;
+        for ( size_t const & finalist : this->rung_contenders )
+        {
+            std::vector<float> const & fitness = this->contenders[ finalist ].fitness;
+            for ( size_t rung_index = 0; rung_index < fitness.size(); rung_index++ ) rung_sums[ rung_index ] += fitness[ rung_index ];
+            if ( finalist == this->rung_contenders[ 0 ] || fitness.back() < lowest_finalist ) lowest_finalist = fitness.back();
+        }
+        float const full_sum = rung_sums[ Settings::HALVING_RUNGS - 1 ];
+        // scale eliminated contenders
+        for ( Contender const & contender : this->contenders )
+        {
+            size_t const last_rung = contender.fitness.size() - 1;
+            if ( last_rung + 1 >= Settings::HALVING_RUNGS ) continue;
+            float scale = rung_sums[ last_rung ] > 0.0f ? full_sum / rung_sums[ last_rung ] : 1.0f;
+            float fitness = std::min( contender.fitness.back() * scale, lowest_finalist );
+            this->all_species[ contender.species ].genomes[ contender.genome ].setFitness( fitness );
+        }
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Species class.                                                        *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates a simple species.
+    /// </summary>
+    Gym::Species::Species()
+        : genomes( {} ), evaluated_fitness( 0.0f ), evaluated_genomes( 0 ), survival_threshold( 0.0f ), elite_gains( {} ) {}
+
+    /// <summary>
+    /// Checks if given genome belongs to species.
+    /// </summary>
+    /// <param name="genome">Genome to check.</param>
+    /// <returns>Whenever genome belongs to species.</returns>
+    bool const Gym::Species::fromSpecies( Genome const & genome ) const
+    {
+        // initialise values
+        float disjoint = 0.0f;
+        float weights = 0.0f;
+        // compare with first
+        this->genomes[ 0 ].compare( genome, disjoint, weights );
+        // update
+        disjoint = Settings::SPECIES_DELTA_DIJOINT * disjoint;
+        weights = Settings::SPECIES_DELTA_WEIGHTS * weights;
+        // if sum of disjoint and weights over threshold, not from species
+        return disjoint + weights < Settings::SPECIES_DELTA_THRESHOLD;
+    }
+
+    /// <summary>
+    /// Average fitness from a species.
+    /// </summary>
+    float const Gym::Species::averageFitness() const
+    {
+        // sum of all genome's fitness
+        float total = 0.0f;
+        // calculate sum
+        for ( Genome const & genome : this->genomes )
+        {
+            total += genome.getFitness();
+        }
+        // return the average of all genomes sizes
+        return this->genomes.empty() ? total : total / static_cast<float>( this->genomes.size() );
+    }
+
+    /// <summary>
+    /// Average species fitness of evaluated genomes, updated incrementally ( Steady-state only ).
+    /// </summary>
+    float const Gym::Species::evaluatedAverageFitness() const
+    {
+        return this->evaluated_genomes == 0 ? 0.0f : this->evaluated_fitness / static_cast<float>( this->evaluated_genomes );
+    }
+
+    /// <summary>
+    /// Calculates the species total offspring to reach the target population in comparison to all other species.
+    /// </summary>
+    /// <param name="species">Species for breed count</param>
+    /// <param name="population">Target population.</param>
+    /// <returns>Breed count.</returns>
+    size_t const Gym::Species::speciesBreedCount( float const & total_average_fitness, size_t const & population ) const
+    {
+        return static_cast<size_t>( std::floor( ( averageFitness() / total_average_fitness ) * static_cast<float>( population ) ) ) - 1;
+    }
+
+    /// <summary>
+    /// Breed a new genome from this species.
+    /// </summary>
+    /// <returns>Breed child.</returns>
+    Genome Gym::Species::breedChild() const
+    {
+        // retrieve god
+        Random_Generator & rng = Random_Generator::getInstance();
+
+        // uses always top species parent as base
+        Genome const & parent_one = this->genomes[ 0 ];
+        // if below crossover change, crossover a new gene
+        if ( rng.generateRandom() < Settings::CROSSOVER_CHANCE )
+        {
+            size_t parent_index_two = static_cast<size_t>( std::floor( rng.generateRandom() * static_cast<float>( this->genomes.size() ) ) );
+            Genome const & parent_two = this->genomes[ parent_index_two ];
+            // return generated child
+            return parent_one.crossover( parent_two );
+        }
+        // otherwise copy a of the species top genome
+        return Genome( parent_one );
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Contender class.                                                      *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates a contender without raced rungs.
+    /// </summary>
+    /// <param name="species">Genome species index.</param>
+    /// <param name="genome">Genome index in its species.</param>
+    Gym::Contender::Contender( size_t const & species, size_t const & genome )
+        : species( species ), genome( genome ), fitness( {} ) {}
+}
+
+#endif
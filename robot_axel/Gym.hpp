@@ -1,222 +1,617 @@
-/***************************************************************************
-
-    file                 : Gym.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#pragma once
-
-#ifndef ROBOT_AXEL_GYM
-#define ROBOT_AXEL_GYM
-
-#include <array>
-#include "Genome.hpp"
-#include "Random_Generator.hpp"
-#include "Settings.hpp"
-
-namespace RobotAxel
-{
-    /// <summary>
-    /// AI training gym, evolves the AI in order to achieve better fitness results.
-    /// </summary>
-    class Gym
-    {
-        /***************************************************************************
-         *                                                                         *
-         *   Species class.                                                        *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// 
-        /// </summary>
-        class Species
-        {
-            // Friendship declarations
-            friend class Gym;
-
-            /// <summary>
-            /// Species's current genome mutations.
-            /// </summary>
-            std::vector<Genome> genomes;
-
-            /// <summary>
-            /// Generates a simple species.
-            /// </summary>
-            Species();
-
-            /// <summary>
-            /// Checks if given genome belongs to species.
-            /// </summary>
-            /// <param name="genome">Genome to check.</param>
-            /// <returns>Whenever genome belongs to species.</returns>
-            bool const fromSpecies( Genome const & genome ) const;
-
-            /// <summary>
-            /// Average species fitness.
-            /// </summary>
-            float const averageFitness() const;
-
-            /// <summary>
-            /// Calculates the species total offspring to reach the target population in comparison to all other species.
-            /// </summary>
-            /// <param name="species">Species for breed count</param>
-            /// <returns>Breed count.</returns>
-            size_t const speciesBreedCount( float const & total_average_fitness ) const;
-
-            /// <summary>
-            /// Breed a new genome from this species.
-            /// </summary>
-            /// <returns>Breed child.</returns>
-            Genome breedChild() const;
-        };
-
-        /***************************************************************************
-         *                                                                         *
-         *   Gym local constants and variables.                                    *
-         *                                                                         *
-         ***************************************************************************/
-        private:
-        /// <summary>
-        /// Full spectre of species in current generation.
-        /// </summary>
-        std::vector<Species> all_species;
-        /// <summary>
-        /// Current species in training.
-        /// </summary>
-        size_t current_species;
-        /// <summary>
-        /// Current species genome in training.
-        /// </summary>
-        size_t current_genome;
-        /// <summary>
-        /// Current training generation.
-        /// </summary>
-        size_t generation;
-        /// <summary>
-        /// Reference to genome with best fitness.
-        /// </summary>
-        Genome top_fitness_genome;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Gym interface.                                                        *
-         *                                                                         *
-         ***************************************************************************/
-        public:
-        /// <summary>
-        /// Generates gym with initial population
-        /// </summary>
-        Gym();
-
-        /// <summary>
-        /// Save top_genome before deleting gym.
-        /// </summary>
-        ~Gym();
-
-        /// <summary>
-        /// Calculates outputs according to the current network, using the Gym or the top Genome.
-        /// </summary>
-        /// <param name="outputs">Array with output neurons values.</param>
-        /// <param name="inputs">The input array used for the update.</param>
-        void evaluateCurrent( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
-
-        /// <summary>
-        /// Updates current Genome's fitness reference.
-        /// </summary>
-        /// <param name="fitness">The fitness of the previous evaluation.</param>
-        void appraiseCurrent( float const & fitness );
-
-        /// <summary>
-        /// Indicates the Gym to advance to the next Genome, for the fitness test.
-        /// </summary>
-        void advanceInTrain();
-
-        /// <summary>
-        /// Retrieves current training generation and species number in generation, as well current top fitness.
-        /// </summary>
-        /// <param name="generation">Current AI generation.</param>
-        /// <param name="species">Number of species in generation.</param>
-        /// <param name="fitness">Current fitness.</param>
-        /// <param name="top_fitness">Top fitness.</param>
-        /// <param name="top_genes">Top gene number.</param>
-        /// <param name="top_neurons">Top neuron number.</param>
-        void getInformation( size_t & generation, size_t & species, float & fitness, float & top_fitness, size_t & top_genes, size_t & top_neurons ) const;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Gym utilities.                                                        *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Retrieves current genome in training.
-        /// </summary>
-        /// <returns>The current genome reference.</returns>
-        Genome const & currentGenome() const;
-        /// <summary>
-        /// Retrieves current genome in training.
-        /// </summary>
-        /// <returns>The current genome reference.</returns>
-        Genome & currentGenome();
-
-        /// <summary>
-        /// Adds genome to a similar species, if none is found creates one for it.
-        /// </summary>
-        /// <param name="genome">Genome to add.</param>
-        void addGenomeToRespectiveSpecies( Genome & genome );
-
-        /// <summary>
-        /// Advances generation by:
-        ///     - Culling half of every species;
-        ///     - Removing stale species;
-        ///     - Remove weak species;
-        ///     - Breed new children
-        ///     - Culling everything but top species;
-        ///     - Add children to species.
-        /// </summary>
-        void advanceGeneration();
-
-        /// <summary>
-        /// Eliminates either half or every but the best genome in every species, also orders every specie's genomes by descending order.
-        /// </summary>
-        /// <param name="half_cull">Trigger half culling or full culling.</param>
-        void cullSpecies( bool const & half_cull = false );
-
-        /// <summary>
-        /// Removes all stale species from current generation. Also orders species by their best genome fitness.
-        /// </summary>
-        /// <remarks>
-        /// A specie is considered stale if has over Settings::SPECIES_STALE_THRESHOLD genomes and no progress was made.
-        /// </remarks>
-        void removeStaleSpecies();
-
-        /// <summary>
-        /// Removes all weak species from current generation.
-        /// </summary>
-        /// <remarks>
-        /// A specie is considered weak if has no breed chance.
-        /// </remarks>
-        void removeWeakSpecies();
-
-        /// <summary>
-        /// Calculates the total average fitness of all species.
-        /// </summary>
-        /// <returns>The total average calculated fitness.</returns>
-        float const totalAverageFitness() const;
-
-        /// <summary>
-        /// Breed all children till population target.
-        /// </summary>
-        /// <returns>The breed children.</returns>
-        std::vector<Genome> const breedChildren() const;
-    };
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Gym.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_GYM
+#define ROBOT_AXEL_GYM
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Fitness_Cache.hpp"
+#include "Genome.hpp"
+#include "Island.hpp"
+#include "Phenotype.hpp"
+#include "Phenotype_Pipeline.hpp"
+#include "Random_Generator.hpp"
+#include "Settings.hpp"
+#include "Species_Index.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// AI training gym, evolves the AI in order to achieve better fitness results.
+    /// </summary>
+    class Gym
+    {
+        // Friendship declarations
+        friend class Benchmark;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Species class.                                                        *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// 
+        /// </summary>
+        class Species
+        {
+            // Friendship declarations
+            friend class Gym;
+            friend class Benchmark;
+
+            /// <summary>
+            /// Species's current genome mutations.
+            /// </summary>
+            std::vector<Genome> genomes;
+            /// <summary>
+            /// Sum of all evaluated genomes fitness ( Steady-state only ).
+            /// </summary>
+            float evaluated_fitness;
+            /// <summary>
+            /// Number of evaluated genomes ( Steady-state only ).
+            /// </summary>
+            size_t evaluated_genomes;
+            /// <summary>
+            /// Lowest fitness that survived the last half culling, 0 if unknown.
+            /// </summary>
+            float survival_threshold;
+            /// <summary>
+            /// Highest progress gained till the end of the evaluation by a survivor, from every progress curve sample.
+            /// </summary>
+            std::vector<float> elite_gains;
+
+            /// <summary>
+            /// Generates a simple species.
+            /// </summary>
+            Species();
+
+            /// <summary>
+            /// Checks if given genome belongs to species.
+            /// </summary>
+            /// <param name="genome">Genome to check.</param>
+            /// <returns>Whenever genome belongs to species.</returns>
+            bool const fromSpecies( Genome const & genome ) const;
+
+            /// <summary>
+            /// Average species fitness.
+            /// </summary>
+            float const averageFitness() const;
+
+            /// <summary>
+            /// Average species fitness of evaluated genomes, updated incrementally ( Steady-state only ).
+            /// </summary>
+            float const evaluatedAverageFitness() const;
+
+            /// <summary>
+            /// Calculates the species total offspring to reach the target population in comparison to all other species.
+            /// </summary>
+            /// <param name="species">Species for breed count</param>
+            /// <param name="population">Target population.</param>
+            /// <returns>Breed count.</returns>
+            size_t const speciesBreedCount( float const & total_average_fitness, size_t const & population ) const;
+
+            /// <summary>
+            /// Breed a new genome from this species.
+            /// </summary>
+            /// <returns>Breed child.</returns>
+            Genome breedChild() const;
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Contender class.                                                      *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Genome of the current generation, racing the successive halving rungs or leased to a fleet car.
+        /// </summary>
+        class Contender
+        {
+            // Friendship declarations
+            friend class Gym;
+
+            /// <summary>
+            /// Genome species index.
+            /// </summary>
+            size_t species;
+            /// <summary>
+            /// Genome index in its species.
+            /// </summary>
+            size_t genome;
+            /// <summary>
+            /// Fitness of every raced rung ( Successive halving only ).
+            /// </summary>
+            std::vector<float> fitness;
+
+            /// <summary>
+            /// Generates a contender without raced rungs.
+            /// </summary>
+            /// <param name="species">Genome species index.</param>
+            /// <param name="genome">Genome index in its species.</param>
+            Contender( size_t const & species, size_t const & genome );
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gym local constants and variables.                                    *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Generation advance phases, culling and elite curves update.
+        /// </summary>
+        constexpr static size_t const CULL_PHASE = 0;
+        /// <summary>
+        /// Generation advance phases, stale and weak species removal.
+        /// </summary>
+        constexpr static size_t const REMOVAL_PHASE = 1;
+        /// <summary>
+        /// Generation advance phases, children breeding, mutation and island migration.
+        /// </summary>
+        constexpr static size_t const BREEDING_PHASE = 2;
+        /// <summary>
+        /// Generation advance phases, children speciation.
+        /// </summary>
+        constexpr static size_t const SPECIATION_PHASE = 3;
+        /// <summary>
+        /// Generation advance phases, top genome and fitness cache serialization.
+        /// </summary>
+        constexpr static size_t const SERIALIZATION_PHASE = 4;
+        /// <summary>
+        /// Number of generation advance phases.
+        /// </summary>
+        constexpr static size_t const GENERATION_PHASES = 5;
+        /// <summary>
+        /// Target population.
+        /// </summary>
+        size_t const population;
+        /// <summary>
+        /// Full spectre of species in current generation.
+        /// </summary>
+        std::vector<Species> all_species;
+        /// <summary>
+        /// Current species in training.
+        /// </summary>
+        size_t current_species;
+        /// <summary>
+        /// Current species genome in training.
+        /// </summary>
+        size_t current_genome;
+        /// <summary>
+        /// Current training generation.
+        /// </summary>
+        size_t generation;
+        /// <summary>
+        /// Reference to genome with best fitness.
+        /// </summary>
+        Genome top_fitness_genome;
+        /// <summary>
+        /// Number of genomes replaced since the last generation increment ( Steady-state only ).
+        /// </summary>
+        size_t replacements;
+        /// <summary>
+        /// Evaluations finished since the gym creation, the genome age clock ( Steady-state only ).
+        /// </summary>
+        size_t evaluations;
+        /// <summary>
+        /// Fitness of previously evaluated genomes.
+        /// </summary>
+        Fitness_Cache fitness_cache;
+        /// <summary>
+        /// Progress sampled every Settings::EARLY_ABORT_INTERVAL of the current evaluation.
+        /// </summary>
+        std::vector<float> current_curve;
+        /// <summary>
+        /// Upper bound of the final progress of the current evaluation, as last appraised.
+        /// </summary>
+        float current_bound;
+        /// <summary>
+        /// Progress curves of finished evaluations, by genome hash.
+        /// </summary>
+        std::unordered_map<unsigned long long, std::vector<float>> curves;
+        /// <summary>
+        /// Every genome of the current generation ( Successive halving only ).
+        /// </summary>
+        std::vector<Contender> contenders;
+        /// <summary>
+        /// Contenders racing the current rung, in evaluation order ( Successive halving only ).
+        /// </summary>
+        std::vector<size_t> rung_contenders;
+        /// <summary>
+        /// Current halving rung ( Successive halving only ).
+        /// </summary>
+        size_t rung;
+        /// <summary>
+        /// Current contender position in the rung ( Successive halving only ).
+        /// </summary>
+        size_t rung_position;
+        /// <summary>
+        /// Island connection to the other training processes.
+        /// </summary>
+        Island island;
+        /// <summary>
+        /// Every genome of the current generation, in lease order ( Fleet only ).
+        /// </summary>
+        std::vector<Contender> leases;
+        /// <summary>
+        /// Next genome to lease ( Fleet only ).
+        /// </summary>
+        size_t next_lease;
+        /// <summary>
+        /// Number of returned genomes ( Fleet only ).
+        /// </summary>
+        size_t returned_leases;
+        /// <summary>
+        /// Time spent in every generation advance phase since the gym creation, in [s].
+        /// </summary>
+        std::array<double, GENERATION_PHASES> generation_phases;
+        /// <summary>
+        /// Highest population footprint, in [B], sampled at the generation advance peaks, while the bred children and the population are both alive.
+        /// </summary>
+        size_t memory_high_water;
+        /// <summary>
+        /// Next genomes in training, handed to the phenotype pipeline.
+        /// </summary>
+        std::vector<Genome const *> upcoming;
+        /// <summary>
+        /// Prints a console line, to the console unless redirected.
+        /// </summary>
+        std::function<void( std::string const & )> print_line;
+        /// <summary>
+        /// Appends contents to a file, in place unless redirected.
+        /// </summary>
+        std::function<void( std::string const &, std::string const & )> append_file;
+        /// <summary>
+        /// Background builder of the next genomes compiled networks, last so its thread stops before the population is destroyed.
+        /// </summary>
+        Phenotype_Pipeline pipeline;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gym interface.                                                        *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates gym with initial population
+        /// </summary>
+        /// <param name="population">Target population.</param>
+        Gym( size_t const & population = Settings::GYM_POPULATION );
+
+        /// <summary>
+        /// Save top_genome before deleting gym.
+        /// </summary>
+        ~Gym();
+
+        /// <summary>
+        /// Calculates outputs according to the current network, using the Gym or the top Genome.
+        /// </summary>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluateCurrent( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
+
+        /// <summary>
+        /// Compiles the current Genome network, or takes it prepared, then prepares the next ones in background.
+        /// </summary>
+        /// <param name="phenotype">Phenotype to build.</param>
+        void compileCurrent( Phenotype & phenotype );
+
+        /// <summary>
+        /// Updates current Genome's fitness reference.
+        /// </summary>
+        /// <param name="fitness">The fitness of the previous evaluation.</param>
+        /// <param name="time">Evaluation time, in [s].</param>
+        /// <param name="bound">Upper bound of the final fitness of the evaluation, unbounded if unknown.</param>
+        void appraiseCurrent( float const & fitness, float const & time = 0.0f, float const & bound = std::numeric_limits<float>::infinity() );
+
+        /// <summary>
+        /// Checks if the current Genome can no longer reach its species survival threshold.
+        /// </summary>
+        /// <remarks>
+        /// Ends evaluations whose progress bound is below the threshold.
+        /// With Settings::EARLY_ABORT_ELITE_CURVES also ends the ones whose progress plus Settings::EARLY_ABORT_SAFETY times the highest gain of a species survivor, from the same time till its end, is below it.
+        /// </remarks>
+        /// <returns>Whenever the evaluation should be terminated.</returns>
+        bool const abortCurrent() const;
+
+        /// <summary>
+        /// Retrieves the evaluation horizon of the current Genome, after which its evaluation should end.
+        /// </summary>
+        /// <returns>Horizon in [s], 0 if the full evaluation is raced.</returns>
+        float const currentHorizon() const;
+
+        /// <summary>
+        /// Indicates the Gym to advance to the next Genome, for the fitness test.
+        /// </summary>
+        /// <param name="complete">Whenever the evaluation ran to its end, aborted and horizon cut ones are neither cached nor kept as progress curves.</param>
+        void advanceInTrain( bool const & complete = true );
+
+        /// <summary>
+        /// Leases the next genome of the generation requiring evaluation, to a car racing alongside others.
+        /// </summary>
+        /// <remarks>
+        /// Leases follow the generation order, the generation advances once every genome returned.
+        /// Genomes in the fitness cache return at once, early termination and successive halving only apply to a single car, steady-state training can't lease and fails the fleet build.
+        /// </remarks>
+        /// <param name="lease">Leased genome identifier, valid till returned.</param>
+        /// <returns>Whenever a genome was leased, false while the remaining genomes of the generation are leased.</returns>
+        bool const leaseGenome( size_t & lease );
+
+        /// <summary>
+        /// Calculates outputs according to a leased genome network.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluateLeased( size_t const & lease, std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs ) const;
+
+        /// <summary>
+        /// Compiles a leased genome network, or takes it prepared, then prepares the next leases in background.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="phenotype">Phenotype to build.</param>
+        void compileLeased( size_t const & lease, Phenotype & phenotype );
+
+        /// <summary>
+        /// Returns a leased genome with the fitness of its evaluation.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="fitness">The fitness of the evaluation.</param>
+        void returnGenome( size_t const & lease, float const & fitness );
+
+        /// <summary>
+        /// Describes the current Genome, for its evaluation telemetry.
+        /// </summary>
+        /// <param name="generation">Current AI generation.</param>
+        /// <param name="species">Genome species index.</param>
+        /// <param name="hash">Genome structural hash.</param>
+        /// <param name="genes">Genome gene number.</param>
+        /// <param name="neurons">Genome neuron number.</param>
+        void describeCurrent( size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const;
+
+        /// <summary>
+        /// Describes a leased genome, for its evaluation telemetry.
+        /// </summary>
+        /// <param name="lease">Leased genome identifier.</param>
+        /// <param name="generation">Current AI generation.</param>
+        /// <param name="species">Genome species index.</param>
+        /// <param name="hash">Genome structural hash.</param>
+        /// <param name="genes">Genome gene number.</param>
+        /// <param name="neurons">Genome neuron number.</param>
+        void describeLeased( size_t const & lease, size_t & generation, size_t & species, unsigned long long & hash, size_t & genes, size_t & neurons ) const;
+
+        /// <summary>
+        /// Retrieves current training generation and species number in generation, as well current top fitness.
+        /// </summary>
+        /// <param name="generation">Current AI generation.</param>
+        /// <param name="species">Number of species in generation.</param>
+        /// <param name="fitness">Current fitness.</param>
+        /// <param name="top_fitness">Top fitness.</param>
+        /// <param name="top_genes">Top gene number.</param>
+        /// <param name="top_neurons">Top neuron number.</param>
+        void getInformation( size_t & generation, size_t & species, float & fitness, float & top_fitness, size_t & top_genes, size_t & top_neurons ) const;
+
+        /// <summary>
+        /// Redirects the generation console lines and reports, so a driver can write them away from its driving thread.
+        /// </summary>
+        /// <param name="print">Prints a console line, without its end.</param>
+        /// <param name="append">Appends contents to a file, by file name and contents.</param>
+        void redirectOutput( std::function<void( std::string const & )> const & print, std::function<void( std::string const &, std::string const & )> const & append );
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gym utilities.                                                        *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Retrieves current genome in training.
+        /// </summary>
+        /// <returns>The current genome reference.</returns>
+        Genome const & currentGenome() const;
+        /// <summary>
+        /// Retrieves current genome in training.
+        /// </summary>
+        /// <returns>The current genome reference.</returns>
+        Genome & currentGenome();
+
+        /// <summary>
+        /// Advances to the next Genome, if all species were evaluated advances generation.
+        /// </summary>
+        void advanceGenome();
+
+        /// <summary>
+        /// Uses the cached fitness of the current genome instead of evaluating it, if it was sampled enough.
+        /// </summary>
+        /// <returns>Whenever the current genome evaluation was skipped.</returns>
+        bool const skipCachedGenome();
+
+        /// <summary>
+        /// Adds genome to a similar species, if none is found creates one for it.
+        /// </summary>
+        /// <param name="genome">Genome to add.</param>
+        /// <param name="first_species">Index of the first species to compare with.</param>
+        /// <returns>Index of the species that received the genome.</returns>
+        size_t const addGenomeToRespectiveSpecies( Genome & genome, size_t const & first_species = 0 );
+
+        /// <summary>
+        /// Adds a batch of genomes to similar species, comparing them with the current species in parallel and assigning them in batch order.
+        /// </summary>
+        /// <remarks>
+        /// Results are the same as adding each genome in order with addGenomeToRespectiveSpecies.
+        /// Genomes matching no current species open new ones in rounds, every round compares the genomes left with the last opened species in parallel.
+        /// With many species, only the candidates of a species index are compared, which keeps the same results while the index misses no matching species.
+        /// </remarks>
+        /// <param name="genomes">Genomes to add.</param>
+        void addGenomesToRespectiveSpecies( std::vector<Genome> & genomes );
+
+        /// <summary>
+        /// Advances generation by:
+        ///     - Culling half of every species;
+        ///     - Removing stale species;
+        ///     - Remove weak species;
+        ///     - Breed new children
+        ///     - Culling everything but top species;
+        ///     - Add children to species.
+        /// </summary>
+        void advanceGeneration();
+
+        /// <summary>
+        /// Eliminates either half or every but the best genome in every species, also orders every specie's genomes by descending order.
+        /// </summary>
+        /// <param name="half_cull">Trigger half culling or full culling.</param>
+        void cullSpecies( bool const & half_cull = false );
+
+        /// <summary>
+        /// Updates every species survival threshold, and with Settings::EARLY_ABORT_ELITE_CURVES its elite progress gains from its survivors curves, must follow a half culling.
+        /// </summary>
+        void updateEliteCurves();
+
+        /// <summary>
+        /// Removes all stale species from current generation. Also orders species by their best genome fitness.
+        /// </summary>
+        /// <remarks>
+        /// A specie is considered stale if has over Settings::SPECIES_STALE_THRESHOLD genomes and no progress was made.
+        /// </remarks>
+        void removeStaleSpecies();
+
+        /// <summary>
+        /// Removes all weak species from current generation.
+        /// </summary>
+        /// <remarks>
+        /// A specie is considered weak if has no breed chance.
+        /// </remarks>
+        void removeWeakSpecies();
+
+        /// <summary>
+        /// Calculates the total average fitness of all species.
+        /// </summary>
+        /// <returns>The total average calculated fitness.</returns>
+        float const totalAverageFitness() const;
+
+        /// <summary>
+        /// Breed all children till population target.
+        /// </summary>
+        /// <returns>The breed children.</returns>
+        std::vector<Genome> const breedChildren() const;
+
+        /// <summary>
+        /// Checks if the current generation exchanges genomes with the other islands.
+        /// </summary>
+        /// <returns>Whenever it is a migration generation.</returns>
+        bool const migrationGeneration() const;
+
+        /// <summary>
+        /// Retrieves the best genome of the top species, to send to the other islands.
+        /// </summary>
+        /// <returns>Up to Settings::ISLAND_MIGRANTS genomes.</returns>
+        std::vector<Genome> const selectEmigrants() const;
+
+        /// <summary>
+        /// Appends the population memory and bloat of the current generation to the memory report, and prints its totals.
+        /// </summary>
+        /// <remarks>
+        /// Used bytes count genomes and genes, capacity bytes add the species, genome and gene buffers capacity.
+        /// Every species reports the min / median / max genes and neurons of its genomes.
+        /// </remarks>
+        void reportMemory();
+
+        /// <summary>
+        /// Raises the memory high-water mark to the current footprint of the population and the genomes bred next to it.
+        /// </summary>
+        /// <param name="children">Genomes alive outside the population.</param>
+        void sampleMemory( std::vector<Genome> const & children );
+
+        /// <summary>
+        /// Compacts every genome of every species every Settings::COMPACT_INTERVAL generations, keeping the disabled genes speciation compares.
+        /// </summary>
+        void compactPopulation();
+
+        /// <summary>
+        /// Advances the steady-state evolution by:
+        ///     - Recording the finished evaluation in its species statistics;
+        ///     - Selecting the next not yet evaluated genome, if any;
+        ///     - Removing the stale species every population size replacements;
+        ///     - Otherwise replacing the worst eligible genome by a new child and selecting it.
+        /// </summary>
+        void advanceSteadyState();
+
+        /// <summary>
+        /// Sets the first not yet evaluated genome as current.
+        /// </summary>
+        /// <returns>Whenever a not evaluated genome was found.</returns>
+        bool const selectUnevaluatedGenome();
+
+        /// <summary>
+        /// Removes the eligible genome with the worst fitness adjusted by its species size.
+        /// </summary>
+        /// <remarks>
+        /// Eligible genomes are evaluated, at least Settings::STEADY_STATE_MIN_AGE evaluations old and not their species champion, so no species is emptied.
+        /// </remarks>
+        /// <returns>Whenever a genome was removed.</returns>
+        bool const removeWorstGenome();
+
+        /// <summary>
+        /// Breeds a child from a species chosen proportionally to its evaluated average fitness.
+        /// </summary>
+        /// <returns>The breed child.</returns>
+        Genome breedSteadyStateChild() const;
+
+        /// <summary>
+        /// Starts the successive halving of the current generation, every genome races the first rung.
+        /// </summary>
+        void startHalving();
+
+        /// <summary>
+        /// Advances the successive halving by:
+        ///     - Recording the finished evaluation in its contender;
+        ///     - Selecting the next contender of the rung, if any;
+        ///     - Otherwise promoting the best rung contenders to the next rung;
+        ///     - After the last rung, normalizing fitness, advancing generation and starting a new halving.
+        /// </summary>
+        void advanceHalving();
+
+        /// <summary>
+        /// Starts leasing the genomes of the current generation.
+        /// </summary>
+        void startLeasing();
+
+        /// <summary>
+        /// Counts a returned genome, advancing generation once every genome of the generation returned.
+        /// </summary>
+        void completeLease();
+
+        /// <summary>
+        /// Checks if the current Genome races the full evaluation, always true without successive halving.
+        /// </summary>
+        /// <returns>Whenever current rung is the last one.</returns>
+        bool const fullEvaluation() const;
+
+        /// <summary>
+        /// Scales the fitness of every contender eliminated before the last rung, to the full evaluation of the finalists.
+        /// </summary>
+        /// <remarks>
+        /// Each rung scale is the ratio between the finalists full evaluation fitness sum and their fitness sum in that rung.
+        /// </remarks>
+        void normalizeContenders();
+    };
+}
+
+#endif
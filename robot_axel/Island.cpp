@@ -0,0 +1,194 @@
+/***************************************************************************
+
+    file                 : Island.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Island.hpp"
+
+#if defined (ROBOT_AXEL_ISLAND)
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#if !defined (_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RobotAxel
+{
+    static_assert( std::atomic<unsigned long long>::is_always_lock_free && std::atomic<unsigned int>::is_always_lock_free, "Shared memory atomics must be lock free." );
+
+    /***************************************************************************
+     *                                                                         *
+     *   Island interface.                                                     *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Maps the shared mailbox if there are several islands and the AXEL_ISLAND environment variable holds a valid index.
+    /// </summary>
+    Island::Island() : index( 0 ), mailbox( nullptr ), shared_memory( std::string( SHARED_MEMORY ) + "_" + Settings::BUILD_LAYOUT.name ), received( {} )
+    {
+        if ( Settings::ISLANDS < 2 ) return;
+        char const * island = std::getenv( "AXEL_ISLAND" );
+        if ( island == nullptr ) return;
+        this->index = static_cast<size_t>( std::strtoul( island, nullptr, 10 ) );
+        if ( this->index >= Settings::ISLANDS )
+        {
+            std::cout << "Island " << this->index << " out of range, migration disabled" << std::endl;
+            return;
+        }
+#if defined (_WIN32)
+        std::cout << "Island migration needs POSIX shared memory, migration disabled" << std::endl;
+#else
+        // first island creates the zeroed mailbox, others of the same layout map the same one
+        int descriptor = shm_open( this->shared_memory.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR );
+        if ( descriptor < 0 ) return;
+        if ( ftruncate( descriptor, sizeof( Mailbox ) ) != 0 )
+        {
+            close( descriptor );
+            return;
+        }
+        void * memory = mmap( nullptr, sizeof( Mailbox ), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0 );
+        close( descriptor );
+        if ( memory == MAP_FAILED ) return;
+        this->mailbox = static_cast<Mailbox *>( memory );
+        this->mailbox->attached.fetch_add( 1, std::memory_order_acq_rel );
+        // migrants left by previous runs are ignored
+        for ( size_t slot = 0; slot < Settings::ISLANDS; slot++ )
+        {
+            this->received[ slot ] = this->mailbox->slots[ slot ].sequence.load( std::memory_order_acquire );
+        }
+        std::cout << "Island " << this->index << " of " << Settings::ISLANDS << " connected" << std::endl;
+#endif
+    }
+
+    /// <summary>
+    /// Unmaps the shared mailbox, removing it if no other island is attached, innovations continue locally.
+    /// </summary>
+    Island::~Island()
+    {
+        if ( this->mailbox == nullptr ) return;
+        if ( Settings::shared_innovation == &this->mailbox->innovation ) Settings::shared_innovation = nullptr;
+#if !defined (_WIN32)
+        // an island attaching meanwhile keeps its mapping, later ones create a new mailbox
+        bool const last = this->mailbox->attached.fetch_sub( 1, std::memory_order_acq_rel ) == 1;
+        munmap( this->mailbox, sizeof( Mailbox ) );
+        if ( last ) shm_unlink( this->shared_memory.c_str() );
+#endif
+    }
+
+    /// <summary>
+    /// Checks if the island is connected to the others.
+    /// </summary>
+    /// <returns>Whenever migration is enabled.</returns>
+    bool const Island::isConnected() const
+    {
+        return this->mailbox != nullptr;
+    }
+
+    /// <summary>
+    /// Uses the islands shared innovation counter from now on, must follow the top genome creation.
+    /// </summary>
+    void Island::shareInnovation() const
+    {
+        if ( this->mailbox == nullptr ) return;
+        Settings::shareInnovation( &this->mailbox->innovation );
+    }
+
+    /// <summary>
+    /// Publishes migrants in this island slot, replacing the previous ones.
+    /// </summary>
+    /// <param name="migrants">Genomes to send, the ones not fitting in the slot are dropped.</param>
+    /// <returns>Number of genomes sent.</returns>
+    size_t const Island::emigrate( std::vector<Genome> const & migrants )
+    {
+        if ( this->mailbox == nullptr ) return 0;
+        // pack every fitting genome after the count
+        unsigned int count = 0;
+        std::vector<unsigned char> bytes( sizeof( unsigned int ), 0 );
+        for ( Genome const & migrant : migrants )
+        {
+            size_t const previous = bytes.size();
+            migrant.pack( bytes );
+            if ( bytes.size() > Settings::ISLAND_SLOT_BYTES )
+            {
+                bytes.resize( previous );
+                break;
+            }
+            count++;
+        }
+        std::memcpy( bytes.data(), &count, sizeof( unsigned int ) );
+        // single writer sequence lock, readers retry while odd or changed
+        Slot & slot = this->mailbox->slots[ this->index ];
+        unsigned long long const sequence = slot.sequence.load( std::memory_order_relaxed );
+        slot.sequence.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        slot.bytes = bytes.size();
+        std::memcpy( slot.data, bytes.data(), bytes.size() );
+        slot.sequence.store( sequence + 2, std::memory_order_release );
+        this->received[ this->index ] = sequence + 2;
+        return count;
+    }
+
+    /// <summary>
+    /// Retrieves the migrants of other islands published since the last call.
+    /// </summary>
+    /// <param name="migrants">Received genomes are appended, without fitness.</param>
+    /// <returns>Number of genomes received.</returns>
+    size_t const Island::immigrate( std::vector<Genome> & migrants )
+    {
+        if ( this->mailbox == nullptr ) return 0;
+        size_t total = 0;
+        std::vector<unsigned char> bytes = {};
+        for ( size_t island = 0; island < Settings::ISLANDS; island++ )
+        {
+            if ( island == this->index ) continue;
+            Slot const & slot = this->mailbox->slots[ island ];
+            // copy a consistent snapshot, the writer only holds the lock while copying, and may have died holding it
+            unsigned long long sequence = 0;
+            bool consistent = false;
+            for ( size_t attempt = 0; attempt < Settings::ISLAND_READ_RETRIES && !consistent; attempt++ )
+            {
+                sequence = slot.sequence.load( std::memory_order_acquire );
+                if ( sequence % 2 == 1 ) continue;
+                size_t const size = std::min( slot.bytes, Settings::ISLAND_SLOT_BYTES );
+                bytes.resize( size );
+                std::memcpy( bytes.data(), slot.data, size );
+                std::atomic_thread_fence( std::memory_order_acquire );
+                consistent = slot.sequence.load( std::memory_order_relaxed ) == sequence;
+            }
+            // still being written, or nothing new
+            if ( !consistent || sequence == this->received[ island ] ) continue;
+            this->received[ island ] = sequence;
+            // unpack migrants
+            unsigned int count = 0;
+            if ( bytes.size() < sizeof( unsigned int ) ) continue;
+            std::memcpy( &count, bytes.data(), sizeof( unsigned int ) );
+            unsigned char const * position = bytes.data() + sizeof( unsigned int );
+            unsigned char const * const end = bytes.data() + bytes.size();
+            for ( unsigned int migrant = 0; migrant < count; migrant++ )
+            {
+                Genome genome = Genome();
+                if ( !genome.unpack( position, end ) ) break;
+                genome.setFitness( 0.0f );
+                migrants.push_back( genome );
+                total++;
+            }
+        }
+        return total;
+    }
+}
+
+#endif
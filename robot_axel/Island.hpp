@@ -0,0 +1,164 @@
+/***************************************************************************
+
+    file                 : Island.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_ISLAND
+#define ROBOT_AXEL_ISLAND
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Genome.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Island of the multi-process island model, exchanges migrant genomes with the other islands through a shared memory mailbox.
+    /// </summary>
+    /// <remarks>
+    /// Every island owns a mailbox slot, written by it alone and read by all others under a sequence lock, there is no coordinator process.
+    /// Islands also share the gene innovation counter, so innovations stay unique across islands.
+    /// The last island to detach removes the shared memory, islands that crashed leave it for the next run. Without POSIX shared memory islands never connect.
+    /// </remarks>
+    class Island
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Slot and Mailbox classes.                                             *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Migrants of an island, as a genome count followed by the packed genomes.
+        /// </summary>
+        class Slot
+        {
+            // Friendship declarations
+            friend class Island;
+
+            /// <summary>
+            /// Sequence lock, odd while the island is writing.
+            /// </summary>
+            std::atomic<unsigned long long> sequence;
+            /// <summary>
+            /// Written bytes.
+            /// </summary>
+            size_t bytes;
+            /// <summary>
+            /// Packed migrants.
+            /// </summary>
+            unsigned char data[ Settings::ISLAND_SLOT_BYTES ];
+        };
+
+        /// <summary>
+        /// Shared memory layout.
+        /// </summary>
+        class Mailbox
+        {
+            // Friendship declarations
+            friend class Island;
+
+            /// <summary>
+            /// Shared gene innovation counter.
+            /// </summary>
+            std::atomic<unsigned int> innovation;
+            /// <summary>
+            /// Attached islands.
+            /// </summary>
+            std::atomic<unsigned int> attached;
+            /// <summary>
+            /// Every island slot.
+            /// </summary>
+            Slot slots[ Settings::ISLANDS ];
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Island local constants and variables.                                 *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Shared memory object name, common to every island, followed by the sensor layout name.
+        /// </summary>
+        constexpr static char const * const SHARED_MEMORY = "/robot_axel_islands";
+        /// <summary>
+        /// This island index.
+        /// </summary>
+        size_t index;
+        /// <summary>
+        /// Mapped shared memory, null if migration is disabled.
+        /// </summary>
+        Mailbox * mailbox;
+        /// <summary>
+        /// Shared memory object name, of the sensor layout.
+        /// </summary>
+        std::string shared_memory;
+        /// <summary>
+        /// Last received sequence of every island slot.
+        /// </summary>
+        std::array<unsigned long long, Settings::ISLANDS> received;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Island interface.                                                     *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Maps the shared mailbox if there are several islands and the AXEL_ISLAND environment variable holds a valid index.
+        /// </summary>
+        Island();
+
+        /// <summary>
+        /// Unmaps the shared mailbox, removing it if no other island is attached, innovations continue locally.
+        /// </summary>
+        ~Island();
+
+        /// <summary>
+        /// Islands own their mapping and can't be copied.
+        /// </summary>
+        Island( Island const & other ) = delete;
+        Island & operator= ( Island const & other ) = delete;
+
+        /// <summary>
+        /// Checks if the island is connected to the others.
+        /// </summary>
+        /// <returns>Whenever migration is enabled.</returns>
+        bool const isConnected() const;
+
+        /// <summary>
+        /// Uses the islands shared innovation counter from now on, must follow the top genome creation.
+        /// </summary>
+        void shareInnovation() const;
+
+        /// <summary>
+        /// Publishes migrants in this island slot, replacing the previous ones.
+        /// </summary>
+        /// <param name="migrants">Genomes to send, the ones not fitting in the slot are dropped.</param>
+        /// <returns>Number of genomes sent.</returns>
+        size_t const emigrate( std::vector<Genome> const & migrants );
+
+        /// <summary>
+        /// Retrieves the migrants of other islands published since the last call.
+        /// </summary>
+        /// <param name="migrants">Received genomes are appended, without fitness.</param>
+        /// <returns>Number of genomes received.</returns>
+        size_t const immigrate( std::vector<Genome> & migrants );
+    };
+}
+
+#endif
@@ -0,0 +1,367 @@
+/***************************************************************************
+
+    file                 : Phenotype.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Phenotype.hpp"
+
+#if defined (ROBOT_AXEL_PHENOTYPE)
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Phenotype interface.                                                  *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates an empty phenotype, with reserved buffers, evaluating nothing till built.
+    /// </summary>
+    Phenotype::Phenotype()
+        : total_neurons( 0 ), first_links( {} ), connected( {} ), link_origins( {} ), link_weights( {} ), values( {} ), specialized( false ),
+        constant_inputs( {} ), constant_values( {} ), biases( {} ), constant_neurons( {} ), first_outgoing( {} ),
+        outgoing_destinations( {} ), outgoing_weights( {} ), sums( {} ), sum_changes( {} ), changed( {} ), feed_forward( false ), refresh_countdown( 0 )
+    {
+        this->first_links.reserve( Settings::NEURON_LIMIT + 1 );
+        this->connected.reserve( Settings::NEURON_LIMIT );
+        this->values.reserve( Settings::NEURON_LIMIT );
+        this->biases.reserve( Settings::NEURON_LIMIT );
+        // initial genomes fully link inputs to outputs
+        this->link_origins.reserve( 2 * Settings::INPUTS * Settings::OUTPUTS );
+        this->link_weights.reserve( 2 * Settings::INPUTS * Settings::OUTPUTS );
+        if ( !Settings::INCREMENTAL_EVALUATION ) return;
+        this->first_outgoing.reserve( Settings::NEURON_LIMIT + 1 );
+        this->outgoing_destinations.reserve( 2 * Settings::INPUTS * Settings::OUTPUTS );
+        this->outgoing_weights.reserve( 2 * Settings::INPUTS * Settings::OUTPUTS );
+        this->sums.reserve( Settings::NEURON_LIMIT );
+        this->sum_changes.reserve( Settings::NEURON_LIMIT );
+        this->changed.reserve( Settings::NEURON_LIMIT );
+    }
+
+    /// <summary>
+    /// Compiles a genome network, replacing the previous one.
+    /// </summary>
+    /// <param name="genome">Genome to compile.</param>
+    void Phenotype::build( Genome const & genome )
+    {
+        // no genes, evaluates nothing as the genome
+        this->total_neurons = genome.network.empty() ? 0 : genome.total_neurons;
+        this->first_links.assign( this->total_neurons + 1, 0 );
+        this->connected.assign( this->total_neurons, false );
+        this->values.assign( this->total_neurons, 0.0f );
+        this->biases.assign( this->total_neurons, 0.0f );
+        // count enabled links per destination, placing them after every lower neuron links
+        size_t total_links = 0;
+        for ( Genome::Gene const & gene : genome.network )
+        {
+            if ( gene.to >= this->total_neurons || gene.to < Settings::INPUTS ) continue;
+            this->connected[ gene.to ] = true;
+            if ( !gene.enabled ) continue;
+            this->first_links[ gene.to + 1 ]++;
+            total_links++;
+        }
+        for ( size_t index = 0; index < this->total_neurons; index++ ) this->first_links[ index + 1 ] += this->first_links[ index ];
+        // fill links in network order, every neuron start advances to its end
+        this->link_origins.resize( total_links );
+        this->link_weights.resize( total_links );
+        for ( Genome::Gene const & gene : genome.network )
+        {
+            if ( gene.to >= this->total_neurons || gene.to < Settings::INPUTS || !gene.enabled ) continue;
+            size_t const link = this->first_links[ gene.to ]++;
+            this->link_origins[ link ] = gene.from;
+            this->link_weights[ link ] = gene.weight;
+        }
+        // every end is the next neuron start, shift back
+        for ( size_t index = this->total_neurons; index > 0; index-- ) this->first_links[ index ] = this->first_links[ index - 1 ];
+        this->first_links[ 0 ] = 0;
+        if ( this->specialized ) fold();
+        this->refresh_countdown = 0;
+        if ( !Settings::INCREMENTAL_EVALUATION ) return;
+
+        // outgoing links, links from a higher neuron always read 0 and are left out, links from a neuron to itself read its partial sum and need full passes
+        this->feed_forward = true;
+        this->first_outgoing.assign( this->total_neurons + 1, 0 );
+        size_t total_outgoing = 0;
+        for ( size_t destination = Settings::INPUTS; destination < this->total_neurons; destination++ )
+        {
+            for ( size_t link = this->first_links[ destination ]; link < this->first_links[ destination + 1 ]; link++ )
+            {
+                this->feed_forward = this->feed_forward && this->link_origins[ link ] != destination;
+                if ( this->link_origins[ link ] >= destination ) continue;
+                this->first_outgoing[ this->link_origins[ link ] + 1 ]++;
+                total_outgoing++;
+            }
+        }
+        for ( size_t index = 0; index < this->total_neurons; index++ ) this->first_outgoing[ index + 1 ] += this->first_outgoing[ index ];
+        this->outgoing_destinations.resize( total_outgoing );
+        this->outgoing_weights.resize( total_outgoing );
+        for ( size_t destination = Settings::INPUTS; destination < this->total_neurons; destination++ )
+        {
+            for ( size_t link = this->first_links[ destination ]; link < this->first_links[ destination + 1 ]; link++ )
+            {
+                if ( this->link_origins[ link ] >= destination ) continue;
+                size_t const outgoing = this->first_outgoing[ this->link_origins[ link ] ]++;
+                this->outgoing_destinations[ outgoing ] = destination;
+                this->outgoing_weights[ outgoing ] = this->link_weights[ link ];
+            }
+        }
+        for ( size_t index = this->total_neurons; index > 0; index-- ) this->first_outgoing[ index ] = this->first_outgoing[ index - 1 ];
+        this->first_outgoing[ 0 ] = 0;
+        this->sums.assign( this->total_neurons, 0.0f );
+        this->sum_changes.assign( this->total_neurons, 0.0f );
+        this->changed.assign( this->total_neurons, false );
+    }
+
+    /// <summary>
+    /// Declares the inputs held constant by the driving scenario, every later build folds their links into the neuron biases.
+    /// </summary>
+    /// <param name="constant">Whenever every input is constant.</param>
+    /// <param name="values">Value of every constant input.</param>
+    void Phenotype::specialize( std::array<bool, Settings::INPUTS> const & constant, std::array<float, Settings::INPUTS> const & values )
+    {
+        this->specialized = true;
+        this->constant_inputs = constant;
+        this->constant_values = values;
+        this->constant_neurons.reserve( Settings::NEURON_LIMIT );
+    }
+
+    /// <summary>
+    /// Declares the same constant inputs as another phenotype, or none if it isn't specialized.
+    /// </summary>
+    /// <param name="phenotype">Phenotype to match.</param>
+    void Phenotype::specializeAs( Phenotype const & phenotype )
+    {
+        if ( phenotype.specialized ) specialize( phenotype.constant_inputs, phenotype.constant_values );
+        else
+        {
+            this->specialized = false;
+            this->constant_neurons.clear();
+        }
+    }
+
+    /// <summary>
+    /// Calculates outputs according to the compiled network.
+    /// </summary>
+    /// <param name="outputs">Array with output neurons values.</param>
+    /// <param name="inputs">The input array used for the update.</param>
+    void Phenotype::evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs )
+    {
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            assert( inputs[ index ] >= 0.0f && inputs[ index ] <= 1.0f );
+        }
+        // no genes, do nothing
+        if ( this->total_neurons == 0 ) return;
+        // incremental update of a refreshed feed forward network, unless too much changed
+        bool const incremental = Settings::INCREMENTAL_EVALUATION && this->feed_forward && this->refresh_countdown > 0;
+        if ( incremental && incrementalPass( inputs ) ) this->refresh_countdown--;
+        else fullPass( inputs );
+
+        size_t output_neuron_offset = this->total_neurons - Settings::OUTPUTS;
+        // retrieve outputs
+        for ( size_t index = 0; index < Settings::OUTPUTS; index++ )
+        {
+            outputs[ index ] = this->values[ index + output_neuron_offset ];
+        }
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Phenotype utilities.                                                  *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Folds the links from constant neurons into the biases, neurons only linked from constant neurons become constant.
+    /// </summary>
+    /// <remarks>
+    /// Links from higher neurons always read 0 and are dropped. Neurons linked to themselves keep their other links unfolded, as a link from itself reads the partial sum.
+    /// </remarks>
+    void Phenotype::fold()
+    {
+        this->constant_neurons.clear();
+        if ( this->total_neurons == 0 ) return;
+        // constant neurons and their values, unconnected neurons are constant at 0
+        std::vector<bool> constant( this->total_neurons, false );
+        std::vector<float> constant_value( this->total_neurons, 0.0f );
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            if ( !this->constant_inputs[ index ] ) continue;
+            constant[ index ] = true;
+            constant_value[ index ] = this->constant_values[ index ];
+            this->constant_neurons.push_back( { index, this->constant_values[ index ] } );
+        }
+        // links are moved down in place, a neuron start is only overwritten after its links were read
+        size_t kept = 0;
+        size_t read = this->first_links[ Settings::INPUTS ];
+        for ( size_t index = Settings::INPUTS; index < this->total_neurons; index++ )
+        {
+            size_t const end = this->first_links[ index + 1 ];
+            this->first_links[ index ] = kept;
+            bool linked_to_itself = false;
+            bool linked_constant = true;
+            for ( size_t link = read; link < end; link++ )
+            {
+                size_t const origin = this->link_origins[ link ];
+                linked_to_itself = linked_to_itself || origin == index;
+                linked_constant = linked_constant && ( origin >= index || constant[ origin ] );
+            }
+            if ( !this->connected[ index ] ) constant[ index ] = true;
+            // value known now, evaluated once as a full pass would
+            else if ( linked_constant )
+            {
+                float value = 0.0f;
+                for ( size_t link = read; link < end; link++ )
+                {
+                    size_t const origin = this->link_origins[ link ];
+                    float const origin_value = origin < index ? constant_value[ origin ] : origin == index ? value : 0.0f;
+                    value += origin_value * this->link_weights[ link ];
+                }
+                value = ( Settings::SIGMOID_RANGE / ( 1 + std::exp( Settings::SIGMOID_GROWTH_RATE * value ) ) ) + Settings::SIGMOID_OFFSET;
+                constant[ index ] = true;
+                constant_value[ index ] = value;
+                this->connected[ index ] = false;
+                this->constant_neurons.push_back( { index, value } );
+            }
+            // partial sums read by a link from itself, links are kept in order, links from higher neurons read 0
+            else if ( linked_to_itself )
+            {
+                for ( size_t link = read; link < end; link++ )
+                {
+                    if ( this->link_origins[ link ] > index ) continue;
+                    this->link_origins[ kept ] = this->link_origins[ link ];
+                    this->link_weights[ kept ] = this->link_weights[ link ];
+                    kept++;
+                }
+            }
+            // constant links start the sum, links from higher neurons read 0
+            else
+            {
+                for ( size_t link = read; link < end; link++ )
+                {
+                    size_t const origin = this->link_origins[ link ];
+                    if ( origin > index ) continue;
+                    if ( constant[ origin ] ) this->biases[ index ] += constant_value[ origin ] * this->link_weights[ link ];
+                    else
+                    {
+                        this->link_origins[ kept ] = origin;
+                        this->link_weights[ kept ] = this->link_weights[ link ];
+                        kept++;
+                    }
+                }
+            }
+            read = end;
+        }
+        this->first_links[ this->total_neurons ] = kept;
+        this->link_origins.resize( kept );
+        this->link_weights.resize( kept );
+    }
+
+    /// <summary>
+    /// Evaluates every neuron from the inputs, as the Genome.
+    /// </summary>
+    /// <param name="inputs">The input array used for the update.</param>
+    void Phenotype::fullPass( std::array<float, Settings::INPUTS> const & inputs )
+    {
+        // update input neurons, the others start at 0 as links from not yet evaluated neurons read 0
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            this->values[ index ] = inputs[ index ];
+        }
+        std::fill( this->values.begin() + Settings::INPUTS, this->values.end(), 0.0f );
+        // folded neurons keep their value
+        for ( std::pair<size_t, float> const & constant : this->constant_neurons ) this->values[ constant.first ] = constant.second;
+
+        // update network
+        for ( size_t index = Settings::INPUTS; index < this->total_neurons; index++ )
+        {
+            // no incoming, continue
+            if ( !this->connected[ index ] ) continue;
+            // calculate sum of all enabled incoming links values, in place as a link from itself reads the partial sum
+            float & value = this->values[ index ];
+            value = this->biases[ index ];
+            for ( size_t link = this->first_links[ index ]; link < this->first_links[ index + 1 ]; link++ )
+            {
+                value += this->values[ this->link_origins[ link ] ] * this->link_weights[ link ];
+            }
+            if ( Settings::INCREMENTAL_EVALUATION ) this->sums[ index ] = value;
+            // treat sum result
+            value = ( Settings::SIGMOID_RANGE / ( 1 + std::exp( Settings::SIGMOID_GROWTH_RATE * value ) ) ) + Settings::SIGMOID_OFFSET;
+        }
+        if ( !Settings::INCREMENTAL_EVALUATION ) return;
+        // a given up incremental pass may have left changes pending
+        std::fill( this->sum_changes.begin(), this->sum_changes.end(), 0.0f );
+        std::fill( this->changed.begin(), this->changed.end(), false );
+        this->refresh_countdown = Settings::INCREMENTAL_REFRESH;
+    }
+
+    /// <summary>
+    /// Propagates the changed inputs through the neurons they reach, giving up once too many links were updated.
+    /// </summary>
+    /// <remarks>
+    /// Giving up leaves the inputs updated and the neurons partially updated, a full pass must follow.
+    /// </remarks>
+    /// <param name="inputs">The input array used for the update.</param>
+    /// <returns>Whenever the update finished.</returns>
+    bool const Phenotype::incrementalPass( std::array<float, Settings::INPUTS> const & inputs )
+    {
+        // link budget, a fraction of the links a full pass updates
+        size_t const link_limit = static_cast<size_t>( Settings::INCREMENTAL_LINK_LIMIT * static_cast<float>( this->link_origins.size() ) );
+        size_t updated_links = 0;
+        size_t first_changed = this->total_neurons;
+        // propagates a value change to the sums of the neurons it links to
+        auto propagate = [ & ]( size_t const neuron, float const change )
+        {
+            for ( size_t link = this->first_outgoing[ neuron ]; link < this->first_outgoing[ neuron + 1 ]; link++ )
+            {
+                size_t const destination = this->outgoing_destinations[ link ];
+                this->sum_changes[ destination ] += change * this->outgoing_weights[ link ];
+                this->changed[ destination ] = true;
+                first_changed = destination < first_changed ? destination : first_changed;
+            }
+            updated_links += this->first_outgoing[ neuron + 1 ] - this->first_outgoing[ neuron ];
+            return updated_links <= link_limit;
+        };
+
+        // changed inputs, giving up before any update if their links alone are too many
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            if ( inputs[ index ] != this->values[ index ] ) updated_links += this->first_outgoing[ index + 1 ] - this->first_outgoing[ index ];
+        }
+        if ( updated_links > link_limit ) return false;
+        updated_links = 0;
+        for ( size_t index = 0; index < Settings::INPUTS; index++ )
+        {
+            if ( inputs[ index ] == this->values[ index ] ) continue;
+            float const change = inputs[ index ] - this->values[ index ];
+            this->values[ index ] = inputs[ index ];
+            if ( !propagate( index, change ) ) return false;
+        }
+        // reached neurons, in index order as links only go to higher neurons
+        for ( size_t index = first_changed; index < this->total_neurons; index++ )
+        {
+            if ( !this->changed[ index ] ) continue;
+            this->changed[ index ] = false;
+            this->sums[ index ] += this->sum_changes[ index ];
+            this->sum_changes[ index ] = 0.0f;
+            float const value = ( Settings::SIGMOID_RANGE / ( 1 + std::exp( Settings::SIGMOID_GROWTH_RATE * this->sums[ index ] ) ) ) + Settings::SIGMOID_OFFSET;
+            float const change = value - this->values[ index ];
+            this->values[ index ] = value;
+            if ( change != 0.0f && !propagate( index, change ) ) return false;
+        }
+        return true;
+    }
+}
+
+#endif
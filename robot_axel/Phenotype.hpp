@@ -0,0 +1,194 @@
+/***************************************************************************
+
+    file                 : Phenotype.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_PHENOTYPE
+#define ROBOT_AXEL_PHENOTYPE
+
+#include <array>
+#include <utility>
+#include <vector>
+#include "Genome.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Compiled Genome network, evaluates the same outputs as the Genome without allocating.
+    /// </summary>
+    /// <remarks>
+    /// Incoming links are stored contiguously per neuron, in network order, so sums are added in the same order as the Genome evaluation.
+    /// Buffers are reserved for NEURON_LIMIT neurons and keep their capacity when rebuilt, a rebuild only allocates if the genome outgrew them.
+    /// With Settings::INCREMENTAL_EVALUATION, networks without links from a neuron to itself keep their neuron sums and only propagate the inputs that changed through the
+    /// neurons they reach, sums then drift by rounding and a full pass refreshes them every Settings::INCREMENTAL_REFRESH evaluations.
+    /// A specialized phenotype folds the links from inputs declared constant, and from neurons that only depend on them, into per neuron biases.
+    /// </remarks>
+    class Phenotype
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype local constants and variables.                              *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Number of neurons, 0 for a genome without genes.
+        /// </summary>
+        size_t total_neurons;
+        /// <summary>
+        /// Index of the first incoming link of every neuron, with the links end as last element.
+        /// </summary>
+        std::vector<size_t> first_links;
+        /// <summary>
+        /// Whenever every neuron has incoming genes, enabled or not, a neuron without any keeps its value.
+        /// </summary>
+        std::vector<bool> connected;
+        /// <summary>
+        /// Origin neuron of every enabled link.
+        /// </summary>
+        std::vector<size_t> link_origins;
+        /// <summary>
+        /// Weight of every enabled link.
+        /// </summary>
+        std::vector<float> link_weights;
+        /// <summary>
+        /// Neuron values, of the last evaluation.
+        /// </summary>
+        std::vector<float> values;
+        /// <summary>
+        /// Whenever builds fold the constant inputs.
+        /// </summary>
+        bool specialized;
+        /// <summary>
+        /// Inputs held constant by the driving scenario ( Specialized only ).
+        /// </summary>
+        std::array<bool, Settings::INPUTS> constant_inputs;
+        /// <summary>
+        /// Values of the constant inputs ( Specialized only ).
+        /// </summary>
+        std::array<float, Settings::INPUTS> constant_values;
+        /// <summary>
+        /// Sum of the folded links of every neuron, the start of its sum.
+        /// </summary>
+        std::vector<float> biases;
+        /// <summary>
+        /// Constant inputs and linked neurons whose value was folded, with their value ( Specialized only ).
+        /// </summary>
+        std::vector<std::pair<size_t, float>> constant_neurons;
+        /// <summary>
+        /// Index of the first outgoing link of every neuron, with the links end as last element ( Incremental only ).
+        /// </summary>
+        std::vector<size_t> first_outgoing;
+        /// <summary>
+        /// Destination neuron of every enabled link to a higher neuron, by origin ( Incremental only ).
+        /// </summary>
+        std::vector<size_t> outgoing_destinations;
+        /// <summary>
+        /// Weight of every enabled link to a higher neuron, by origin ( Incremental only ).
+        /// </summary>
+        std::vector<float> outgoing_weights;
+        /// <summary>
+        /// Neuron sums before the sigmoid, of the last evaluation ( Incremental only ).
+        /// </summary>
+        std::vector<float> sums;
+        /// <summary>
+        /// Pending sum changes of every neuron ( Incremental only ).
+        /// </summary>
+        std::vector<float> sum_changes;
+        /// <summary>
+        /// Neurons with pending sum changes ( Incremental only ).
+        /// </summary>
+        std::vector<bool> changed;
+        /// <summary>
+        /// Whenever no enabled link goes from a neuron to itself, so neurons can be updated in index order ( Incremental only ).
+        /// </summary>
+        bool feed_forward;
+        /// <summary>
+        /// Evaluations left till a full pass, 0 when the values are not from a full pass of the current network ( Incremental only ).
+        /// </summary>
+        size_t refresh_countdown;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype interface.                                                  *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates an empty phenotype, with reserved buffers, evaluating nothing till built.
+        /// </summary>
+        Phenotype();
+
+        /// <summary>
+        /// Compiles a genome network, replacing the previous one.
+        /// </summary>
+        /// <param name="genome">Genome to compile.</param>
+        void build( Genome const & genome );
+
+        /// <summary>
+        /// Declares the inputs held constant by the driving scenario, every later build folds their links into the neuron biases.
+        /// </summary>
+        /// <remarks>
+        /// Constant inputs are evaluated with their declared values, whatever the inputs given.
+        /// </remarks>
+        /// <param name="constant">Whenever every input is constant.</param>
+        /// <param name="values">Value of every constant input.</param>
+        void specialize( std::array<bool, Settings::INPUTS> const & constant, std::array<float, Settings::INPUTS> const & values );
+
+        /// <summary>
+        /// Declares the same constant inputs as another phenotype, or none if it isn't specialized.
+        /// </summary>
+        /// <param name="phenotype">Phenotype to match.</param>
+        void specializeAs( Phenotype const & phenotype );
+
+        /// <summary>
+        /// Calculates outputs according to the compiled network.
+        /// </summary>
+        /// <param name="outputs">Array with output neurons values.</param>
+        /// <param name="inputs">The input array used for the update.</param>
+        void evaluate( std::array <float, Settings::OUTPUTS> & outputs, std::array<float, Settings::INPUTS> const & inputs );
+
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype utilities.                                                  *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Folds the links from constant neurons into the biases, neurons only linked from constant neurons become constant.
+        /// </summary>
+        /// <remarks>
+        /// Links from higher neurons always read 0 and are dropped. Neurons linked to themselves keep their other links unfolded, as a link from itself reads the partial sum.
+        /// </remarks>
+        void fold();
+
+        /// <summary>
+        /// Evaluates every neuron from the inputs, as the Genome.
+        /// </summary>
+        /// <param name="inputs">The input array used for the update.</param>
+        void fullPass( std::array<float, Settings::INPUTS> const & inputs );
+
+        /// <summary>
+        /// Propagates the changed inputs through the neurons they reach, giving up once too many links were updated.
+        /// </summary>
+        /// <remarks>
+        /// Giving up leaves the inputs updated and the neurons partially updated, a full pass must follow.
+        /// </remarks>
+        /// <param name="inputs">The input array used for the update.</param>
+        /// <returns>Whenever the update finished.</returns>
+        bool const incrementalPass( std::array<float, Settings::INPUTS> const & inputs );
+    };
+}
+
+#endif
@@ -0,0 +1,179 @@
+/***************************************************************************
+
+    file                 : Phenotype_Pipeline.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Phenotype_Pipeline.hpp"
+
+#if defined (ROBOT_AXEL_PHENOTYPE_PIPELINE)
+
+#include <algorithm>
+#include <utility>
+#if defined (__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Slot class.                                                           *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates an empty slot, with reserved buffers.
+    /// </summary>
+    Phenotype_Pipeline::Slot::Slot() : genome( nullptr ), source(), state( EMPTY ), order( 0 ), phenotype() {}
+
+    /***************************************************************************
+     *                                                                         *
+     *   Phenotype_Pipeline interface.                                         *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates an idle pipeline, with reserved slots.
+    /// </summary>
+    Phenotype_Pipeline::Phenotype_Pipeline() : slots( Settings::PREPARED_PHENOTYPES ), mutex(), wake(), stopping( false ), builder() {}
+
+    /// <summary>
+    /// Stops the pipeline thread, dropping the queued builds.
+    /// </summary>
+    Phenotype_Pipeline::~Phenotype_Pipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock( this->mutex );
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+        if ( this->builder.joinable() ) this->builder.join();
+    }
+
+    /// <summary>
+    /// Queues the next genomes in training, keeping the slots already holding one of them and reusing the others.
+    /// </summary>
+    /// <param name="genomes">Next genomes in training, in training order, the ones past the slots are left out.</param>
+    /// <param name="phenotype">Phenotype whose specialization the builds follow.</param>
+    void Phenotype_Pipeline::prepare( std::vector<Genome const *> const & genomes, Phenotype const & phenotype )
+    {
+        if ( this->slots.empty() ) return;
+        size_t const prepared = std::min( genomes.size(), this->slots.size() );
+        {
+            std::lock_guard<std::mutex> lock( this->mutex );
+            // slots of genomes still upcoming keep their phenotype, others are reused, the one being built is abandoned
+            for ( Slot & slot : this->slots )
+            {
+                if ( slot.state == EMPTY || slot.state == ABANDONED ) continue;
+                auto const upcoming = std::find( genomes.begin(), genomes.begin() + prepared, slot.genome );
+                if ( upcoming != genomes.begin() + prepared ) slot.order = static_cast<size_t>( upcoming - genomes.begin() );
+                else slot.state = ( slot.state == BUILDING ? ABANDONED : EMPTY );
+            }
+            for ( size_t index = 0; index < prepared; index++ )
+            {
+                auto const held = std::find_if( this->slots.begin(), this->slots.end(), [ & ]( Slot const & slot ) { return slot.state != EMPTY && slot.state != ABANDONED && slot.genome == genomes[ index ]; } );
+                if ( held != this->slots.end() ) continue;
+                auto const free_slot = std::find_if( this->slots.begin(), this->slots.end(), []( Slot const & slot ) { return slot.state == EMPTY; } );
+                if ( free_slot == this->slots.end() ) break;
+                free_slot->genome = genomes[ index ];
+                free_slot->source = *genomes[ index ];
+                free_slot->order = index;
+                free_slot->phenotype.specializeAs( phenotype );
+                free_slot->state = QUEUED;
+            }
+            if ( !this->builder.joinable() ) this->builder = std::thread( &Phenotype_Pipeline::run, this );
+        }
+        this->wake.notify_all();
+    }
+
+    /// <summary>
+    /// Takes the phenotype prepared for a genome, abandoning it if still being built.
+    /// </summary>
+    /// <param name="genome">Genome to race.</param>
+    /// <param name="phenotype">Phenotype to build, swapped with the prepared one.</param>
+    /// <returns>Whenever a prepared phenotype was taken, otherwise the phenotype is left to build.</returns>
+    bool const Phenotype_Pipeline::take( Genome const & genome, Phenotype & phenotype )
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        auto const slot = std::find_if( this->slots.begin(), this->slots.end(), [ & ]( Slot const & slot ) { return slot.state != EMPTY && slot.state != ABANDONED && slot.genome == &genome; } );
+        if ( slot == this->slots.end() ) return false;
+        // not started, building here is as fast
+        if ( slot->state == QUEUED )
+        {
+            slot->state = EMPTY;
+            return false;
+        }
+        // started, the builder may be preempted for long, so it is left to finish alone and the driver builds its own
+        if ( slot->state == BUILDING )
+        {
+            slot->state = ABANDONED;
+            return false;
+        }
+        std::swap( phenotype, slot->phenotype );
+        slot->state = EMPTY;
+        return true;
+    }
+
+    /// <summary>
+    /// Drops every prepared phenotype before the population genomes change, abandoning the build in progress.
+    /// </summary>
+    void Phenotype_Pipeline::clear()
+    {
+        std::lock_guard<std::mutex> lock( this->mutex );
+        // the build in progress reads its own genome copy, so it is left to finish alone
+        for ( Slot & slot : this->slots )
+        {
+            if ( slot.state == BUILDING ) slot.state = ABANDONED;
+            else if ( slot.state != ABANDONED ) slot.state = EMPTY;
+        }
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Phenotype_Pipeline utilities.                                         *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Pipeline thread loop, builds the queued slots till stopped.
+    /// </summary>
+    void Phenotype_Pipeline::run()
+    {
+#if defined (__linux__)
+        // builds yield to the driver ticks, still getting a CPU share under load as the driver never waits on them
+        setpriority( PRIO_PROCESS, static_cast<id_t>( syscall( SYS_gettid ) ), BUILDER_NICENESS );
+#endif
+        std::unique_lock<std::mutex> lock( this->mutex );
+        while ( true )
+        {
+            // queued slots are built in training order
+            auto queued = [ this ]
+            {
+                auto next = this->slots.end();
+                for ( auto slot = this->slots.begin(); slot != this->slots.end(); slot++ )
+                {
+                    if ( slot->state == QUEUED && ( next == this->slots.end() || slot->order < next->order ) ) next = slot;
+                }
+                return next;
+            };
+            this->wake.wait( lock, [ & ] { return this->stopping || queued() != this->slots.end(); } );
+            if ( this->stopping ) break;
+            Slot & slot = *queued();
+            slot.state = BUILDING;
+            // slot is left alone while building, prepare and take only change its state
+            lock.unlock();
+            slot.phenotype.build( slot.source );
+            lock.lock();
+            slot.state = ( slot.state == ABANDONED ? EMPTY : READY );
+        }
+    }
+}
+
+#endif
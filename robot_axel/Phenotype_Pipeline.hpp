@@ -0,0 +1,183 @@
+/***************************************************************************
+
+    file                 : Phenotype_Pipeline.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_PHENOTYPE_PIPELINE
+#define ROBOT_AXEL_PHENOTYPE_PIPELINE
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Genome.hpp"
+#include "Phenotype.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Background builder of the compiled networks of the next genomes in training, so a restart only swaps the prepared network in.
+    /// </summary>
+    /// <remarks>
+    /// Holds Settings::PREPARED_PHENOTYPES phenotypes, built by a single thread from copies of the genomes, so the population can change while a build runs.
+    /// Genomes are told apart by address only, the Gym must clear the pipeline before moving, replacing or changing any population genome.
+    /// The driver never waits on the builder: a build still running when taken or cleared is abandoned, and the driver builds the phenotype itself.
+    /// A taken phenotype is swapped with the caller one, whose buffers are reused by the next build, so nothing is allocated on restart.
+    /// </remarks>
+    class Phenotype_Pipeline
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Slot class.                                                           *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Slot without genome.
+        /// </summary>
+        constexpr static size_t const EMPTY = 0;
+        /// <summary>
+        /// Slot waiting for the pipeline thread.
+        /// </summary>
+        constexpr static size_t const QUEUED = 1;
+        /// <summary>
+        /// Slot being built by the pipeline thread.
+        /// </summary>
+        constexpr static size_t const BUILDING = 2;
+        /// <summary>
+        /// Slot built, ready to be taken.
+        /// </summary>
+        constexpr static size_t const READY = 3;
+        /// <summary>
+        /// Slot being built by the pipeline thread after being taken or cleared, emptied once the build ends.
+        /// </summary>
+        constexpr static size_t const ABANDONED = 4;
+        /// <summary>
+        /// Niceness of the pipeline thread, builds yield to the driver without being starved by it.
+        /// </summary>
+        constexpr static int const BUILDER_NICENESS = 10;
+
+        /// <summary>
+        /// Phenotype prepared for a genome.
+        /// </summary>
+        class Slot
+        {
+            // Friendship declarations
+            friend class Phenotype_Pipeline;
+
+            /// <summary>
+            /// Address of the genome to build, null if empty, never dereferenced.
+            /// </summary>
+            Genome const * genome;
+            /// <summary>
+            /// Copy of the genome to build, reusing its buffers across preparations.
+            /// </summary>
+            Genome source;
+            /// <summary>
+            /// Slot state.
+            /// </summary>
+            size_t state;
+            /// <summary>
+            /// Position of the genome in the training order of the last preparation, lower slots are built first.
+            /// </summary>
+            size_t order;
+            /// <summary>
+            /// Compiled genome network.
+            /// </summary>
+            Phenotype phenotype;
+
+            public:
+            /// <summary>
+            /// Generates an empty slot, with reserved buffers.
+            /// </summary>
+            Slot();
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype_Pipeline local constants and variables.                     *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Prepared phenotypes.
+        /// </summary>
+        std::vector<Slot> slots;
+        /// <summary>
+        /// Slots lock.
+        /// </summary>
+        std::mutex mutex;
+        /// <summary>
+        /// Wakes the pipeline thread on queued slots or stop.
+        /// </summary>
+        std::condition_variable wake;
+        /// <summary>
+        /// Whenever the pipeline thread should stop.
+        /// </summary>
+        bool stopping;
+        /// <summary>
+        /// Pipeline thread, started on the first preparation.
+        /// </summary>
+        std::thread builder;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype_Pipeline interface.                                         *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates an idle pipeline, with reserved slots.
+        /// </summary>
+        Phenotype_Pipeline();
+
+        /// <summary>
+        /// Stops the pipeline thread, dropping the queued builds.
+        /// </summary>
+        ~Phenotype_Pipeline();
+
+        /// <summary>
+        /// Queues the next genomes in training, keeping the slots already holding one of them and reusing the others.
+        /// </summary>
+        /// <param name="genomes">Next genomes in training, in training order, the ones past the slots are left out.</param>
+        /// <param name="phenotype">Phenotype whose specialization the builds follow.</param>
+        void prepare( std::vector<Genome const *> const & genomes, Phenotype const & phenotype );
+
+        /// <summary>
+        /// Takes the phenotype prepared for a genome, abandoning it if still being built.
+        /// </summary>
+        /// <param name="genome">Genome to race.</param>
+        /// <param name="phenotype">Phenotype to build, swapped with the prepared one.</param>
+        /// <returns>Whenever a prepared phenotype was taken, otherwise the phenotype is left to build.</returns>
+        bool const take( Genome const & genome, Phenotype & phenotype );
+
+        /// <summary>
+        /// Drops every prepared phenotype before the population genomes change, abandoning the build in progress.
+        /// </summary>
+        void clear();
+
+        /***************************************************************************
+         *                                                                         *
+         *   Phenotype_Pipeline utilities.                                         *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Pipeline thread loop, builds the queued slots till stopped.
+        /// </summary>
+        void run();
+    };
+}
+
+#endif
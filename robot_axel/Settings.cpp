@@ -1,36 +1,53 @@
-/***************************************************************************
-
-    file                 : Settings.cpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#include "Settings.hpp"
-
-#if defined (ROBOT_AXEL_SETTINGS)
-
-namespace RobotAxel
-{
-    /// <summary>
-    /// Current innovation number.
-    /// </summary>
-    unsigned int Settings::current_innovation = 0;
-
-    /// <summary>
-    /// Retrieve Gene innovation.
-    /// </summary>
-    /// <returns>Current innovation number.</returns>
-    unsigned int const Settings::newInnovation()
-    {
-        current_innovation++;
-        return current_innovation;
-    }
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Settings.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Settings.hpp"
+
+#if defined (ROBOT_AXEL_SETTINGS)
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Current innovation number.
+    /// </summary>
+    unsigned int Settings::current_innovation = 0;
+
+    /// <summary>
+    /// Innovation counter shared between processes, null if not shared.
+    /// </summary>
+    std::atomic<unsigned int> * Settings::shared_innovation = nullptr;
+
+    /// <summary>
+    /// Retrieve Gene innovation.
+    /// </summary>
+    /// <returns>Current innovation number.</returns>
+    unsigned int const Settings::newInnovation()
+    {
+        if ( shared_innovation != nullptr ) current_innovation = shared_innovation->fetch_add( 1 ) + 1;
+        else current_innovation++;
+        return current_innovation;
+    }
+
+    /// <summary>
+    /// Uses a shared innovation counter from now on, raising it to the current innovation number if below.
+    /// </summary>
+    /// <param name="counter">Shared counter.</param>
+    void Settings::shareInnovation( std::atomic<unsigned int> * counter )
+    {
+        unsigned int shared = counter->load();
+        while ( shared < current_innovation && !counter->compare_exchange_weak( shared, current_innovation ) );
+        shared_innovation = counter;
+    }
+}
+
+#endif
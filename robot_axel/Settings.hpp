@@ -1,186 +1,418 @@
-/***************************************************************************
-
-    file                 : Settings.hpp
-    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
-
- ***************************************************************************/
-
-/***************************************************************************
- *                                                                         *
- *   MarI/O source code made by SethBling was used as a creation base.     *
- *                                                                         *
- ***************************************************************************/
-
-#pragma once
-
-#ifndef ROBOT_AXEL_SETTINGS
-#define ROBOT_AXEL_SETTINGS
-
-#include <cstdlib>
-
-namespace RobotAxel
-{
-    /// <summary>
-    /// Axel AI, an evolutionary AI implementation for TORCS, based on NEAT.
-    /// </summary>
-    class Settings
-    {
-        public:
-        /***************************************************************************
-         *                                                                         *
-         *   Global settings.                                                      *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// AI input number.
-        /// </summary>
-        /// <remarks>
-        /// Order of inputs must always be the same, any changes requires a new AI creation.
-        /// </remarks>
-        constexpr static int const INPUTS = 76;
-        /// <summary>
-        /// AI output number.
-        /// </summary>
-        /// <remarks>
-        /// Order of outputs will stay the same independently of AI evolution.
-        /// </remarks>
-        constexpr static int const OUTPUTS = 6;
-        /// <summary>
-        /// Maximum AI decision neurons (have in mind, in a critical case, all neurons are interconnected, except inputs).
-        /// </summary>
-        /// <remarks>
-        /// Numeric limit is: size_t >= (limit - inputs) * limit
-        /// </remarks>
-        constexpr static size_t const NEURON_LIMIT = 1000;
-        /// <summary>
-        /// Is basic genome composed by a full linked input/output, or no links at all.
-        /// </summary>
-        constexpr static bool const BASIC_FULL_LINK = true;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Gym and species settings.                                             *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Maximum population between species
-        /// </summary>
-        constexpr static int const GYM_POPULATION = 100;
-        /// <summary>
-        /// Minimum breed count for a species to be considered not week.
-        /// </summary>
-        constexpr static int const SPECIES_BREED_THRESHOLD = 3;
-        /// <summary>
-        /// Genome minimum for a species to be considered stale.
-        /// </summary>
-        constexpr static int const SPECIES_STALE_THRESHOLD = 5;
-        /// <summary>
-        /// Genome disjoint rating multiplier.
-        /// </summary>
-        constexpr static float const SPECIES_DELTA_DIJOINT = 0.4f;
-        /// <summary>
-        /// Genome weight comparison multiplier.
-        /// </summary>
-        constexpr static float const SPECIES_DELTA_WEIGHTS = 0.6f;
-        /// <summary>
-        /// Max diference to be considered from a specie.
-        /// </summary>
-        constexpr static float const SPECIES_DELTA_THRESHOLD = 0.5f;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Node link weight and value normalization settings.                    *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Gene link weight range, as in [0 to range].
-        /// </summary>
-        constexpr static float const LINK_RANGE = 2.0f;
-        /// <summary>
-        /// Gene link weight offset, as in [offset to range + offset].
-        /// </summary>
-        constexpr static float const LINK_OFFSET = -1.0f;
-        /// <summary>
-        /// Value sigmoid normalization range [0 to range].
-        /// </summary>
-        constexpr static float const SIGMOID_RANGE = 2.0f;
-        /// <summary>
-        /// Value sigmoid growth rate, how fast reaches the limit.
-        /// </summary>
-        constexpr static float const SIGMOID_GROWTH_RATE = -4.9f;
-        /// <summary>
-        /// Value sigmoid offset, as in [offset to range + offset].
-        /// </summary>
-        constexpr static float const SIGMOID_OFFSET = -1.0f;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Mutation settings.                                                    *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Chance for a genome structure change, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_WEIGHT_CHANCE = 0.4f;
-        /// <summary>
-        /// Chance for a complete gene weight change, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_WEIGHT_ALL_CHANCE = 0.3f;
-        /// <summary>
-        /// Chance for a new random weight, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_WEIGHT_NEW_RANDOM_CHANCE = 0.2f;
-        /// <summary>
-        /// Deviation range of weight modification.
-        /// </summary>
-        constexpr static float const MUTATE_WEIGHT_DEVIATION_RANGE = 0.2f;
-        /// <summary>
-        /// Chance for a node mutation, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_NODE_CHANCE = 0.3f;
-        /// <summary>
-        /// Chance for a link mutation, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_LINK_CHANCE = 0.3f;
-        /// <summary>
-        /// Chance for a state mutation, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_STATE_CHANCE = 0.5f;
-        /// <summary>
-        /// Chance for a full neuron incoming state mutation, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const MUTATE_STATE_INVERT_ALL_NEURON_GENES_CHANCE = 0.0f;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Crossover settings.                                                   *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Chance for a crossover between two genomes of the same species.
-        /// </summary>
-        constexpr static float const CROSSOVER_CHANCE = 0.75f;
-        /// <summary>
-        /// Chance for a gene addition in crossover, between [0.0f, 1.0f], triggers if below chance value.
-        /// </summary>
-        constexpr static float const CROSSOVER_GENE_ADDITION = 0.5f;
-
-        /***************************************************************************
-         *                                                                         *
-         *   Gene innovation counter.                                              *
-         *                                                                         *
-         ***************************************************************************/
-        /// <summary>
-        /// Current innovation number.
-        /// </summary>
-        static unsigned int current_innovation;
-
-        /// <summary>
-        /// Retrieve Gene innovation.
-        /// </summary>
-        /// <returns>Current innovation number.</returns>
-        static unsigned int const newInnovation();
-    };
-}
-
-#endif
+/***************************************************************************
+
+    file                 : Settings.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_SETTINGS
+#define ROBOT_AXEL_SETTINGS
+
+#include <atomic>
+#include <cstdlib>
+
+// Sensor layout of the build, such as -D AXEL_BUILD_LAYOUT=SOLO_LAYOUT
+#if !defined (AXEL_BUILD_LAYOUT)
+#define AXEL_BUILD_LAYOUT FULL_LAYOUT
+#endif
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Axel AI, an evolutionary AI implementation for TORCS, based on NEAT.
+    /// </summary>
+    class Settings
+    {
+        public:
+        /***************************************************************************
+         *                                                                         *
+         *   Global settings.                                                      *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Sensor layout, the sensor groups read as AI inputs.
+        /// </summary>
+        /// <remarks>
+        /// Gear, rpm, angle, fuel, speed, z, damage, track position and wheel spin are always read.
+        /// </remarks>
+        struct Layout
+        {
+            /// <summary>
+            /// Layout name, keeps the islands of different layouts apart.
+            /// </summary>
+            char const * name;
+            /// <summary>
+            /// Whenever the 5 focus sensors and their reliability are read.
+            /// </summary>
+            bool focus;
+            /// <summary>
+            /// Track range finders read, evenly spread from -90 to 90 [deg], followed by their reliability.
+            /// </summary>
+            int track;
+            /// <summary>
+            /// Whenever the 36 opponent sensors are read.
+            /// </summary>
+            bool opponents;
+        };
+        /// <summary>
+        /// Every sensor, 76 inputs.
+        /// </summary>
+        constexpr static Layout const FULL_LAYOUT = { "full", true, 19, true };
+        /// <summary>
+        /// Every sensor but the opponents, for single car races, 40 inputs.
+        /// </summary>
+        constexpr static Layout const SOLO_LAYOUT = { "solo", true, 19, false };
+        /// <summary>
+        /// Basic sensors and 9 track range finders every 22.5 [deg], 24 inputs.
+        /// </summary>
+        constexpr static Layout const MINIMAL_LAYOUT = { "minimal", false, 9, false };
+        /// <summary>
+        /// Sensor layout of the build, chosen with AXEL_BUILD_LAYOUT, one per binary.
+        /// </summary>
+        /// <remarks>
+        /// INPUTS sizes every input array and numbers the genome neurons, so Genome, Gym and AI are only built for this layout.
+        /// Layouts are compared by building a binary per layout, genomes of a layout can't be read by another, train every layout in its own directory.
+        /// </remarks>
+        constexpr static Layout const BUILD_LAYOUT = AXEL_BUILD_LAYOUT;
+        /// <summary>
+        /// Basic inputs, read by every layout.
+        /// </summary>
+        constexpr static int const BASIC_INPUTS = 14;
+        /// <summary>
+        /// Focus inputs, sensors followed by their reliability.
+        /// </summary>
+        constexpr static int const FOCUS_INPUTS = BUILD_LAYOUT.focus ? 5 + 1 : 0;
+        /// <summary>
+        /// Track inputs, range finders followed by their reliability.
+        /// </summary>
+        constexpr static int const TRACK_INPUTS = BUILD_LAYOUT.track + 1;
+        /// <summary>
+        /// Opponent inputs.
+        /// </summary>
+        constexpr static int const OPPONENT_INPUTS = BUILD_LAYOUT.opponents ? 36 : 0;
+        /// <summary>
+        /// AI input number.
+        /// </summary>
+        /// <remarks>
+        /// Order of inputs must always be the same, any changes requires a new AI creation.
+        /// </remarks>
+        constexpr static int const INPUTS = BASIC_INPUTS + FOCUS_INPUTS + TRACK_INPUTS + OPPONENT_INPUTS;
+        /// <summary>
+        /// AI output number.
+        /// </summary>
+        /// <remarks>
+        /// Order of outputs will stay the same independently of AI evolution.
+        /// </remarks>
+        constexpr static int const OUTPUTS = 6;
+        /// <summary>
+        /// Maximum AI decision neurons (have in mind, in a critical case, all neurons are interconnected, except inputs).
+        /// </summary>
+        /// <remarks>
+        /// Numeric limit is: size_t >= (limit - inputs) * limit
+        /// </remarks>
+        constexpr static size_t const NEURON_LIMIT = 1000;
+        /// <summary>
+        /// Is basic genome composed by a full linked input/output, or no links at all.
+        /// </summary>
+        constexpr static bool const BASIC_FULL_LINK = true;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gym and species settings.                                             *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Maximum population between species
+        /// </summary>
+        constexpr static int const GYM_POPULATION = 100;
+        /// <summary>
+        /// Steady-state evolution (rtNEAT), after every evaluation the worst evaluated genome is replaced by a new child instead of advancing whole generations.
+        /// </summary>
+        constexpr static bool const GYM_STEADY_STATE = false;
+        /// <summary>
+        /// Evaluations a steady-state genome survives before it can be replaced (rtNEAT minimum lifetime), so a child is never replaced right after its evaluation.
+        /// </summary>
+        constexpr static int const STEADY_STATE_MIN_AGE = GYM_POPULATION / 10;
+        /// <summary>
+        /// Fitness cache, genomes with the same structural hash of a previous evaluation reuse its fitness.
+        /// </summary>
+        constexpr static bool const FITNESS_CACHE = true;
+        /// <summary>
+        /// Evaluations of the same genome before its episode is skipped, further evaluations re-sample and average its fitness.
+        /// </summary>
+        constexpr static size_t const FITNESS_CACHE_SAMPLES = 1;
+        /// <summary>
+        /// Fitness cache is loaded from and saved to file, only valid while track and appraisal don't change, so it is off by default.
+        /// </summary>
+        constexpr static bool const FITNESS_CACHE_PERSIST = false;
+        /// <summary>
+        /// Most genomes kept by the fitness cache, the least recently used quarter is evicted once exceeded.
+        /// </summary>
+        constexpr static size_t const FITNESS_CACHE_LIMIT = 200000;
+        /// <summary>
+        /// Early termination of evaluations whose progress upper bound is below their species survival threshold.
+        /// </summary>
+        /// <remarks>
+        /// The driver bounds the final progress from its fitness formula, at top speed till its evaluation time limit, so no genome able to survive is cut.
+        /// </remarks>
+        constexpr static bool const EARLY_ABORT = false;
+        /// <summary>
+        /// Extra early termination according to the progress curves of the species elites, on top of the progress bound.
+        /// </summary>
+        /// <remarks>
+        /// A heuristic, not a bound, a genome gaining more than EARLY_ABORT_SAFETY times any elite late in the race is wrongly cut, so it is off by default.
+        /// </remarks>
+        constexpr static bool const EARLY_ABORT_ELITE_CURVES = false;
+        /// <summary>
+        /// Progress curve sampling interval of the elite curves, in [s].
+        /// </summary>
+        constexpr static float const EARLY_ABORT_INTERVAL = 1.0f;
+        /// <summary>
+        /// Minimum evaluation time before an elite curves termination, in [s].
+        /// </summary>
+        constexpr static float const EARLY_ABORT_MIN_TIME = 10.0f;
+        /// <summary>
+        /// Multiplier of the best remaining progress gain of the elites, as in current progress + safety * gain &lt; threshold.
+        /// </summary>
+        constexpr static float const EARLY_ABORT_SAFETY = 1.5f;
+        /// <summary>
+        /// Population memory report, every generation appends the population bytes and bloat per species to genomes/memory_report.txt.
+        /// </summary>
+        constexpr static bool const MEMORY_REPORT = true;
+        /// <summary>
+        /// Champions are written compacted, a copy without every gene and hidden neuron that can't affect the outputs, the population keeps its history.
+        /// </summary>
+        constexpr static bool const COMPACT_CHAMPIONS = true;
+        /// <summary>
+        /// Compacts every surviving genome every COMPACT_INTERVAL generations, keeping disabled genes between live neurons for speciation, 0 never ( Generational only ).
+        /// </summary>
+        constexpr static size_t const COMPACT_INTERVAL = 0;
+        /// <summary>
+        /// Successive halving, every generation genomes race growing horizons and only the best of each rung are promoted to the next ( Generational only ).
+        /// </summary>
+        constexpr static bool const HALVING = false;
+        /// <summary>
+        /// Number of halving rungs, the last one races the full evaluation.
+        /// </summary>
+        constexpr static size_t const HALVING_RUNGS = 3;
+        /// <summary>
+        /// Halving rate, only 1 / eta of a rung genomes are promoted and the next rung horizon is eta times longer.
+        /// </summary>
+        constexpr static size_t const HALVING_ETA = 3;
+        /// <summary>
+        /// Horizon of the first halving rung, in [s].
+        /// </summary>
+        constexpr static float const HALVING_BASE_HORIZON = 20.0f;
+        /// <summary>
+        /// Minimum breed count for a species to be considered not week.
+        /// </summary>
+        constexpr static int const SPECIES_BREED_THRESHOLD = 3;
+        /// <summary>
+        /// Genome minimum for a species to be considered stale.
+        /// </summary>
+        constexpr static int const SPECIES_STALE_THRESHOLD = 5;
+        /// <summary>
+        /// Genome disjoint rating multiplier.
+        /// </summary>
+        constexpr static float const SPECIES_DELTA_DIJOINT = 0.4f;
+        /// <summary>
+        /// Genome weight comparison multiplier.
+        /// </summary>
+        constexpr static float const SPECIES_DELTA_WEIGHTS = 0.6f;
+        /// <summary>
+        /// Max diference to be considered from a specie.
+        /// </summary>
+        constexpr static float const SPECIES_DELTA_THRESHOLD = 0.5f;
+        /// <summary>
+        /// Number of threads comparing genomes with species representatives during speciation, 0 uses the hardware concurrency.
+        /// </summary>
+        constexpr static size_t const SPECIATION_THREADS = 0;
+        /// <summary>
+        /// Minimum genome comparisons per speciation thread, smaller batches and rounds use fewer threads.
+        /// </summary>
+        constexpr static size_t const SPECIATION_MIN_SHARE = 32;
+        /// <summary>
+        /// Minimum number of species for speciation to prune representatives with the MinHash species index, 0 disables the index.
+        /// </summary>
+        constexpr static size_t const SPECIES_INDEX_MIN_SPECIES = 64;
+        /// <summary>
+        /// Species index locality sensitive hashing bands.
+        /// </summary>
+        constexpr static size_t const SPECIES_INDEX_BANDS = 16;
+        /// <summary>
+        /// Species index MinHash values per band.
+        /// </summary>
+        constexpr static size_t const SPECIES_INDEX_ROWS = 2;
+        /// <summary>
+        /// Species index MinHash signature size.
+        /// </summary>
+        constexpr static size_t const SPECIES_INDEX_HASHES = SPECIES_INDEX_BANDS * SPECIES_INDEX_ROWS;
+        /// <summary>
+        /// Margin over the max difference allowed for the signature estimated difference of a candidate species.
+        /// </summary>
+        constexpr static float const SPECIES_INDEX_MARGIN = 0.25f;
+        /// <summary>
+        /// Compare with every species when no candidate species matches, only misses earlier species that would also match.
+        /// </summary>
+        constexpr static bool const SPECIES_INDEX_FALLBACK = true;
+        /// <summary>
+        /// Number of island processes exchanging genomes through shared memory, 1 disables migration. Island index is read from the AXEL_ISLAND environment variable.
+        /// </summary>
+        constexpr static size_t const ISLANDS = 1;
+        /// <summary>
+        /// Generations between migrations.
+        /// </summary>
+        constexpr static size_t const ISLAND_MIGRATION_INTERVAL = 5;
+        /// <summary>
+        /// Top species genomes sent by each island every migration.
+        /// </summary>
+        constexpr static size_t const ISLAND_MIGRANTS = 2;
+        /// <summary>
+        /// Shared memory bytes for the migrants of each island, larger migrant groups are trimmed.
+        /// </summary>
+        constexpr static size_t const ISLAND_SLOT_BYTES = 1 << 16;
+        /// <summary>
+        /// Reads of an island slot being written before its migrants are left for the next migration.
+        /// </summary>
+        constexpr static size_t const ISLAND_READ_RETRIES = 64;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Node link weight and value normalization settings.                    *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Gene link weight range, as in [0 to range].
+        /// </summary>
+        constexpr static float const LINK_RANGE = 2.0f;
+        /// <summary>
+        /// Gene link weight offset, as in [offset to range + offset].
+        /// </summary>
+        constexpr static float const LINK_OFFSET = -1.0f;
+        /// <summary>
+        /// Value sigmoid normalization range [0 to range].
+        /// </summary>
+        constexpr static float const SIGMOID_RANGE = 2.0f;
+        /// <summary>
+        /// Value sigmoid growth rate, how fast reaches the limit.
+        /// </summary>
+        constexpr static float const SIGMOID_GROWTH_RATE = -4.9f;
+        /// <summary>
+        /// Value sigmoid offset, as in [offset to range + offset].
+        /// </summary>
+        constexpr static float const SIGMOID_OFFSET = -1.0f;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Evaluation settings.                                                  *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Compiled networks only propagate the inputs that changed since the previous evaluation, through the neurons they reach.
+        /// </summary>
+        /// <remarks>
+        /// Outputs then differ from a full evaluation by rounding, till the next refresh.
+        /// </remarks>
+        constexpr static bool const INCREMENTAL_EVALUATION = false;
+        /// <summary>
+        /// Fraction of the network links an incremental evaluation may update before giving up for a full one.
+        /// </summary>
+        constexpr static float const INCREMENTAL_LINK_LIMIT = 0.1f;
+        /// <summary>
+        /// Incremental evaluations between full ones, which reset the rounding drift of the neuron sums.
+        /// </summary>
+        constexpr static size_t const INCREMENTAL_REFRESH = 100;
+        /// <summary>
+        /// Compiled networks of the next genomes in training built in background while the current one races, 0 builds them on restart ( Generational only ).
+        /// </summary>
+        constexpr static size_t const PREPARED_PHENOTYPES = 2;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Mutation settings.                                                    *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Chance for a genome structure change, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_WEIGHT_CHANCE = 0.4f;
+        /// <summary>
+        /// Chance for a complete gene weight change, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_WEIGHT_ALL_CHANCE = 0.3f;
+        /// <summary>
+        /// Chance for a new random weight, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_WEIGHT_NEW_RANDOM_CHANCE = 0.2f;
+        /// <summary>
+        /// Deviation range of weight modification.
+        /// </summary>
+        constexpr static float const MUTATE_WEIGHT_DEVIATION_RANGE = 0.2f;
+        /// <summary>
+        /// Chance for a node mutation, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_NODE_CHANCE = 0.3f;
+        /// <summary>
+        /// Chance for a link mutation, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_LINK_CHANCE = 0.3f;
+        /// <summary>
+        /// Chance for a state mutation, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_STATE_CHANCE = 0.5f;
+        /// <summary>
+        /// Chance for a full neuron incoming state mutation, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const MUTATE_STATE_INVERT_ALL_NEURON_GENES_CHANCE = 0.0f;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Crossover settings.                                                   *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Chance for a crossover between two genomes of the same species.
+        /// </summary>
+        constexpr static float const CROSSOVER_CHANCE = 0.75f;
+        /// <summary>
+        /// Chance for a gene addition in crossover, between [0.0f, 1.0f], triggers if below chance value.
+        /// </summary>
+        constexpr static float const CROSSOVER_GENE_ADDITION = 0.5f;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Gene innovation counter.                                              *
+         *                                                                         *
+         ***************************************************************************/
+        /// <summary>
+        /// Current innovation number.
+        /// </summary>
+        static unsigned int current_innovation;
+        /// <summary>
+        /// Innovation counter shared between processes, null if not shared.
+        /// </summary>
+        static std::atomic<unsigned int> * shared_innovation;
+
+        /// <summary>
+        /// Retrieve Gene innovation.
+        /// </summary>
+        /// <returns>Current innovation number.</returns>
+        static unsigned int const newInnovation();
+
+        /// <summary>
+        /// Uses a shared innovation counter from now on, raising it to the current innovation number if below.
+        /// </summary>
+        /// <param name="counter">Shared counter.</param>
+        static void shareInnovation( std::atomic<unsigned int> * counter );
+    };
+}
+
+#endif
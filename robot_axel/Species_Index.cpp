@@ -0,0 +1,143 @@
+/***************************************************************************
+
+    file                 : Species_Index.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "Species_Index.hpp"
+
+#if defined (ROBOT_AXEL_SPECIES_INDEX)
+
+#include <algorithm>
+#include <cmath>
+
+namespace RobotAxel
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Species_Index interface.                                              *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates an empty index.
+    /// </summary>
+    Species_Index::Species_Index() : signatures( {} ), buckets() {}
+
+    /// <summary>
+    /// Indexes the representative of the next species, species must be inserted in index order.
+    /// </summary>
+    /// <param name="representative">Species representative genome.</param>
+    void Species_Index::insert( Genome const & representative )
+    {
+        size_t species_index = this->signatures.size();
+        this->signatures.push_back( Signature( representative ) );
+        // add species to every band bucket
+        for ( size_t band = 0; band < Settings::SPECIES_INDEX_BANDS; band++ )
+        {
+            this->buckets[ band ][ this->signatures.back().bandKey( band ) ].push_back( species_index );
+        }
+    }
+
+    /// <summary>
+    /// Retrieves the species that plausibly contain the genome, in ascending index order.
+    /// </summary>
+    /// <param name="genome">Genome to check.</param>
+    /// <param name="candidates">Candidate species indexes.</param>
+    void Species_Index::candidates( Genome const & genome, std::vector<size_t> & candidates ) const
+    {
+        candidates.clear();
+        Signature signature = Signature( genome );
+        // gather species sharing at least one band
+        for ( size_t band = 0; band < Settings::SPECIES_INDEX_BANDS; band++ )
+        {
+            auto bucket = this->buckets[ band ].find( signature.bandKey( band ) );
+            if ( bucket == this->buckets[ band ].end() ) continue;
+            candidates.insert( candidates.end(), bucket->second.begin(), bucket->second.end() );
+        }
+        // species without genes are never hashed, they are always candidates
+        for ( size_t species_index = 0; species_index < this->signatures.size(); species_index++ )
+        {
+            if ( this->signatures[ species_index ].genes == 0 || signature.genes == 0 ) candidates.push_back( species_index );
+        }
+        // order and remove repetitions
+        std::sort( candidates.begin(), candidates.end() );
+        candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+        // keep species whose estimated difference is within the margin
+        candidates.erase(
+            std::remove_if(
+                candidates.begin(), candidates.end(),
+                [ & ]( size_t const & species_index )
+                { return this->signatures[ species_index ].estimateDelta( signature ) >= Settings::SPECIES_DELTA_THRESHOLD + Settings::SPECIES_INDEX_MARGIN; }
+            ),
+            candidates.end()
+        );
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Signature class.                                                      *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates the signature of a genome.
+    /// </summary>
+    /// <param name="genome">Genome to sign.</param>
+    Species_Index::Signature::Signature( Genome const & genome ) : hashes(), weights(), genes( genome.getTotalGenes() )
+    {
+        genome.signature( this->hashes, this->weights );
+    }
+
+    /// <summary>
+    /// Retrieves the key of a band of hashes.
+    /// </summary>
+    /// <param name="band">Band index.</param>
+    /// <returns>Band key.</returns>
+    unsigned long long const Species_Index::Signature::bandKey( size_t const & band ) const
+    {
+        // FNV-1a over the band hashes
+        unsigned long long key = 14695981039346656037ull;
+        for ( size_t row = 0; row < Settings::SPECIES_INDEX_ROWS; row++ )
+        {
+            key ^= this->hashes[ band * Settings::SPECIES_INDEX_ROWS + row ];
+            key *= 1099511628211ull;
+        }
+        return key;
+    }
+
+    /// <summary>
+    /// Estimates the species difference of the genome compare, with this signature as the representative.
+    /// </summary>
+    /// <param name="other">Signature of the genome to check.</param>
+    /// <returns>Estimated weighted sum of disjoint and weights difference.</returns>
+    float const Species_Index::Signature::estimateDelta( Signature const & other ) const
+    {
+        // no genes, exact comparison is cheap
+        if ( this->genes == 0 || other.genes == 0 ) return 0.0f;
+        // equal minimums estimate the jaccard similarity, their weights sample the coincident genes
+        float equal = 0.0f;
+        float weights = 0.0f;
+        for ( size_t function = 0; function < Settings::SPECIES_INDEX_HASHES; function++ )
+        {
+            if ( this->hashes[ function ] != other.hashes[ function ] ) continue;
+            equal += 1.0f;
+            weights += std::fabs( this->weights[ function ] - other.weights[ function ] );
+        }
+        float jaccard = equal / static_cast<float>( Settings::SPECIES_INDEX_HASHES );
+        weights = equal == 0.0f ? 0.0f : weights / equal;
+        // coincident genes from jaccard, J = C / ( A + B - C )
+        float total = static_cast<float>( this->genes + other.genes );
+        float coincident = jaccard * total / ( 1.0f + jaccard );
+        float disjoint = ( total - coincident ) / static_cast<float>( std::max( this->genes, other.genes ) );
+        // same weighting as the species comparison
+        return Settings::SPECIES_DELTA_DIJOINT * disjoint + Settings::SPECIES_DELTA_WEIGHTS * weights;
+    }
+}
+
+#endif
@@ -0,0 +1,124 @@
+/***************************************************************************
+
+    file                 : Species_Index.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   MarI/O source code made by SethBling was used as a creation base.     *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef ROBOT_AXEL_SPECIES_INDEX
+#define ROBOT_AXEL_SPECIES_INDEX
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include "Genome.hpp"
+#include "Settings.hpp"
+
+namespace RobotAxel
+{
+    /// <summary>
+    /// Species representatives index, retrieves the species that plausibly contain a genome using MinHash locality sensitive hashing over gene innovations.
+    /// </summary>
+    /// <remarks>
+    /// Candidates are a superset of the matching species unless the hashing misses one, candidates still require the exact species comparison.
+    /// </remarks>
+    class Species_Index
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Signature class.                                                      *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Genome MinHash signature with weight sketch.
+        /// </summary>
+        class Signature
+        {
+            // Friendship declarations
+            friend class Species_Index;
+
+            /// <summary>
+            /// Minimum innovation hash for every hash function.
+            /// </summary>
+            std::array<unsigned int, Settings::SPECIES_INDEX_HASHES> hashes;
+            /// <summary>
+            /// Weight of the gene with the minimum hash for every hash function.
+            /// </summary>
+            std::array<float, Settings::SPECIES_INDEX_HASHES> weights;
+            /// <summary>
+            /// Genome gene number.
+            /// </summary>
+            size_t genes;
+
+            /// <summary>
+            /// Generates the signature of a genome.
+            /// </summary>
+            /// <param name="genome">Genome to sign.</param>
+            Signature( Genome const & genome );
+
+            /// <summary>
+            /// Retrieves the key of a band of hashes.
+            /// </summary>
+            /// <param name="band">Band index.</param>
+            /// <returns>Band key.</returns>
+            unsigned long long const bandKey( size_t const & band ) const;
+
+            /// <summary>
+            /// Estimates the species difference of the genome compare, with this signature as the representative.
+            /// </summary>
+            /// <param name="other">Signature of the genome to check.</param>
+            /// <returns>Estimated weighted sum of disjoint and weights difference.</returns>
+            float const estimateDelta( Signature const & other ) const;
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Species_Index local constants and variables.                          *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Representative signature of every indexed species, by species index.
+        /// </summary>
+        std::vector<Signature> signatures;
+        /// <summary>
+        /// Species indexes with the same band key, for every band.
+        /// </summary>
+        std::array<std::unordered_map<unsigned long long, std::vector<size_t>>, Settings::SPECIES_INDEX_BANDS> buckets;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Species_Index interface.                                              *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates an empty index.
+        /// </summary>
+        Species_Index();
+
+        /// <summary>
+        /// Indexes the representative of the next species, species must be inserted in index order.
+        /// </summary>
+        /// <param name="representative">Species representative genome.</param>
+        void insert( Genome const & representative );
+
+        /// <summary>
+        /// Retrieves the species that plausibly contain the genome, in ascending index order.
+        /// </summary>
+        /// <param name="genome">Genome to check.</param>
+        /// <param name="candidates">Candidate species indexes.</param>
+        void candidates( Genome const & genome, std::vector<size_t> & candidates ) const;
+    };
+}
+
+#endif
@@ -0,0 +1,224 @@
+/***************************************************************************
+
+    file                 : Race.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Race.hpp"
+
+#if defined (SIMULATOR_RACE)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Simulator
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Race interface.                                                       *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates a race in the given track.
+    /// </summary>
+    /// <param name="track">Track to race, must outlive the race.</param>
+    Race::Race( Track const & track )
+        : track( track ), vehicle( Vehicle() ), hint( 0 ), angles( {} ), focus( 0 ), lap_time( 0.0f ), last_lap_time( 0.0f ), distance_raced( 0.0f ),
+        distance_from_start( 0.0f ), lateral( 0.0f ), track_heading( 0.0f ), damage( 0.0f ), laps( 0 ), ticks( 0 ), restart( false )
+    {
+        std::array<float, TRACK_SENSORS> angles = {};
+        for ( size_t sensor = 0; sensor < TRACK_SENSORS; sensor++ ) angles[ sensor ] = 10.0f * static_cast<float>( sensor ) - 90.0f;
+        reset( angles );
+    }
+
+    /// <summary>
+    /// Places the car at the start line and resets all counters.
+    /// </summary>
+    /// <param name="angles">Track range finders angles, in [deg].</param>
+    void Race::reset( std::array<float, TRACK_SENSORS> const & angles )
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float heading = 0.0f;
+        this->track.start( x, y, heading );
+        this->vehicle.reset( x, y, heading );
+        this->hint = 0;
+        this->angles = angles;
+        this->focus = 0;
+        this->lap_time = 0.0f;
+        this->last_lap_time = 0.0f;
+        this->distance_raced = 0.0f;
+        this->damage = 0.0f;
+        this->laps = 0;
+        this->ticks = 0;
+        this->restart = false;
+        this->track.project( x, y, this->hint, this->distance_from_start, this->lateral, this->track_heading );
+    }
+
+    /// <summary>
+    /// Applies a SCR control string and advances one game tick.
+    /// </summary>
+    /// <param name="control">Control string, as "(accel 1)(brake 0)(gear 1)(steer 0)(clutch 0)(focus 0)(meta 0)".</param>
+    void Race::drive( std::string const & control )
+    {
+        float accel = 0.0f;
+        float brake = 0.0f;
+        float clutch = 0.0f;
+        float steer = 0.0f;
+        int gear = this->vehicle.getGear();
+        // every "(name value)" group
+        size_t open = control.find( '(' );
+        while ( open != std::string::npos )
+        {
+            size_t const close = control.find( ')', open );
+            if ( close == std::string::npos ) break;
+            size_t const space = control.find( ' ', open );
+            if ( space != std::string::npos && space < close )
+            {
+                std::string const name = control.substr( open + 1, space - open - 1 );
+                float const value = std::strtof( control.c_str() + space + 1, nullptr );
+                if ( name == "accel" ) accel = value;
+                else if ( name == "brake" ) brake = value;
+                else if ( name == "clutch" ) clutch = value;
+                else if ( name == "steer" ) steer = value;
+                else if ( name == "gear" ) gear = static_cast<int>( value );
+                else if ( name == "focus" ) this->focus = static_cast<int>( value );
+                else if ( name == "meta" ) this->restart = value != 0.0f;
+            }
+            open = control.find( '(', close );
+        }
+        // physics
+        float const time = TICK / static_cast<float>( SUBSTEPS );
+        for ( size_t substep = 0; substep < SUBSTEPS; substep++ )
+        {
+            bool const on_track = std::fabs( this->lateral ) <= 0.5f * this->track.getWidth();
+            this->vehicle.step( accel, brake, clutch, steer, gear, on_track ? TRACK_GRIP : GRASS_GRIP, on_track ? 0.0f : GRASS_RESISTANCE, time );
+            updatePosition( time );
+        }
+        this->ticks++;
+    }
+
+    /// <summary>
+    /// Builds the SCR sensors string of the current state.
+    /// </summary>
+    /// <returns>Sensors string.</returns>
+    std::string const Race::sensors() const
+    {
+        // SCR client buffer is 1000 bytes, values are kept short
+        char buffer[ 1000 ];
+        int length = 0;
+        auto append = [ & ]( char const * format, auto const value )
+        {
+            int const written = std::snprintf( buffer + length, sizeof( buffer ) - static_cast<size_t>( length ), format, value );
+            length = std::min( length + std::max( written, 0 ), static_cast<int>( sizeof( buffer ) ) - 1 );
+        };
+        float const half_width = 0.5f * this->track.getWidth();
+        bool const on_track = std::fabs( this->lateral ) <= half_width;
+        append( "(angle %.5g)", std::remainder( this->track_heading - this->vehicle.getHeading(), 2.0f * static_cast<float>( M_PI ) ) );
+        append( "(curLapTime %.5g)", this->lap_time );
+        append( "(damage %.5g)", this->damage );
+        append( "(distFromStart %.6g)", this->distance_from_start );
+        append( "(distRaced %.6g)", this->distance_raced );
+        // focus only within the front half and on track
+        append( "%s", "(focus" );
+        for ( int sensor = 0; sensor < static_cast<int>( FOCUS_SENSORS ); sensor++ )
+        {
+            bool const valid = on_track && this->focus >= -90 && this->focus <= 90;
+            append( " %.4g", valid ? rangeFinder( static_cast<float>( this->focus + sensor - 2 ) ) : -1.0f );
+        }
+        append( "%s", ")" );
+        append( "(fuel %.5g)", this->vehicle.getFuel() );
+        append( "(gear %d)", this->vehicle.getGear() );
+        append( "(lastLapTime %.5g)", this->last_lap_time );
+        // single car, no opponent in range
+        append( "%s", "(opponents" );
+        for ( size_t sensor = 0; sensor < OPPONENT_SENSORS; sensor++ ) append( " %d", 200 );
+        append( "%s", ")" );
+        append( "(racePos %d)", 1 );
+        append( "(rpm %.5g)", this->vehicle.getRpm() );
+        append( "(speedX %.5g)", this->vehicle.getSpeedX() * 3.6f );
+        append( "(speedY %.5g)", this->vehicle.getSpeedY() * 3.6f );
+        append( "(speedZ %.5g)", 0.0f );
+        append( "%s", "(track" );
+        for ( float const & angle : this->angles ) append( " %.4g", on_track ? rangeFinder( angle ) : -1.0f );
+        append( "%s", ")" );
+        append( "(trackPos %.5g)", this->lateral / half_width );
+        append( "%s", "(wheelSpinVel" );
+        for ( size_t wheel = 0; wheel < 4; wheel++ ) append( " %.5g", this->vehicle.getWheelSpin( wheel ) );
+        append( "%s", ")" );
+        append( "(z %.4g)", CAR_Z );
+        return std::string( buffer, static_cast<size_t>( length ) );
+    }
+
+    /// <summary>
+    /// Checks if the driver asked for a restart in the last control.
+    /// </summary>
+    /// <returns>Whenever a restart was requested.</returns>
+    bool const Race::restartRequested() const { return this->restart; }
+
+    /// <summary>
+    /// Retrieves completed laps.
+    /// </summary>
+    /// <returns>Completed laps.</returns>
+    size_t const Race::getLaps() const { return this->laps; }
+
+    /// <summary>
+    /// Retrieves game ticks since the start.
+    /// </summary>
+    /// <returns>Game ticks.</returns>
+    size_t const Race::getTicks() const { return this->ticks; }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Race utilities.                                                       *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Updates the car position in the track, its lap times and wall collisions.
+    /// </summary>
+    /// <param name="time">Elapsed time, in [s].</param>
+    void Race::updatePosition( float const & time )
+    {
+        float const length = this->track.getLength();
+        float const previous = this->distance_from_start;
+        this->track.project( this->vehicle.getX(), this->vehicle.getY(), this->hint, this->distance_from_start, this->lateral, this->track_heading );
+        // walls behind the runoff
+        float const wall = 0.5f * this->track.getWidth() + RUNOFF;
+        if ( std::fabs( this->lateral ) > wall )
+        {
+            float const side = this->lateral > 0.0f ? 1.0f : -1.0f;
+            float const impact = this->vehicle.collide( -side * std::sin( this->track_heading ), side * std::cos( this->track_heading ), std::fabs( this->lateral ) - wall );
+            this->damage += impact * DAMAGE_RATE;
+            this->track.project( this->vehicle.getX(), this->vehicle.getY(), this->hint, this->distance_from_start, this->lateral, this->track_heading );
+        }
+        // raced distance, wrapping around the start line
+        float advance = this->distance_from_start - previous;
+        if ( advance > 0.5f * length ) advance -= length;
+        if ( advance < -0.5f * length ) advance += length;
+        this->distance_raced += advance;
+        this->lap_time += time;
+        // lap completed when crossing the start line forward after racing it
+        if ( previous - this->distance_from_start > 0.5f * length && this->distance_raced > ( static_cast<float>( this->laps ) + 0.5f ) * length )
+        {
+            this->last_lap_time = this->lap_time;
+            this->lap_time = 0.0f;
+            this->laps++;
+        }
+    }
+
+    /// <summary>
+    /// Measures a range finder from the car.
+    /// </summary>
+    /// <param name="angle">Range finder angle, clockwise from the car axis, in [deg].</param>
+    /// <returns>Distance to the track edge, in [m].</returns>
+    float const Race::rangeFinder( float const & angle ) const
+    {
+        float const direction = this->vehicle.getHeading() - angle * static_cast<float>( M_PI ) / 180.0f;
+        return this->track.range( this->vehicle.getX(), this->vehicle.getY(), direction, this->hint );
+    }
+}
+
+#endif
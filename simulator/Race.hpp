@@ -0,0 +1,207 @@
+/***************************************************************************
+
+    file                 : Race.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef SIMULATOR_RACE
+#define SIMULATOR_RACE
+
+#include <array>
+#include <string>
+#include "Track.hpp"
+#include "Vehicle.hpp"
+
+namespace Simulator
+{
+    /// <summary>
+    /// Single car race, produces the SCR sensors string and applies the SCR control string every game tick.
+    /// </summary>
+    class Race
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Race local constants and variables.                                   *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Game tick between controls, as in the SCR server, in [s].
+        /// </summary>
+        constexpr static float const TICK = 0.02f;
+        /// <summary>
+        /// Physics steps every game tick, as in TORCS.
+        /// </summary>
+        constexpr static size_t const SUBSTEPS = 10;
+        /// <summary>
+        /// Number of track range finders.
+        /// </summary>
+        constexpr static size_t const TRACK_SENSORS = 19;
+        /// <summary>
+        /// Number of focus range finders.
+        /// </summary>
+        constexpr static size_t const FOCUS_SENSORS = 5;
+        /// <summary>
+        /// Number of opponent sectors.
+        /// </summary>
+        constexpr static size_t const OPPONENT_SENSORS = 36;
+        /// <summary>
+        /// Asphalt friction coefficient.
+        /// </summary>
+        constexpr static float const TRACK_GRIP = 1.1f;
+        /// <summary>
+        /// Grass friction coefficient.
+        /// </summary>
+        constexpr static float const GRASS_GRIP = 0.6f;
+        /// <summary>
+        /// Grass extra rolling resistance coefficient.
+        /// </summary>
+        constexpr static float const GRASS_RESISTANCE = 0.08f;
+        /// <summary>
+        /// Grass between the track edges and the walls, in [m].
+        /// </summary>
+        constexpr static float const RUNOFF = 4.0f;
+        /// <summary>
+        /// Damage points per impact speed, in [1/(m/s)].
+        /// </summary>
+        constexpr static float const DAMAGE_RATE = 20.0f;
+        /// <summary>
+        /// Car height of mass center, in [m].
+        /// </summary>
+        constexpr static float const CAR_Z = 0.345f;
+
+        private:
+        /// <summary>
+        /// Raced track.
+        /// </summary>
+        Track const & track;
+        /// <summary>
+        /// Raced car.
+        /// </summary>
+        Vehicle vehicle;
+        /// <summary>
+        /// Track sample closest to the car.
+        /// </summary>
+        size_t hint;
+        /// <summary>
+        /// Track range finders angles, clockwise from the car axis, in [deg].
+        /// </summary>
+        std::array<float, TRACK_SENSORS> angles;
+        /// <summary>
+        /// Requested focus direction, in [deg].
+        /// </summary>
+        int focus;
+        /// <summary>
+        /// Current lap time, in [s].
+        /// </summary>
+        float lap_time;
+        /// <summary>
+        /// Previous lap time, in [s].
+        /// </summary>
+        float last_lap_time;
+        /// <summary>
+        /// Distance raced along the track since the start, in [m].
+        /// </summary>
+        float distance_raced;
+        /// <summary>
+        /// Car distance from the start line, in [m].
+        /// </summary>
+        float distance_from_start;
+        /// <summary>
+        /// Car distance to the track center line, positive to the left, in [m].
+        /// </summary>
+        float lateral;
+        /// <summary>
+        /// Track direction at the car, in [rad].
+        /// </summary>
+        float track_heading;
+        /// <summary>
+        /// Accumulated damage points.
+        /// </summary>
+        float damage;
+        /// <summary>
+        /// Completed laps.
+        /// </summary>
+        size_t laps;
+        /// <summary>
+        /// Game ticks since the start.
+        /// </summary>
+        size_t ticks;
+        /// <summary>
+        /// Whenever the driver asked for a restart.
+        /// </summary>
+        bool restart;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Race interface.                                                       *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates a race in the given track.
+        /// </summary>
+        /// <param name="track">Track to race, must outlive the race.</param>
+        Race( Track const & track );
+
+        /// <summary>
+        /// Places the car at the start line and resets all counters.
+        /// </summary>
+        /// <param name="angles">Track range finders angles, in [deg].</param>
+        void reset( std::array<float, TRACK_SENSORS> const & angles );
+
+        /// <summary>
+        /// Applies a SCR control string and advances one game tick.
+        /// </summary>
+        /// <param name="control">Control string, as "(accel 1)(brake 0)(gear 1)(steer 0)(clutch 0)(focus 0)(meta 0)".</param>
+        void drive( std::string const & control );
+
+        /// <summary>
+        /// Builds the SCR sensors string of the current state.
+        /// </summary>
+        /// <returns>Sensors string.</returns>
+        std::string const sensors() const;
+
+        /// <summary>
+        /// Checks if the driver asked for a restart in the last control.
+        /// </summary>
+        /// <returns>Whenever a restart was requested.</returns>
+        bool const restartRequested() const;
+
+        /// <summary>
+        /// Retrieves completed laps.
+        /// </summary>
+        /// <returns>Completed laps.</returns>
+        size_t const getLaps() const;
+
+        /// <summary>
+        /// Retrieves game ticks since the start.
+        /// </summary>
+        /// <returns>Game ticks.</returns>
+        size_t const getTicks() const;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Race utilities.                                                       *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Updates the car position in the track, its lap times and wall collisions.
+        /// </summary>
+        /// <param name="time">Elapsed time, in [s].</param>
+        void updatePosition( float const & time );
+
+        /// <summary>
+        /// Measures a range finder from the car.
+        /// </summary>
+        /// <param name="angle">Range finder angle, clockwise from the car axis, in [deg].</param>
+        /// <returns>Distance to the track edge, in [m].</returns>
+        float const rangeFinder( float const & angle ) const;
+    };
+}
+
+#endif
@@ -0,0 +1,269 @@
+/***************************************************************************
+
+    file                 : Track.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Track.hpp"
+
+#if defined (SIMULATOR_TRACK)
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace Simulator
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Track interface.                                                      *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Builds the default track, or the one described in file if given.
+    /// </summary>
+    /// <remarks>
+    /// File lines are "width meters", "straight meters" or "curve degrees radius", positive degrees turn left.
+    /// </remarks>
+    /// <param name="file_name">Track description file, empty for the default track.</param>
+    Track::Track( std::string const & file_name ) : samples( {} ), width( 12.0f ), length( 0.0f )
+    {
+        float const degree = static_cast<float>( M_PI ) / 180.0f;
+        // start line
+        this->samples.push_back( Sample( 0.0f, 0.0f, 0.0f, 0.0f ) );
+        if ( file_name.empty() )
+        {
+            // clockwise rectangle with different corners and a chicane in the main straight
+            addStraight( 150.0f );
+            addCurve( 20.0f * degree, 100.0f );
+            addCurve( -40.0f * degree, 100.0f );
+            addCurve( 20.0f * degree, 100.0f );
+            addStraight( 500.0f - 150.0f - 400.0f * std::sin( 20.0f * degree ) );
+            addCurve( -90.0f * degree, 60.0f );
+            addStraight( 250.0f );
+            addCurve( -90.0f * degree, 120.0f );
+            addStraight( 490.0f );
+            addCurve( -90.0f * degree, 40.0f );
+            addStraight( 300.0f );
+            addCurve( -90.0f * degree, 90.0f );
+        }
+        else
+        {
+            std::ifstream myfile( file_name );
+            if ( !myfile.is_open() ) std::cout << "Track file " << file_name << " not found" << std::endl;
+            std::string segment;
+            while ( myfile >> segment )
+            {
+                float value = 0.0f;
+                float radius = 0.0f;
+                if ( segment == "width" && myfile >> value ) this->width = value;
+                else if ( segment == "straight" && myfile >> value ) addStraight( value );
+                else if ( segment == "curve" && myfile >> value >> radius ) addCurve( value * degree, radius );
+                else std::cout << "Unknown track segment " << segment << std::endl;
+            }
+            myfile.close();
+        }
+        // last sample closes the loop at the start line
+        Sample const & last = this->samples.back();
+        Sample const & first = this->samples.front();
+        if ( std::hypot( last.x - first.x, last.y - first.y ) > SAMPLE_STEP )
+        {
+            std::cout << "Track isn't closed, gap of " << std::hypot( last.x - first.x, last.y - first.y ) << " m" << std::endl;
+        }
+        this->length = last.distance;
+        if ( this->samples.size() > 1 ) this->samples.pop_back();
+    }
+
+    /// <summary>
+    /// Retrieves track width.
+    /// </summary>
+    /// <returns>Width, in [m].</returns>
+    float const Track::getWidth() const { return this->width; }
+
+    /// <summary>
+    /// Retrieves track length.
+    /// </summary>
+    /// <returns>Length, in [m].</returns>
+    float const Track::getLength() const { return this->length; }
+
+    /// <summary>
+    /// Retrieves the start position and direction.
+    /// </summary>
+    /// <param name="x">Start x, in [m].</param>
+    /// <param name="y">Start y, in [m].</param>
+    /// <param name="heading">Start direction, in [rad].</param>
+    void Track::start( float & x, float & y, float & heading ) const
+    {
+        x = this->samples.front().x;
+        y = this->samples.front().y;
+        heading = this->samples.front().heading;
+    }
+
+    /// <summary>
+    /// Finds the sample closest to a position, walking the center line from a hint.
+    /// </summary>
+    /// <param name="x">Position x, in [m].</param>
+    /// <param name="y">Position y, in [m].</param>
+    /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+    void Track::locate( float const & x, float const & y, size_t & hint ) const
+    {
+        size_t const total = this->samples.size();
+        auto squared_distance = [ & ]( size_t const & index )
+        {
+            Sample const & sample = this->samples[ index ];
+            return ( sample.x - x ) * ( sample.x - x ) + ( sample.y - y ) * ( sample.y - y );
+        };
+        hint %= total;
+        float best = squared_distance( hint );
+        // walk while a neighbour is closer
+        while ( true )
+        {
+            size_t const next = ( hint + 1 ) % total;
+            size_t const previous = ( hint + total - 1 ) % total;
+            float const next_distance = squared_distance( next );
+            float const previous_distance = squared_distance( previous );
+            if ( next_distance < best && next_distance <= previous_distance )
+            {
+                hint = next;
+                best = next_distance;
+            }
+            else if ( previous_distance < best )
+            {
+                hint = previous;
+                best = previous_distance;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Projects a position on the center line.
+    /// </summary>
+    /// <param name="x">Position x, in [m].</param>
+    /// <param name="y">Position y, in [m].</param>
+    /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+    /// <param name="distance">Distance from start line, in [m].</param>
+    /// <param name="lateral">Distance to the center line, positive to the left, in [m].</param>
+    /// <param name="heading">Track direction, in [rad].</param>
+    void Track::project( float const & x, float const & y, size_t & hint, float & distance, float & lateral, float & heading ) const
+    {
+        locate( x, y, hint );
+        Sample const & sample = this->samples[ hint ];
+        float const dx = x - sample.x;
+        float const dy = y - sample.y;
+        float const cosine = std::cos( sample.heading );
+        float const sine = std::sin( sample.heading );
+        distance = std::fmod( sample.distance + dx * cosine + dy * sine + this->length, this->length );
+        lateral = dy * cosine - dx * sine;
+        heading = sample.heading;
+    }
+
+    /// <summary>
+    /// Measures the distance to the track edge along a ray starting inside the track.
+    /// </summary>
+    /// <param name="x">Ray origin x, in [m].</param>
+    /// <param name="y">Ray origin y, in [m].</param>
+    /// <param name="direction">Ray direction, in [rad].</param>
+    /// <param name="hint">Sample close to the ray origin.</param>
+    /// <returns>Edge distance, up to Track::RANGE_MAX, in [m].</returns>
+    float const Track::range( float const & x, float const & y, float const & direction, size_t const & hint ) const
+    {
+        // march till outside, then bisect the crossing
+        float const step = 2.0f * SAMPLE_STEP;
+        float const cosine = std::cos( direction );
+        float const sine = std::sin( direction );
+        size_t inner_hint = hint;
+        float inner = 0.0f;
+        float outer = 0.0f;
+        while ( true )
+        {
+            outer = std::min( inner + step, RANGE_MAX );
+            size_t outer_hint = inner_hint;
+            if ( !inside( x + cosine * outer, y + sine * outer, outer_hint ) ) break;
+            inner = outer;
+            inner_hint = outer_hint;
+            if ( inner >= RANGE_MAX ) return RANGE_MAX;
+        }
+        for ( size_t iteration = 0; iteration < 6; iteration++ )
+        {
+            float const middle = 0.5f * ( inner + outer );
+            size_t middle_hint = inner_hint;
+            if ( inside( x + cosine * middle, y + sine * middle, middle_hint ) ) inner = middle;
+            else outer = middle;
+        }
+        return 0.5f * ( inner + outer );
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Track utilities.                                                      *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Appends a straight to the center line.
+    /// </summary>
+    /// <param name="length">Straight length, in [m].</param>
+    void Track::addStraight( float const & length )
+    {
+        size_t const steps = static_cast<size_t>( std::ceil( length / SAMPLE_STEP ) );
+        float const step = length / static_cast<float>( steps );
+        for ( size_t index = 0; index < steps; index++ )
+        {
+            Sample const last = this->samples.back();
+            this->samples.push_back( Sample( last.x + step * std::cos( last.heading ), last.y + step * std::sin( last.heading ), last.heading, last.distance + step ) );
+        }
+    }
+
+    /// <summary>
+    /// Appends a constant radius curve to the center line.
+    /// </summary>
+    /// <param name="angle">Curve angle, positive to the left, in [rad].</param>
+    /// <param name="radius">Curve radius, in [m].</param>
+    void Track::addCurve( float const & angle, float const & radius )
+    {
+        float const length = std::fabs( angle ) * radius;
+        size_t const steps = static_cast<size_t>( std::ceil( length / SAMPLE_STEP ) );
+        float const turn = angle / static_cast<float>( steps );
+        // chord of every step
+        float const chord = 2.0f * radius * std::sin( 0.5f * std::fabs( turn ) );
+        for ( size_t index = 0; index < steps; index++ )
+        {
+            Sample const last = this->samples.back();
+            float const direction = last.heading + 0.5f * turn;
+            this->samples.push_back( Sample( last.x + chord * std::cos( direction ), last.y + chord * std::sin( direction ), last.heading + turn, last.distance + length / static_cast<float>( steps ) ) );
+        }
+    }
+
+    /// <summary>
+    /// Checks if a position is inside the track.
+    /// </summary>
+    /// <param name="x">Position x, in [m].</param>
+    /// <param name="y">Position y, in [m].</param>
+    /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+    /// <returns>Whenever position is inside.</returns>
+    bool const Track::inside( float const & x, float const & y, size_t & hint ) const
+    {
+        locate( x, y, hint );
+        Sample const & sample = this->samples[ hint ];
+        float const lateral = ( y - sample.y ) * std::cos( sample.heading ) - ( x - sample.x ) * std::sin( sample.heading );
+        return std::fabs( lateral ) <= 0.5f * this->width;
+    }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Sample class.                                                         *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates a sample.
+    /// </summary>
+    Track::Sample::Sample( float const & x, float const & y, float const & heading, float const & distance )
+        : x( x ), y( y ), heading( heading ), distance( distance ) {}
+}
+
+#endif
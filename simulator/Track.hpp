@@ -0,0 +1,183 @@
+/***************************************************************************
+
+    file                 : Track.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef SIMULATOR_TRACK
+#define SIMULATOR_TRACK
+
+#include <string>
+#include <vector>
+
+namespace Simulator
+{
+    /// <summary>
+    /// Closed flat track, made of straights and constant radius curves, with constant width.
+    /// </summary>
+    /// <remarks>
+    /// The center line is sampled every Track::SAMPLE_STEP meters, positions are located by walking the samples from a nearby hint.
+    /// </remarks>
+    class Track
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Sample class.                                                         *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Center line point.
+        /// </summary>
+        class Sample
+        {
+            // Friendship declarations
+            friend class Track;
+
+            /// <summary>
+            /// Position, in [m].
+            /// </summary>
+            float x, y;
+            /// <summary>
+            /// Track direction, counter clockwise from x axis, in [rad].
+            /// </summary>
+            float heading;
+            /// <summary>
+            /// Distance from start line, in [m].
+            /// </summary>
+            float distance;
+
+            public:
+            /// <summary>
+            /// Generates a sample.
+            /// </summary>
+            Sample( float const & x, float const & y, float const & heading, float const & distance );
+        };
+
+        /***************************************************************************
+         *                                                                         *
+         *   Track local constants and variables.                                  *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Center line sampling distance, in [m].
+        /// </summary>
+        constexpr static float const SAMPLE_STEP = 1.0f;
+        /// <summary>
+        /// Range finders maximum distance, in [m].
+        /// </summary>
+        constexpr static float const RANGE_MAX = 200.0f;
+
+        private:
+        /// <summary>
+        /// Center line samples.
+        /// </summary>
+        std::vector<Sample> samples;
+        /// <summary>
+        /// Track width, in [m].
+        /// </summary>
+        float width;
+        /// <summary>
+        /// Track length, in [m].
+        /// </summary>
+        float length;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Track interface.                                                      *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Builds the default track, or the one described in file if given.
+        /// </summary>
+        /// <remarks>
+        /// File lines are "width meters", "straight meters" or "curve degrees radius", positive degrees turn left.
+        /// </remarks>
+        /// <param name="file_name">Track description file, empty for the default track.</param>
+        Track( std::string const & file_name = "" );
+
+        /// <summary>
+        /// Retrieves track width.
+        /// </summary>
+        /// <returns>Width, in [m].</returns>
+        float const getWidth() const;
+
+        /// <summary>
+        /// Retrieves track length.
+        /// </summary>
+        /// <returns>Length, in [m].</returns>
+        float const getLength() const;
+
+        /// <summary>
+        /// Retrieves the start position and direction.
+        /// </summary>
+        /// <param name="x">Start x, in [m].</param>
+        /// <param name="y">Start y, in [m].</param>
+        /// <param name="heading">Start direction, in [rad].</param>
+        void start( float & x, float & y, float & heading ) const;
+
+        /// <summary>
+        /// Finds the sample closest to a position, walking the center line from a hint.
+        /// </summary>
+        /// <param name="x">Position x, in [m].</param>
+        /// <param name="y">Position y, in [m].</param>
+        /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+        void locate( float const & x, float const & y, size_t & hint ) const;
+
+        /// <summary>
+        /// Projects a position on the center line.
+        /// </summary>
+        /// <param name="x">Position x, in [m].</param>
+        /// <param name="y">Position y, in [m].</param>
+        /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+        /// <param name="distance">Distance from start line, in [m].</param>
+        /// <param name="lateral">Distance to the center line, positive to the left, in [m].</param>
+        /// <param name="heading">Track direction, in [rad].</param>
+        void project( float const & x, float const & y, size_t & hint, float & distance, float & lateral, float & heading ) const;
+
+        /// <summary>
+        /// Measures the distance to the track edge along a ray starting inside the track.
+        /// </summary>
+        /// <param name="x">Ray origin x, in [m].</param>
+        /// <param name="y">Ray origin y, in [m].</param>
+        /// <param name="direction">Ray direction, in [rad].</param>
+        /// <param name="hint">Sample close to the ray origin.</param>
+        /// <returns>Edge distance, up to Track::RANGE_MAX, in [m].</returns>
+        float const range( float const & x, float const & y, float const & direction, size_t const & hint ) const;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Track utilities.                                                      *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Appends a straight to the center line.
+        /// </summary>
+        /// <param name="length">Straight length, in [m].</param>
+        void addStraight( float const & length );
+
+        /// <summary>
+        /// Appends a constant radius curve to the center line.
+        /// </summary>
+        /// <param name="angle">Curve angle, positive to the left, in [rad].</param>
+        /// <param name="radius">Curve radius, in [m].</param>
+        void addCurve( float const & angle, float const & radius );
+
+        /// <summary>
+        /// Checks if a position is inside the track.
+        /// </summary>
+        /// <param name="x">Position x, in [m].</param>
+        /// <param name="y">Position y, in [m].</param>
+        /// <param name="hint">Sample close to the position, updated with the closest one.</param>
+        /// <returns>Whenever position is inside.</returns>
+        bool const inside( float const & x, float const & y, size_t & hint ) const;
+    };
+}
+
+#endif
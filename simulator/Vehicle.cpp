@@ -0,0 +1,217 @@
+/***************************************************************************
+
+    file                 : Vehicle.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include "Vehicle.hpp"
+
+#if defined (SIMULATOR_VEHICLE)
+
+#include <algorithm>
+#include <cmath>
+
+namespace Simulator
+{
+    /***************************************************************************
+     *                                                                         *
+     *   Vehicle interface.                                                    *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Generates a stopped car at the origin.
+    /// </summary>
+    Vehicle::Vehicle() : x( 0.0f ), y( 0.0f ), heading( 0.0f ), speed_x( 0.0f ), speed_y( 0.0f ), rpm( RPM_IDLE ), gear( 0 ), fuel( FUEL_INITIAL ), wheel_spin( {} ) {}
+
+    /// <summary>
+    /// Places a stopped car, in neutral and with full tank.
+    /// </summary>
+    /// <param name="x">Position x, in [m].</param>
+    /// <param name="y">Position y, in [m].</param>
+    /// <param name="heading">Car direction, in [rad].</param>
+    void Vehicle::reset( float const & x, float const & y, float const & heading )
+    {
+        *this = Vehicle();
+        this->x = x;
+        this->y = y;
+        this->heading = heading;
+    }
+
+    /// <summary>
+    /// Advances the car state.
+    /// </summary>
+    /// <param name="accel">Throttle [0, 1].</param>
+    /// <param name="brake">Brake [0, 1].</param>
+    /// <param name="clutch">Clutch [0, 1], 1 fully disengaged.</param>
+    /// <param name="steer">Steer [-1, 1], positive to the left.</param>
+    /// <param name="gear">Gear { -1, ..., 6 }.</param>
+    /// <param name="grip">Surface friction coefficient.</param>
+    /// <param name="resistance">Surface extra rolling resistance coefficient.</param>
+    /// <param name="time">Time step, in [s].</param>
+    void Vehicle::step( float accel, float brake, float clutch, float steer, int gear, float const & grip, float const & resistance, float const & time )
+    {
+        accel = std::min( std::max( accel, 0.0f ), 1.0f );
+        brake = std::min( std::max( brake, 0.0f ), 1.0f );
+        clutch = std::min( std::max( clutch, 0.0f ), 1.0f );
+        steer = std::min( std::max( steer, -1.0f ), 1.0f );
+        this->gear = std::min( std::max( gear, -1 ), 6 );
+        if ( this->fuel <= 0.0f ) accel = 0.0f;
+        float const ratio = GEAR_RATIOS[ static_cast<size_t>( this->gear + 1 ) ] * FINAL_DRIVE;
+
+        // engine speed, coupled to the wheels unless in neutral or with clutch pressed
+        float const free_rpm = RPM_IDLE + accel * ( RPM_LIMIT - RPM_IDLE );
+        float const coupled_rpm = std::fabs( this->speed_x / WHEEL_RADIUS * ratio ) * 60.0f / ( 2.0f * static_cast<float>( M_PI ) );
+        this->rpm = this->gear == 0 ? free_rpm : std::max( RPM_IDLE, ( 1.0f - clutch ) * coupled_rpm + clutch * free_rpm );
+        float const engine_torque = this->rpm < RPM_LIMIT ? accel * torque( this->rpm ) : 0.0f;
+
+        // longitudinal forces, traction limited by the driven wheels grip
+        float drive_force = engine_torque * ratio / WHEEL_RADIUS * ( 1.0f - clutch );
+        float const traction = grip * MASS * GRAVITY * DRIVE_SHARE;
+        float slip = 0.0f;
+        if ( std::fabs( drive_force ) > traction )
+        {
+            slip = std::min( ( std::fabs( drive_force ) - traction ) / traction, 1.0f );
+            drive_force = std::copysign( traction, drive_force );
+        }
+        float const brake_force = std::min( brake * BRAKE_FORCE, grip * MASS * GRAVITY );
+        float const rolling_force = ( ROLLING + resistance ) * MASS * GRAVITY;
+        float net_force = 0.0f;
+        // stopped, brakes and rolling resistance hold the car till overcome
+        if ( this->speed_x == 0.0f )
+        {
+            net_force = std::copysign( std::max( 0.0f, std::fabs( drive_force ) - brake_force - rolling_force ), drive_force );
+        }
+        else
+        {
+            float const direction = this->speed_x < 0.0f ? -1.0f : 1.0f;
+            net_force = drive_force - ( brake_force + rolling_force ) * direction - DRAG * this->speed_x * std::fabs( this->speed_x );
+        }
+        float speed_x = this->speed_x + net_force / MASS * time;
+        // stops before changing direction
+        if ( speed_x * this->speed_x < 0.0f ) speed_x = 0.0f;
+        this->speed_x = speed_x;
+
+        // yaw rate limited by lateral grip, the excess slides the car outwards
+        float const desired_yaw = this->speed_x * std::tan( steer * STEER_LOCK ) / WHEELBASE;
+        float const limit_yaw = grip * GRAVITY / std::max( std::fabs( this->speed_x ), 1.0f );
+        float const yaw = std::min( std::max( desired_yaw, -limit_yaw ), limit_yaw );
+        this->speed_y -= 0.5f * ( desired_yaw - yaw ) * std::fabs( this->speed_x ) * time;
+        this->speed_y *= std::exp( -SLIDE_DAMPING * grip * time );
+        this->heading += yaw * time;
+        this->heading = std::remainder( this->heading, 2.0f * static_cast<float>( M_PI ) );
+
+        // move in world frame
+        float const cosine = std::cos( this->heading );
+        float const sine = std::sin( this->heading );
+        this->x += ( this->speed_x * cosine - this->speed_y * sine ) * time;
+        this->y += ( this->speed_x * sine + this->speed_y * cosine ) * time;
+
+        // rear wheels spin over the ground speed when traction is exceeded
+        float const ground_spin = this->speed_x / WHEEL_RADIUS;
+        this->wheel_spin = { ground_spin, ground_spin, ground_spin * ( 1.0f + slip ), ground_spin * ( 1.0f + slip ) };
+        if ( this->speed_x == 0.0f && slip > 0.0f ) this->wheel_spin[ 2 ] = this->wheel_spin[ 3 ] = std::copysign( slip * 20.0f, ratio );
+
+        this->fuel = std::max( 0.0f, this->fuel - accel * this->rpm / RPM_LIMIT * FUEL_RATE * time );
+    }
+
+    /// <summary>
+    /// Stops the car against a wall, removing the velocity into it.
+    /// </summary>
+    /// <param name="normal_x">Wall outward normal x.</param>
+    /// <param name="normal_y">Wall outward normal y.</param>
+    /// <param name="depth">Distance the car went through the wall, in [m].</param>
+    /// <returns>Impact speed, in [m/s].</returns>
+    float const Vehicle::collide( float const & normal_x, float const & normal_y, float const & depth )
+    {
+        // back inside
+        this->x -= normal_x * depth;
+        this->y -= normal_y * depth;
+        // world velocity
+        float const cosine = std::cos( this->heading );
+        float const sine = std::sin( this->heading );
+        float velocity_x = this->speed_x * cosine - this->speed_y * sine;
+        float velocity_y = this->speed_x * sine + this->speed_y * cosine;
+        float const impact = std::max( 0.0f, velocity_x * normal_x + velocity_y * normal_y );
+        // remove velocity into the wall and scrub the rest
+        velocity_x = 0.8f * ( velocity_x - impact * normal_x );
+        velocity_y = 0.8f * ( velocity_y - impact * normal_y );
+        this->speed_x = velocity_x * cosine + velocity_y * sine;
+        this->speed_y = velocity_y * cosine - velocity_x * sine;
+        return impact;
+    }
+
+    /// <summary>
+    /// Retrieves car position x.
+    /// </summary>
+    /// <returns>Position x, in [m].</returns>
+    float const Vehicle::getX() const { return this->x; }
+
+    /// <summary>
+    /// Retrieves car position y.
+    /// </summary>
+    /// <returns>Position y, in [m].</returns>
+    float const Vehicle::getY() const { return this->y; }
+
+    /// <summary>
+    /// Retrieves car direction.
+    /// </summary>
+    /// <returns>Direction, in [rad].</returns>
+    float const Vehicle::getHeading() const { return this->heading; }
+
+    /// <summary>
+    /// Retrieves car velocity along itself.
+    /// </summary>
+    /// <returns>Forward velocity, in [m/s].</returns>
+    float const Vehicle::getSpeedX() const { return this->speed_x; }
+
+    /// <summary>
+    /// Retrieves car velocity across itself.
+    /// </summary>
+    /// <returns>Leftward velocity, in [m/s].</returns>
+    float const Vehicle::getSpeedY() const { return this->speed_y; }
+
+    /// <summary>
+    /// Retrieves engine speed.
+    /// </summary>
+    /// <returns>Engine speed, in [rpm].</returns>
+    float const Vehicle::getRpm() const { return this->rpm; }
+
+    /// <summary>
+    /// Retrieves engaged gear.
+    /// </summary>
+    /// <returns>Gear { -1, ..., 6 }.</returns>
+    int const Vehicle::getGear() const { return this->gear; }
+
+    /// <summary>
+    /// Retrieves remaining fuel.
+    /// </summary>
+    /// <returns>Fuel, in [l].</returns>
+    float const Vehicle::getFuel() const { return this->fuel; }
+
+    /// <summary>
+    /// Retrieves a wheel angular velocity.
+    /// </summary>
+    /// <param name="wheel">Wheel index, front left, front right, rear left, rear right.</param>
+    /// <returns>Angular velocity, in [rad/s].</returns>
+    float const Vehicle::getWheelSpin( size_t const & wheel ) const { return this->wheel_spin[ wheel ]; }
+
+    /***************************************************************************
+     *                                                                         *
+     *   Vehicle utilities.                                                    *
+     *                                                                         *
+     ***************************************************************************/
+    /// <summary>
+    /// Engine torque at full throttle.
+    /// </summary>
+    /// <param name="rpm">Engine speed, in [rpm].</param>
+    /// <returns>Torque, in [N.m].</returns>
+    float const Vehicle::torque( float const & rpm )
+    {
+        // parabola around the maximum torque speed, never below 30 %
+        float const offset = ( rpm - TORQUE_RPM ) / TORQUE_RPM;
+        return TORQUE_MAX * std::max( 0.3f, 1.0f - offset * offset );
+    }
+}
+
+#endif
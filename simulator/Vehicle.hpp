@@ -0,0 +1,243 @@
+/***************************************************************************
+
+    file                 : Vehicle.hpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#pragma once
+
+#ifndef SIMULATOR_VEHICLE
+#define SIMULATOR_VEHICLE
+
+#include <array>
+#include <cstddef>
+
+namespace Simulator
+{
+    /// <summary>
+    /// Simplified rear wheel drive car, a kinematic bicycle with a grip limited yaw rate, engine, gearbox, clutch and brakes.
+    /// </summary>
+    class Vehicle
+    {
+        /***************************************************************************
+         *                                                                         *
+         *   Vehicle local constants and variables.                                *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Gravity acceleration, in [m/s^2].
+        /// </summary>
+        constexpr static float const GRAVITY = 9.81f;
+        /// <summary>
+        /// Car mass, in [kg].
+        /// </summary>
+        constexpr static float const MASS = 1000.0f;
+        /// <summary>
+        /// Distance between axles, in [m].
+        /// </summary>
+        constexpr static float const WHEELBASE = 2.6f;
+        /// <summary>
+        /// Maximum front wheels angle, as in TORCS steer lock, in [rad].
+        /// </summary>
+        constexpr static float const STEER_LOCK = 0.366f;
+        /// <summary>
+        /// Wheel radius, in [m].
+        /// </summary>
+        constexpr static float const WHEEL_RADIUS = 0.33f;
+        /// <summary>
+        /// Share of the weight on the driven wheels.
+        /// </summary>
+        constexpr static float const DRIVE_SHARE = 0.5f;
+        /// <summary>
+        /// Maximum engine torque, in [N.m].
+        /// </summary>
+        constexpr static float const TORQUE_MAX = 300.0f;
+        /// <summary>
+        /// Engine speed of maximum torque, in [rpm].
+        /// </summary>
+        constexpr static float const TORQUE_RPM = 5500.0f;
+        /// <summary>
+        /// Engine idle speed, in [rpm].
+        /// </summary>
+        constexpr static float const RPM_IDLE = 1000.0f;
+        /// <summary>
+        /// Engine speed limiter, in [rpm].
+        /// </summary>
+        constexpr static float const RPM_LIMIT = 9000.0f;
+        /// <summary>
+        /// Final drive ratio.
+        /// </summary>
+        constexpr static float const FINAL_DRIVE = 4.0f;
+        /// <summary>
+        /// Gearbox ratios, reverse first and neutral second.
+        /// </summary>
+        constexpr static std::array<float, 8> const GEAR_RATIOS = { -3.0f, 0.0f, 3.2f, 2.2f, 1.6f, 1.25f, 1.0f, 0.85f };
+        /// <summary>
+        /// Maximum braking force, in [N].
+        /// </summary>
+        constexpr static float const BRAKE_FORCE = 12000.0f;
+        /// <summary>
+        /// Aerodynamic drag, as 0.5 * air density * drag area, in [kg/m].
+        /// </summary>
+        constexpr static float const DRAG = 0.42f;
+        /// <summary>
+        /// Rolling resistance coefficient.
+        /// </summary>
+        constexpr static float const ROLLING = 0.015f;
+        /// <summary>
+        /// Lateral slide damping, per grip unit, in [1/s].
+        /// </summary>
+        constexpr static float const SLIDE_DAMPING = 6.0f;
+        /// <summary>
+        /// Initial fuel, in [l].
+        /// </summary>
+        constexpr static float const FUEL_INITIAL = 94.0f;
+        /// <summary>
+        /// Fuel consumption at full throttle and limiter speed, in [l/s].
+        /// </summary>
+        constexpr static float const FUEL_RATE = 0.01f;
+
+        private:
+        /// <summary>
+        /// Position, in [m].
+        /// </summary>
+        float x, y;
+        /// <summary>
+        /// Car direction, counter clockwise from x axis, in [rad].
+        /// </summary>
+        float heading;
+        /// <summary>
+        /// Velocity along and across the car, positive forward and to the left, in [m/s].
+        /// </summary>
+        float speed_x, speed_y;
+        /// <summary>
+        /// Engine speed, in [rpm].
+        /// </summary>
+        float rpm;
+        /// <summary>
+        /// Engaged gear { -1, ..., 6 }.
+        /// </summary>
+        int gear;
+        /// <summary>
+        /// Remaining fuel, in [l].
+        /// </summary>
+        float fuel;
+        /// <summary>
+        /// Wheels angular velocity, front left, front right, rear left, rear right, in [rad/s].
+        /// </summary>
+        std::array<float, 4> wheel_spin;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Vehicle interface.                                                    *
+         *                                                                         *
+         ***************************************************************************/
+        public:
+        /// <summary>
+        /// Generates a stopped car at the origin.
+        /// </summary>
+        Vehicle();
+
+        /// <summary>
+        /// Places a stopped car, in neutral and with full tank.
+        /// </summary>
+        /// <param name="x">Position x, in [m].</param>
+        /// <param name="y">Position y, in [m].</param>
+        /// <param name="heading">Car direction, in [rad].</param>
+        void reset( float const & x, float const & y, float const & heading );
+
+        /// <summary>
+        /// Advances the car state.
+        /// </summary>
+        /// <param name="accel">Throttle [0, 1].</param>
+        /// <param name="brake">Brake [0, 1].</param>
+        /// <param name="clutch">Clutch [0, 1], 1 fully disengaged.</param>
+        /// <param name="steer">Steer [-1, 1], positive to the left.</param>
+        /// <param name="gear">Gear { -1, ..., 6 }.</param>
+        /// <param name="grip">Surface friction coefficient.</param>
+        /// <param name="resistance">Surface extra rolling resistance coefficient.</param>
+        /// <param name="time">Time step, in [s].</param>
+        void step( float accel, float brake, float clutch, float steer, int gear, float const & grip, float const & resistance, float const & time );
+
+        /// <summary>
+        /// Stops the car against a wall, removing the velocity into it.
+        /// </summary>
+        /// <param name="normal_x">Wall outward normal x.</param>
+        /// <param name="normal_y">Wall outward normal y.</param>
+        /// <param name="depth">Distance the car went through the wall, in [m].</param>
+        /// <returns>Impact speed, in [m/s].</returns>
+        float const collide( float const & normal_x, float const & normal_y, float const & depth );
+
+        /// <summary>
+        /// Retrieves car position x.
+        /// </summary>
+        /// <returns>Position x, in [m].</returns>
+        float const getX() const;
+
+        /// <summary>
+        /// Retrieves car position y.
+        /// </summary>
+        /// <returns>Position y, in [m].</returns>
+        float const getY() const;
+
+        /// <summary>
+        /// Retrieves car direction.
+        /// </summary>
+        /// <returns>Direction, in [rad].</returns>
+        float const getHeading() const;
+
+        /// <summary>
+        /// Retrieves car velocity along itself.
+        /// </summary>
+        /// <returns>Forward velocity, in [m/s].</returns>
+        float const getSpeedX() const;
+
+        /// <summary>
+        /// Retrieves car velocity across itself.
+        /// </summary>
+        /// <returns>Leftward velocity, in [m/s].</returns>
+        float const getSpeedY() const;
+
+        /// <summary>
+        /// Retrieves engine speed.
+        /// </summary>
+        /// <returns>Engine speed, in [rpm].</returns>
+        float const getRpm() const;
+
+        /// <summary>
+        /// Retrieves engaged gear.
+        /// </summary>
+        /// <returns>Gear { -1, ..., 6 }.</returns>
+        int const getGear() const;
+
+        /// <summary>
+        /// Retrieves remaining fuel.
+        /// </summary>
+        /// <returns>Fuel, in [l].</returns>
+        float const getFuel() const;
+
+        /// <summary>
+        /// Retrieves a wheel angular velocity.
+        /// </summary>
+        /// <param name="wheel">Wheel index, front left, front right, rear left, rear right.</param>
+        /// <returns>Angular velocity, in [rad/s].</returns>
+        float const getWheelSpin( size_t const & wheel ) const;
+
+        /***************************************************************************
+         *                                                                         *
+         *   Vehicle utilities.                                                    *
+         *                                                                         *
+         ***************************************************************************/
+        private:
+        /// <summary>
+        /// Engine torque at full throttle.
+        /// </summary>
+        /// <param name="rpm">Engine speed, in [rpm].</param>
+        /// <returns>Torque, in [N.m].</returns>
+        static float const torque( float const & rpm );
+    };
+}
+
+#endif
@@ -0,0 +1,133 @@
+/***************************************************************************
+
+    file                 : scr_simulator.cpp
+    copyright            : (C) 2019 Miguel Ferreira and Jo�o Aniceto
+
+ ***************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Race.hpp"
+#include "Track.hpp"
+
+/// <summary>
+/// Headless SCR server stand-in, races a single car as fast as its client answers.
+/// </summary>
+/// <remarks>
+/// Arguments follow the SCR client style, port:3001 track:file laps:3 episodes:0 steps:0.
+///     - laps, race restarts after this number of laps, 0 for never;
+///     - episodes, server shuts the client down after this number of races, 0 for never;
+///     - steps, race restarts after this number of game ticks, 0 for never.
+/// </remarks>
+int main( int argc, char * argv[] )
+{
+    // SCR client message buffer size
+    constexpr size_t const UDP_MSGLEN = 1000;
+    unsigned short port = 3001;
+    std::string track_file = "";
+    size_t max_laps = 3;
+    size_t max_episodes = 0;
+    size_t max_steps = 0;
+    for ( int argument = 1; argument < argc; argument++ )
+    {
+        std::string const option = argv[ argument ];
+        size_t const colon = option.find( ':' );
+        std::string const name = option.substr( 0, colon );
+        std::string const value = colon == std::string::npos ? "" : option.substr( colon + 1 );
+        if ( name == "port" ) port = static_cast<unsigned short>( std::atoi( value.c_str() ) );
+        else if ( name == "track" ) track_file = value;
+        else if ( name == "laps" ) max_laps = static_cast<size_t>( std::atol( value.c_str() ) );
+        else if ( name == "episodes" ) max_episodes = static_cast<size_t>( std::atol( value.c_str() ) );
+        else if ( name == "steps" ) max_steps = static_cast<size_t>( std::atol( value.c_str() ) );
+        else std::cout << "Unknown argument " << option << std::endl;
+    }
+
+    Simulator::Track const track = Simulator::Track( track_file );
+    Simulator::Race race = Simulator::Race( track );
+    std::cout << "Track length " << track.getLength() << " m, width " << track.getWidth() << " m" << std::endl;
+
+    // server socket
+    int const socket_descriptor = socket( AF_INET, SOCK_DGRAM, 0 );
+    sockaddr_in server_address = {};
+    server_address.sin_family = AF_INET;
+    server_address.sin_addr.s_addr = htonl( INADDR_ANY );
+    server_address.sin_port = htons( port );
+    if ( socket_descriptor < 0 || bind( socket_descriptor, reinterpret_cast<sockaddr *>( &server_address ), sizeof( server_address ) ) < 0 )
+    {
+        std::cout << "Can't bind port " << port << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Waiting for a SCR client on port " << port << std::endl;
+
+    char buffer[ UDP_MSGLEN + 1 ];
+    sockaddr_in client_address = {};
+    socklen_t client_length = sizeof( client_address );
+    auto reply = [ & ]( std::string const & message )
+    {
+        sendto( socket_descriptor, message.c_str(), message.size(), 0, reinterpret_cast<sockaddr *>( &client_address ), client_length );
+    };
+    bool identified = false;
+    size_t episodes = 0;
+    size_t total_ticks = 0;
+    auto const start = std::chrono::steady_clock::now();
+    while ( true )
+    {
+        client_length = sizeof( client_address );
+        ssize_t const received = recvfrom( socket_descriptor, buffer, UDP_MSGLEN, 0, reinterpret_cast<sockaddr *>( &client_address ), &client_length );
+        if ( received < 0 ) continue;
+        buffer[ received ] = '\0';
+        std::string const message = buffer;
+        // identification, as "SCR(init -90 -80 ... 90)", is also accepted mid race if the client restarted
+        size_t const init = message.find( "(init" );
+        if ( init != std::string::npos )
+        {
+            std::array<float, Simulator::Race::TRACK_SENSORS> angles = {};
+            char const * position = message.c_str() + init + 5;
+            for ( float & angle : angles )
+            {
+                char * end = nullptr;
+                angle = std::strtof( position, &end );
+                position = end;
+            }
+            race.reset( angles );
+            identified = true;
+            reply( "***identified***" );
+            reply( race.sensors() );
+            continue;
+        }
+        if ( !identified ) continue;
+        // control answer
+        race.drive( message );
+        total_ticks++;
+        bool const finished = ( max_laps != 0 && race.getLaps() >= max_laps ) || ( max_steps != 0 && race.getTicks() >= max_steps );
+        if ( !race.restartRequested() && !finished )
+        {
+            reply( race.sensors() );
+            continue;
+        }
+        // race over, client identifies again after a restart
+        episodes++;
+        identified = false;
+        if ( max_episodes != 0 && episodes >= max_episodes )
+        {
+            reply( "***shutdown***" );
+            break;
+        }
+        reply( "***restart***" );
+    }
+    close( socket_descriptor );
+
+    // speed report
+    float const wall_time = std::chrono::duration<float>( std::chrono::steady_clock::now() - start ).count();
+    float const race_time = static_cast<float>( total_ticks ) * Simulator::Race::TICK;
+    std::cout << "Raced " << episodes << " episodes, " << total_ticks << " ticks, " << race_time << " s in " << wall_time << " s ( " << race_time / wall_time << "x real-time )" << std::endl;
+    return EXIT_SUCCESS;
+}